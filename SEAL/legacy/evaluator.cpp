@@ -1153,8 +1153,31 @@ namespace seal
             return;
         }
 
-        vector<Ciphertext> exp_vector(exponent, encrypted);
-        destination = multiply_many(exp_vector);
+        // Square repeatedly to find encrypted^(2^i) for every bit i set in exponent, and multiply
+        // the powers into the result in order of increasing i. Each product then has depth one
+        // more than its newest power, so the result has depth ceil(log2(exponent)), using
+        // floor(log2(exponent)) squarings and one fewer multiplications than there are bits set.
+        Ciphertext power(encrypted);
+        Ciphertext result(encrypted);
+        bool result_set = (exponent & 1) != 0;
+        for (exponent >>= 1; exponent > 0; exponent >>= 1)
+        {
+            power = relinearize(square(power));
+            if (!(exponent & 1))
+            {
+                continue;
+            }
+            if (result_set)
+            {
+                result = relinearize(multiply(result, power));
+            }
+            else
+            {
+                result = power;
+                result_set = true;
+            }
+        }
+        destination = result;
     }
 
     void Evaluator::transform_to_ntt(Plaintext &plain)
@@ -318,7 +318,12 @@ namespace seal
 
         // There is no known closed formula for the growth factor, but we use the asymptotic approximation
         // k^n * sqrt[6/((k-1)*(k+1)*Pi*n)], where k = max_coeff_count_, n = exponent.
-        uint64_t growth_factor = static_cast<uint64_t>(pow(operand.max_coeff_count_, exponent) * sqrt(6 / ((operand.max_coeff_count_ - 1) * (operand.max_coeff_count_ + 1) * 3.1415 * exponent)));
+        // Constant polynomials do not grow other than through their value.
+        uint64_t growth_factor = 1;
+        if (operand.max_coeff_count_ > 1)
+        {
+            growth_factor = static_cast<uint64_t>(pow(operand.max_coeff_count_, exponent) * sqrt(6 / ((operand.max_coeff_count_ - 1) * (operand.max_coeff_count_ + 1) * 3.1415 * exponent)));
+        }
 
         int result_bit_count = exponent * get_significant_bit_count(operand.max_abs_value_) + get_significant_bit_count(growth_factor) + 1 + get_significant_bit_count(growth_factor);
         if (result_bit_count > bits_per_uint64)
@@ -13,8 +13,9 @@ namespace seal
             return *this;
         }
 
-        // First copy over hash block
+        // First copy over hash block and form
         hash_block_ = assign.hash_block_;
+        is_ntt_form_ = assign.is_ntt_form_;
 
         // Then resize
         resize(assign.size_, assign.poly_coeff_count_, assign.coeff_mod_count_);
@@ -109,6 +110,8 @@ namespace seal
         stream.write(reinterpret_cast<const char*>(&poly_coeff_count32), sizeof(int32_t));
         int32_t coeff_mod_count32 = static_cast<int32_t>(coeff_mod_count_);
         stream.write(reinterpret_cast<const char*>(&coeff_mod_count32), sizeof(int32_t));
+        int32_t is_ntt_form32 = static_cast<int32_t>(is_ntt_form_);
+        stream.write(reinterpret_cast<const char*>(&is_ntt_form32), sizeof(int32_t));
         stream.write(reinterpret_cast<const char*>(ciphertext_array_.get()), size_ * poly_coeff_count_ * coeff_mod_count_ * bytes_per_uint64);
     }
 
@@ -121,6 +124,9 @@ namespace seal
         stream.read(reinterpret_cast<char*>(&read_poly_coeff_count32), sizeof(int32_t));
         int32_t read_coeff_mod_count32 = 0;
         stream.read(reinterpret_cast<char*>(&read_coeff_mod_count32), sizeof(int32_t));
+        int32_t read_is_ntt_form32 = 0;
+        stream.read(reinterpret_cast<char*>(&read_is_ntt_form32), sizeof(int32_t));
+        is_ntt_form_ = (read_is_ntt_form32 != 0);
 
         // Resize
         resize(read_size32, read_poly_coeff_count32, read_coeff_mod_count32);
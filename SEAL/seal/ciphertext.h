@@ -148,6 +148,7 @@ namespace seal
             size_(copy.size_),
             poly_coeff_count_(copy.poly_coeff_count_),
             coeff_mod_count_(copy.coeff_mod_count_),
+            is_ntt_form_(copy.is_ntt_form_),
 
             // pool_ is guaranteed to be good at this point so allocate memory
             ciphertext_array_(util::allocate_uint(size_capacity_ * poly_coeff_count_ * coeff_mod_count_, pool_))
@@ -477,6 +478,18 @@ namespace seal
             return size_ * poly_coeff_count_ * coeff_mod_count_;
         }
 
+        /**
+        Returns whether the ciphertext is in NTT form, i.e. whether each of its polynomials
+        has been transformed to the NTT domain with respect to each prime in the coefficient
+        modulus. Ciphertexts are produced by Encryptor in coefficient form, and can be moved
+        between the two forms with Evaluator::transform_to_ntt and 
+        Evaluator::transform_from_ntt.
+        */
+        inline bool is_ntt_form() const
+        {
+            return is_ntt_form_;
+        }
+
         /**
         Saves the ciphertext to an output stream. The output is in binary format and not 
         human-readable. The output stream must have the "binary" flag set.
@@ -626,6 +639,8 @@ namespace seal
 
         int coeff_mod_count_ = 0;
 
+        bool is_ntt_form_ = false;
+
         util::Pointer ciphertext_array_;
 
         friend class Decryptor;
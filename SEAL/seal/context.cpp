@@ -4,15 +4,69 @@
 #include "seal/util/modulus.h"
 #include "seal/util/polymodulus.h"
 #include "seal/util/numth.h"
+#include "seal/util/mappedfile.h"
 #include "seal/defaultparams.h"
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 using namespace seal::util;
 
 namespace seal
 {
-    EncryptionParameterQualifiers SEALContext::validate()
+    namespace
+    {
+        // "SEALPREC" in ASCII; also detects a mismatch in byte order
+        const uint64_t precomputation_magic = 0x5345414C50524543;
+
+        const uint64_t precomputation_version = 1;
+
+        // Owns pre-computations loaded from a memory-mapped file; the mapping is declared
+        // first so that it is released only after the tables aliasing it are destroyed
+        struct MappedPrecomputation
+        {
+            MappedPrecomputation(const string &path, const MemoryPoolHandle &pool) :
+                mapping(path), plain_ntt_tables(pool), base_converter(pool)
+            {
+            }
+
+            MappedFile mapping;
+
+            vector<SmallNTTTables> small_ntt_tables;
+
+            SmallNTTTables plain_ntt_tables;
+
+            BaseConverter base_converter;
+        };
+
+        // Owns the pre-computations of a level of the modulus switching chain. The NTT tables
+        // alias those of the level above, which are kept alive by holding its pre-computations.
+        struct DerivedPrecomputation
+        {
+            DerivedPrecomputation(const ContextCache::Precomputation &parent, 
+                const EncryptionParameters &parms, const MemoryPoolHandle &pool) : 
+                parent(parent), 
+                base_converter(parms.coeff_modulus(), parms.poly_modulus().coeff_count(),
+                    parent.small_ntt_tables->front().coeff_count_power(), parms.plain_modulus(), 
+                    *parent.base_converter, pool)
+            {
+                int coeff_mod_count = parms.coeff_modulus().size();
+                small_ntt_tables.resize(coeff_mod_count, SmallNTTTables(pool));
+                for (int i = 0; i < coeff_mod_count; i++)
+                {
+                    small_ntt_tables[i].alias((*parent.small_ntt_tables)[i]);
+                }
+            }
+
+            ContextCache::Precomputation parent;
+
+            vector<SmallNTTTables> small_ntt_tables;
+
+            BaseConverter base_converter;
+        };
+    }
+
+    EncryptionParameterQualifiers SEALContext::validate(const ContextCache::Precomputation *precomputation)
     {
         qualifiers_ = EncryptionParameterQualifiers();
         int coeff_mod_count = parms_.coeff_modulus().size();
@@ -118,33 +172,60 @@ namespace seal
 
         int coeff_count_power = poly_mod.coeff_count_power_of_two();
 
-        // Can we use NTT with coeff_modulus?
-        qualifiers_.enable_ntt = true;
-        for (int i = 0; i < coeff_mod_count; i++)
+        // Use the given pre-computations, or reuse the ones for these parameters if they 
+        // are in the cache
+        ContextCache::Precomputation found_precomputation;
+        if (precomputation != nullptr)
         {
-            if (!small_ntt_tables_[i].generate(coeff_count_power, parms_.coeff_modulus()[i]))
+            found_precomputation = *precomputation;
+        }
+        else if (!ContextCache::find(parms_.hash_block(), found_precomputation))
+        {
+            // Cached pre-computations are allocated from the pool of the cache
+            MemoryPoolHandle table_pool = ContextCache::pool();
+            if (!table_pool)
+            {
+                table_pool = pool_;
+            }
+
+            // Can we use NTT with coeff_modulus?
+            vector<SmallNTTTables> small_ntt_tables(coeff_mod_count, SmallNTTTables(table_pool));
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                if (!small_ntt_tables[i].generate(coeff_count_power, parms_.coeff_modulus()[i]))
+                {
+                    // Parameters are not valid
+                    qualifiers_.enable_ntt = false;
+                    qualifiers_.parameters_set = false;
+                    return qualifiers_;
+                }
+            }
+            found_precomputation.small_ntt_tables = make_shared<const vector<SmallNTTTables>>(move(small_ntt_tables));
+
+            // Can we use batching? (NTT with plain_modulus)
+            auto plain_ntt_tables = make_shared<SmallNTTTables>(table_pool);
+            plain_ntt_tables->generate(coeff_count_power, parms_.plain_modulus());
+            found_precomputation.plain_ntt_tables = plain_ntt_tables;
+
+            auto base_converter = make_shared<const BaseConverter>(parms_.coeff_modulus(), coeff_count, 
+                coeff_count_power, parms_.plain_modulus(), table_pool);
+            if (!base_converter->is_generated())
             {
                 // Parameters are not valid
-                qualifiers_.enable_ntt = false;
+                qualifiers_.enable_ntt = true;
+                qualifiers_.enable_batching = plain_ntt_tables->is_generated();
                 qualifiers_.parameters_set = false;
                 return qualifiers_;
             }
-        }
+            found_precomputation.base_converter = base_converter;
 
-        // Can we use batching? (NTT with plain_modulus)
-        qualifiers_.enable_batching = false;
-        if (plain_ntt_tables_.generate(coeff_count_power, parms_.plain_modulus()))
-        {
-            qualifiers_.enable_batching = true;
-        }
-
-        base_converter_ = BaseConverter(parms_.coeff_modulus(), coeff_count, coeff_count_power, parms_.plain_modulus(), pool_);
-        if (!base_converter_.is_generated())
-        {
-            // Parameters are not valid
-            qualifiers_.parameters_set = false;
-            return qualifiers_;
+            ContextCache::insert(parms_.hash_block(), found_precomputation);
         }
+        small_ntt_tables_ = found_precomputation.small_ntt_tables;
+        plain_ntt_tables_ = found_precomputation.plain_ntt_tables;
+        base_converter_ = found_precomputation.base_converter;
+        qualifiers_.enable_ntt = true;
+        qualifiers_.enable_batching = plain_ntt_tables_->is_generated();
 
         // Check for plain_lift 
         // If all the small coefficient moduli are larger than plain modulus, we can quickly lift plain coefficients to RNS form
@@ -157,21 +238,23 @@ namespace seal
             }
         }
 
+        if (!galois_tables_)
+        {
+            galois_tables_ = make_shared<const GaloisTables>(coeff_count_power);
+        }
+
         // Done with validation and pre-computations
         return qualifiers_;
     }
 
     SEALContext::SEALContext(const EncryptionParameters &parms, const MemoryPoolHandle &pool) :
-        pool_(pool), parms_(parms), base_converter_(pool_), plain_ntt_tables_(pool_) 
+        pool_(pool), parms_(parms) 
     {
         if (!pool)
         {
             throw invalid_argument("pool is uninitialized");
         }
 
-        int coeff_mod_count = parms_.coeff_modulus().size();
-        small_ntt_tables_.resize(coeff_mod_count, pool_);
-
         // Set random generator
         if (parms_.random_generator() == nullptr)
         {
@@ -179,5 +262,170 @@ namespace seal
         }
 
         qualifiers_ = validate();
+        next_context_ = make_shared<NextContext>();
+    }
+
+    SEALContext::SEALContext(const EncryptionParameters &parms, const MemoryPoolHandle &pool, 
+        const ContextCache::Precomputation &precomputation, const shared_ptr<const GaloisTables> &galois_tables) : 
+        pool_(pool), parms_(parms), galois_tables_(galois_tables)
+    {
+        // Set random generator
+        if (parms_.random_generator() == nullptr)
+        {
+            parms_.set_random_generator(UniformRandomGeneratorFactory::default_factory());
+        }
+
+        qualifiers_ = validate(&precomputation);
+        next_context_ = make_shared<NextContext>();
+    }
+
+    shared_ptr<const SEALContext> SEALContext::next_context() const
+    {
+        if (!next_context_)
+        {
+            return nullptr;
+        }
+
+        // The next context never changes once it has been created, so it can be returned 
+        // after the lock is released
+        ReaderLock reader_lock(next_context_->locker.acquire_read());
+        if (next_context_->created)
+        {
+            return next_context_->context;
+        }
+        reader_lock.release();
+
+        auto next_context = create_next_context();
+        WriterLock writer_lock(next_context_->locker.acquire_write());
+        if (!next_context_->created)
+        {
+            next_context_->context = next_context;
+            next_context_->created = true;
+        }
+        return next_context_->context;
+    }
+
+    shared_ptr<const SEALContext> SEALContext::create_next_context() const
+    {
+        int coeff_mod_count = parms_.coeff_modulus().size();
+        if (!qualifiers_.parameters_set || coeff_mod_count < 2)
+        {
+            return nullptr;
+        }
+
+        // The next level drops the last prime. The NTT tables of its primes and of its Bsk 
+        // base are among those of this level, so it only computes the constants of its base
+        // converter, and it bypasses the ContextCache.
+        EncryptionParameters next_parms(parms_);
+        next_parms.set_coeff_modulus(vector<SmallModulus>(parms_.coeff_modulus().begin(), 
+            parms_.coeff_modulus().end() - 1));
+        ContextCache::Precomputation parent;
+        parent.small_ntt_tables = small_ntt_tables_;
+        parent.plain_ntt_tables = plain_ntt_tables_;
+        parent.base_converter = base_converter_;
+        auto derived = make_shared<DerivedPrecomputation>(parent, next_parms, pool_);
+        if (!derived->base_converter.is_generated())
+        {
+            return nullptr;
+        }
+
+        ContextCache::Precomputation precomputation;
+        precomputation.small_ntt_tables = shared_ptr<const vector<SmallNTTTables>>(derived, &derived->small_ntt_tables);
+        precomputation.plain_ntt_tables = plain_ntt_tables_;
+        precomputation.base_converter = shared_ptr<const BaseConverter>(derived, &derived->base_converter);
+        // The Galois tables only depend on the degree of the polynomial modulus
+        shared_ptr<const SEALContext> next_context(new SEALContext(next_parms, pool_, precomputation, galois_tables_));
+        if (!next_context->qualifiers_.parameters_set)
+        {
+            return nullptr;
+        }
+        return next_context;
+    }
+
+    void SEALContext::save_precomputation(ostream &stream) const
+    {
+        if (!qualifiers_.parameters_set)
+        {
+            throw logic_error("encryption parameters are not set correctly");
+        }
+
+        uint64_t header[3]{ precomputation_magic, precomputation_version, 
+            static_cast<uint64_t>(small_ntt_tables_->size()) };
+        write_words(stream, header, 3);
+        write_words(stream, parms_.hash_block().data(), HashFunction::sha3_block_uint64_count);
+        for (const auto &table : *small_ntt_tables_)
+        {
+            table.save(stream);
+        }
+        plain_ntt_tables_->save(stream);
+        base_converter_->save(stream);
+    }
+
+    SEALContext SEALContext::load_precomputation(const EncryptionParameters &parms, 
+        const string &path, const MemoryPoolHandle &pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Pre-computations added to the cache use the pool of the cache for any copies
+        MemoryPoolHandle table_pool = ContextCache::pool();
+        if (!table_pool)
+        {
+            table_pool = pool;
+        }
+        auto mapped = make_shared<MappedPrecomputation>(path, table_pool);
+        const uint64_t *data = mapped->mapping.data();
+        const uint64_t *data_end = data + mapped->mapping.uint64_count();
+
+        const uint64_t *header = read_words(data, data_end, 3);
+        if (header[0] != precomputation_magic || header[1] != precomputation_version)
+        {
+            throw invalid_argument("file does not contain pre-computations");
+        }
+        const uint64_t *hash_block = read_words(data, data_end, HashFunction::sha3_block_uint64_count);
+        if (!equal(hash_block, hash_block + HashFunction::sha3_block_uint64_count, parms.hash_block().begin()) ||
+            header[2] != parms.coeff_modulus().size())
+        {
+            throw invalid_argument("pre-computations do not match encryption parameters");
+        }
+
+        int coeff_mod_count = parms.coeff_modulus().size();
+        int coeff_count = parms.poly_modulus().coeff_count();
+        mapped->small_ntt_tables.resize(coeff_mod_count, SmallNTTTables(table_pool));
+        for (int i = 0; i < coeff_mod_count; i++)
+        {
+            SmallNTTTables &table = mapped->small_ntt_tables[i];
+            table.load_aliasing(data, data_end);
+            if (!table.is_generated() || table.coeff_count() + 1 != coeff_count ||
+                table.modulus().value() != parms.coeff_modulus()[i].value())
+            {
+                throw invalid_argument("pre-computations do not match encryption parameters");
+            }
+        }
+        mapped->plain_ntt_tables.load_aliasing(data, data_end);
+        if (mapped->plain_ntt_tables.is_generated() && 
+            (mapped->plain_ntt_tables.coeff_count() + 1 != coeff_count ||
+            mapped->plain_ntt_tables.modulus().value() != parms.plain_modulus().value()))
+        {
+            throw invalid_argument("pre-computations do not match encryption parameters");
+        }
+        mapped->base_converter.load_aliasing(data, data_end);
+        if (!mapped->base_converter.is_generated() ||
+            mapped->base_converter.coeff_base_mod_count() != coeff_mod_count ||
+            mapped->base_converter.get_bsk_small_ntt_table()[0].coeff_count() + 1 != coeff_count)
+        {
+            throw invalid_argument("pre-computations do not match encryption parameters");
+        }
+
+        // Each table keeps the whole mapping alive
+        ContextCache::Precomputation precomputation;
+        precomputation.small_ntt_tables = shared_ptr<const vector<SmallNTTTables>>(mapped, &mapped->small_ntt_tables);
+        precomputation.plain_ntt_tables = shared_ptr<const SmallNTTTables>(mapped, &mapped->plain_ntt_tables);
+        precomputation.base_converter = shared_ptr<const BaseConverter>(mapped, &mapped->base_converter);
+        ContextCache::insert(parms.hash_block(), precomputation);
+
+        return SEALContext(parms, pool, precomputation);
     }
 }
@@ -4,6 +4,8 @@
 #include <utility>
 #include <string>
 #include <array>
+#include <memory>
+#include <vector>
 #include "seal/encryptionparams.h"
 #include "seal/biguint.h"
 #include "seal/bigpoly.h"
@@ -11,6 +13,9 @@
 #include "seal/memorypoolhandle.h"
 #include "seal/util/smallntt.h"
 #include "seal/util/baseconverter.h"
+#include "seal/util/galoistables.h"
+#include "seal/util/locks.h"
+#include "seal/contextcache.h"
 
 namespace seal
 {
@@ -118,9 +123,11 @@ namespace seal
     public:
         /**
         Creates an instance of SEALContext, and performs several pre-computations on the 
-        given EncryptionParameters. The results of the pre-computations are stored in 
-        allocations from the memory pool pointed to by the optionally given 
-        MemoryPoolHandle. By default the global memory pool is used.
+        given EncryptionParameters. If pre-computations for the same encryption parameters
+        are found in the process-wide ContextCache they are reused; otherwise they are 
+        generated and added to the cache. The memory pool pointed to by the optionally 
+        given MemoryPoolHandle is used for the pre-computations only when caching is 
+        disabled. By default the global memory pool is used.
 
         @param[in] parms The encryption parameters
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
@@ -130,14 +137,16 @@ namespace seal
             const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
 
         /**
-        Creates a new SEALContext instance by creating a deep copy of a given instance.
+        Creates a new SEALContext instance by creating a copy of a given instance. The 
+        read-only pre-computations are shared between the two instances.
 
         @param[in] copy The SEALContext to copy from
         */
         SEALContext(const SEALContext &copy) = default;
 
         /**
-        Overwrites the current SEALContext instance by a deep copy of a given instance.
+        Overwrites the current SEALContext instance by a copy of a given instance. The
+        read-only pre-computations are shared between the two instances.
 
         @param[in] assign The SEALContext instance to overwrite the current instance
         */
@@ -240,8 +249,69 @@ namespace seal
             return parms_.random_generator();
         }
 
+        /**
+        Returns a pointer to the SEALContext for the encryption parameters obtained from the
+        current ones by removing the last prime from the coefficient modulus, or nullptr if
+        the coefficient modulus consists of a single prime or the smaller parameters are not
+        valid. The contexts form a chain from the full coefficient modulus down to a single
+        prime, which gives the levels that ciphertexts pass through in modulus switching. 
+        Each level is created the first time it is requested, and is then shared by the 
+        copies of the context. A level does not generate NTT tables of its own: it uses the 
+        tables of the level above for the primes the two have in common.
+
+        @see Evaluator::mod_switch_to_next for more information about modulus switching.
+        */
+        std::shared_ptr<const SEALContext> next_context() const;
+
+        /**
+        Saves the pre-computations of the SEALContext to an output stream. These are the 
+        NTT tables for the coefficient and plaintext moduli, and the tables of the RNS 
+        base converter, including the NTT tables for the auxiliary base Bsk. The output 
+        is in binary format and not human-readable, and the stream should be opened in 
+        binary mode. Saving to a file allows other processes to skip the pre-computations 
+        using load_precomputation().
+
+        @param[out] stream The stream to save the pre-computations to
+        @throws std::logic_error if the encryption parameters are not valid
+        @see load_precomputation() to create a SEALContext from saved pre-computations.
+        */
+        void save_precomputation(std::ostream &stream) const;
+
+        /**
+        Creates an instance of SEALContext using pre-computations saved to a file by 
+        save_precomputation(), instead of re-computing them. The file is memory-mapped 
+        read-only and the NTT tables are used in place, so loading takes time independent 
+        of the size of the tables, and processes loading the same file share its memory 
+        pages. The file must not be modified while any SEALContext, or any tool created 
+        from it, is using the tables. The loaded pre-computations are also added to the 
+        ContextCache, so that subsequent SEALContext instances for the same encryption 
+        parameters share them. The levels of the modulus switching chain use the mapped
+        tables as well.
+
+        @param[in] parms The encryption parameters the pre-computations were saved for
+        @param[in] path The path of the file containing the pre-computations
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized, if the file does not 
+        contain valid pre-computations, or if they were saved for different encryption 
+        parameters
+        @throws std::runtime_error if the file could not be opened or mapped
+        @see save_precomputation() to save the pre-computations of a SEALContext.
+        */
+        static SEALContext load_precomputation(const EncryptionParameters &parms, 
+            const std::string &path, const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
+
     private:
-        EncryptionParameterQualifiers validate();
+        // Uses the given Galois tables if galois_tables is not null
+        SEALContext(const EncryptionParameters &parms, const MemoryPoolHandle &pool, 
+            const ContextCache::Precomputation &precomputation,
+            const std::shared_ptr<const util::GaloisTables> &galois_tables = nullptr);
+
+        // Uses the given pre-computations if precomputation is not null
+        EncryptionParameterQualifiers validate(const ContextCache::Precomputation *precomputation = nullptr);
+
+        // Creates the context for the next level of the modulus switching chain from the 
+        // pre-computations of this level, or returns nullptr if there is no next level
+        std::shared_ptr<const SEALContext> create_next_context() const;
 
         MemoryPoolHandle pool_;
 
@@ -249,20 +319,40 @@ namespace seal
 
         EncryptionParameterQualifiers qualifiers_;
 
-        util::BaseConverter base_converter_;
+        // The pre-computed tables below are immutable once validate() has finished, 
+        // and are shared by the context copies and by every tool constructed from them.
+        std::shared_ptr<const util::BaseConverter> base_converter_;
+
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> small_ntt_tables_;
 
-        std::vector<util::SmallNTTTables> small_ntt_tables_;
+        std::shared_ptr<const util::SmallNTTTables> plain_ntt_tables_;
 
-        util::SmallNTTTables plain_ntt_tables_;
+        // The Galois tables are filled lazily and thread-safely as Galois elements are used
+        std::shared_ptr<const util::GaloisTables> galois_tables_;
 
         BigUInt total_coeff_modulus_;
 
+        // The next level of the modulus switching chain, once created; shared by the copies 
+        // of the context
+        struct NextContext
+        {
+            std::shared_ptr<const SEALContext> context;
+
+            bool created = false;
+
+            util::ReaderWriterLocker locker;
+        };
+
+        std::shared_ptr<NextContext> next_context_;
+
         friend class Decryptor;
 
         friend class Encryptor;
 
         friend class Evaluator;
 
+        friend class EvaluatorWorkspace;
+
         friend class PolyCRTBuilder;
 
         friend class KeyGenerator;
@@ -0,0 +1,166 @@
+#include <map>
+#include <atomic>
+#include <stdexcept>
+#include "seal/contextcache.h"
+#include "seal/util/locks.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        struct CacheEntry
+        {
+            ContextCache::Precomputation precomputation;
+
+            // Updated under a reader lock on every hit; used to find the least recently used entry
+            atomic<uint64_t> last_used{ 0 };
+        };
+
+        struct CacheState
+        {
+            ReaderWriterLocker locker;
+
+            map<HashFunction::sha3_block_type, unique_ptr<CacheEntry>> entries;
+
+            int capacity = ContextCache::default_capacity;
+
+            MemoryPoolHandle pool = MemoryPoolHandle::New(true);
+
+            atomic<uint64_t> clock{ 0 };
+
+            atomic<uint64_t> hits{ 0 };
+
+            atomic<uint64_t> misses{ 0 };
+
+            atomic<uint64_t> evictions{ 0 };
+        };
+
+        CacheState &cache_state()
+        {
+            static CacheState state;
+            return state;
+        }
+
+        // Requires a writer lock
+        void evict_to(CacheState &state, int entry_count)
+        {
+            while (static_cast<int>(state.entries.size()) > entry_count)
+            {
+                auto oldest = state.entries.begin();
+                for (auto it = state.entries.begin(); it != state.entries.end(); ++it)
+                {
+                    if (it->second->last_used < oldest->second->last_used)
+                    {
+                        oldest = it;
+                    }
+                }
+                state.entries.erase(oldest);
+                state.evictions++;
+            }
+        }
+    }
+
+    const int ContextCache::default_capacity;
+
+    int ContextCache::capacity()
+    {
+        CacheState &state = cache_state();
+        ReaderLock lock(state.locker.acquire_read());
+        return state.capacity;
+    }
+
+    void ContextCache::set_capacity(int capacity)
+    {
+        if (capacity < 0)
+        {
+            throw invalid_argument("capacity cannot be negative");
+        }
+        CacheState &state = cache_state();
+        WriterLock lock(state.locker.acquire_write());
+        state.capacity = capacity;
+        evict_to(state, capacity);
+    }
+
+    void ContextCache::clear()
+    {
+        CacheState &state = cache_state();
+        WriterLock lock(state.locker.acquire_write());
+        state.entries.clear();
+    }
+
+    ContextCacheStats ContextCache::stats()
+    {
+        CacheState &state = cache_state();
+        ReaderLock lock(state.locker.acquire_read());
+        ContextCacheStats result;
+        result.hits = state.hits;
+        result.misses = state.misses;
+        result.evictions = state.evictions;
+        result.entry_count = static_cast<int>(state.entries.size());
+        result.capacity = state.capacity;
+        return result;
+    }
+
+    void ContextCache::reset_stats()
+    {
+        CacheState &state = cache_state();
+        state.hits = 0;
+        state.misses = 0;
+        state.evictions = 0;
+    }
+
+    bool ContextCache::find(const HashFunction::sha3_block_type &hash_block, Precomputation &precomputation)
+    {
+        CacheState &state = cache_state();
+        ReaderLock lock(state.locker.acquire_read());
+        auto it = state.entries.find(hash_block);
+        if (it == state.entries.end())
+        {
+            state.misses++;
+            return false;
+        }
+        it->second->last_used = ++state.clock;
+        precomputation = it->second->precomputation;
+        state.hits++;
+        return true;
+    }
+
+    void ContextCache::insert(const HashFunction::sha3_block_type &hash_block, Precomputation &precomputation)
+    {
+        CacheState &state = cache_state();
+        WriterLock lock(state.locker.acquire_write());
+        if (state.capacity == 0)
+        {
+            return;
+        }
+
+        // Another thread may have generated the same pre-computations meanwhile
+        auto it = state.entries.find(hash_block);
+        if (it != state.entries.end())
+        {
+            it->second->last_used = ++state.clock;
+            precomputation = it->second->precomputation;
+            return;
+        }
+
+        evict_to(state, state.capacity - 1);
+        unique_ptr<CacheEntry> entry(new CacheEntry);
+        entry->precomputation = precomputation;
+        entry->last_used = ++state.clock;
+        state.entries.emplace(hash_block, move(entry));
+    }
+
+    MemoryPoolHandle ContextCache::pool()
+    {
+        CacheState &state = cache_state();
+        ReaderLock lock(state.locker.acquire_read());
+        if (state.capacity == 0)
+        {
+            return MemoryPoolHandle();
+        }
+        return state.pool;
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "seal/memorypoolhandle.h"
+#include "seal/util/hash.h"
+#include "seal/util/smallntt.h"
+#include "seal/util/baseconverter.h"
+
+namespace seal
+{
+    /**
+    Holds the counters of the process-wide pre-computation cache at the time 
+    ContextCache::stats() was called.
+
+    @see ContextCache for more details.
+    */
+    struct ContextCacheStats
+    {
+        /**
+        The number of SEALContext constructions that found their pre-computations in 
+        the cache.
+        */
+        std::uint64_t hits;
+
+        /**
+        The number of SEALContext constructions that did not find their pre-computations 
+        in the cache.
+        */
+        std::uint64_t misses;
+
+        /**
+        The number of entries that were dropped from the cache to respect its capacity.
+        */
+        std::uint64_t evictions;
+
+        /**
+        The number of entries currently in the cache.
+        */
+        int entry_count;
+
+        /**
+        The maximum number of entries the cache holds.
+        */
+        int capacity;
+    };
+
+    /**
+    A process-wide, thread-safe cache of the pre-computations (NTT tables and RNS base 
+    converter) that SEALContext needs for a set of encryption parameters. The cache is 
+    keyed by EncryptionParameters::hash_block(), so constructing SEALContext repeatedly 
+    for the same encryption parameters generates the pre-computations only once, and 
+    all such contexts (and the Evaluator, Encryptor, Decryptor, and KeyGenerator objects 
+    created from them) share the same read-only tables.
+
+    @par Eviction
+    The cache holds at most capacity() entries; when it is full the least recently used 
+    entry is dropped. Evicting an entry never invalidates a SEALContext: each context 
+    keeps its own reference to the pre-computations it uses. Setting the capacity to 
+    zero disables caching.
+
+    @par Memory Pools
+    Cached pre-computations are allocated from a thread-safe memory pool owned by the 
+    cache, rather than from the memory pool given to SEALContext, so that they can be 
+    shared by contexts using different (possibly thread-unsafe) memory pools. When 
+    caching is disabled the memory pool given to SEALContext is used.
+
+    @par Thread Safety
+    All functions in this class are thread-safe.
+    */
+    class ContextCache
+    {
+    public:
+        /**
+        The default maximum number of entries in the cache.
+        */
+        static const int default_capacity = 16;
+
+        /**
+        Returns the maximum number of entries in the cache.
+        */
+        static int capacity();
+
+        /**
+        Sets the maximum number of entries in the cache, evicting least recently used 
+        entries if necessary. A capacity of zero disables caching.
+
+        @param[in] capacity The new capacity
+        @throws std::invalid_argument if capacity is negative
+        */
+        static void set_capacity(int capacity);
+
+        /**
+        Removes all entries from the cache. Existing SEALContext objects are not affected.
+        */
+        static void clear();
+
+        /**
+        Returns a snapshot of the cache counters.
+        */
+        static ContextCacheStats stats();
+
+        /**
+        Resets the hit, miss, and eviction counters to zero.
+        */
+        static void reset_stats();
+
+        /**
+        The pre-computations stored in one cache entry.
+        */
+        struct Precomputation
+        {
+            std::shared_ptr<const util::BaseConverter> base_converter;
+
+            std::shared_ptr<const std::vector<util::SmallNTTTables>> small_ntt_tables;
+
+            std::shared_ptr<const util::SmallNTTTables> plain_ntt_tables;
+        };
+
+    private:
+        ContextCache() = delete;
+
+        // Returns true and sets precomputation if an entry for hash_block exists; 
+        // counts a hit or a miss
+        static bool find(const util::HashFunction::sha3_block_type &hash_block, Precomputation &precomputation);
+
+        // Adds an entry unless one already exists for hash_block, in which case the 
+        // existing one is returned in precomputation so that it is shared
+        static void insert(const util::HashFunction::sha3_block_type &hash_block, Precomputation &precomputation);
+
+        // The pool cached pre-computations are allocated from; an empty handle is 
+        // returned if caching is disabled
+        static MemoryPoolHandle pool();
+
+        friend class SEALContext;
+    };
+}
@@ -32,13 +32,26 @@ namespace seal
         {
             throw invalid_argument("pool is uninitialized");
         }
-        
+
+        context_ = make_shared<const SEALContext>(context);
+        initialize(context, secret_key.data().pointer());
+    }
+
+    Decryptor::Decryptor(const shared_ptr<const SEALContext> &context, const uint64_t *secret_key, 
+        const MemoryPoolHandle &pool) :
+        pool_(pool), parms_(context->parms()), qualifiers_(context->qualifiers()), 
+        base_converter_(context->base_converter_), context_(context)
+    {
+        initialize(*context, secret_key);
+    }
+
+    void Decryptor::initialize(const SEALContext &context, const uint64_t *secret_key)
+    {
         int coeff_count = parms_.poly_modulus().coeff_count();
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
-        int coeff_mod_count = base_converter_.coeff_base_mod_count();
+        int coeff_mod_count = base_converter_->coeff_base_mod_count();
 
-        // Set SmallNTTTables
-        small_ntt_tables_.resize(coeff_mod_count, pool_);
+        // Share SmallNTTTables with the context
         small_ntt_tables_ = context.small_ntt_tables_;
 
         // Populate coeff products array for compose functions (used in noise budget)
@@ -61,7 +74,7 @@ namespace seal
 
         // Allocate secret_key_ and copy over value
         secret_key_ = allocate_poly(coeff_count, coeff_mod_count, pool_);
-        set_poly_poly(secret_key.data().pointer(), coeff_count, coeff_mod_count, secret_key_.get());
+        set_poly_poly(secret_key, coeff_count, coeff_mod_count, secret_key_.get());
 
         // Set the secret_key_array to have size 1 (first power of secret) 
         secret_key_array_ = allocate_poly(coeff_count, coeff_mod_count, pool_);
@@ -81,11 +94,12 @@ namespace seal
         pool_(copy.pool_), parms_(copy.parms_), qualifiers_(copy.qualifiers_),
         base_converter_(copy.base_converter_), 
         small_ntt_tables_(copy.small_ntt_tables_),
-        secret_key_array_size_(copy.secret_key_array_size_)
+        secret_key_array_size_(copy.secret_key_array_size_),
+        context_(copy.context_)
     {
         int coeff_count = parms_.poly_modulus().coeff_count();
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
-        int coeff_mod_count = base_converter_.coeff_base_mod_count();
+        int coeff_mod_count = base_converter_->coeff_base_mod_count();
 
         // Populate coeff products array for compose functions (used in noise budget)
         coeff_products_array_ = allocate_uint(coeff_mod_count * coeff_mod_count, pool_);
@@ -106,18 +120,59 @@ namespace seal
         // Initialize moduli.
         mod_ = Modulus(product_modulus_.get(), coeff_mod_count);
         polymod_ = PolyModulus(parms_.poly_modulus().pointer(), coeff_count, poly_coeff_uint64_count);
+
+        // The levels of the modulus switching chain that copy has created are copied too
+        ReaderLock reader_lock(copy.next_decryptor_locker_.acquire_read());
+        if (copy.next_decryptor_)
+        {
+            next_decryptor_.reset(new Decryptor(*copy.next_decryptor_));
+        }
+    }
+
+    Decryptor *Decryptor::next_decryptor()
+    {
+        // The next Decryptor never changes once it has been created, so it can be used after 
+        // the lock is released
+        ReaderLock reader_lock(next_decryptor_locker_.acquire_read());
+        if (next_decryptor_)
+        {
+            return next_decryptor_.get();
+        }
+        reader_lock.release();
+
+        // The secret key at the next level of the modulus switching chain consists of the 
+        // first limbs of the current one
+        auto next_context = context_->next_context();
+        if (!next_context)
+        {
+            return nullptr;
+        }
+        WriterLock writer_lock(next_decryptor_locker_.acquire_write());
+        if (!next_decryptor_)
+        {
+            next_decryptor_.reset(new Decryptor(next_context, secret_key_.get(), pool_));
+        }
+        return next_decryptor_.get();
     }
 
     void Decryptor::decrypt(const Ciphertext &encrypted, Plaintext &destination, const MemoryPoolHandle &pool)
     {
         int coeff_count = parms_.poly_modulus().coeff_count();
-        int coeff_mod_count = base_converter_.coeff_base_mod_count();
+        int coeff_mod_count = base_converter_->coeff_base_mod_count();
         int array_poly_uint64_count = coeff_count * coeff_mod_count;
         int encrypted_size = encrypted.size();
         
         // The number of uint64 count for plain_modulus and gamma together
         int plain_gamma_uint64_count = 2;
 
+        // Ciphertexts at lower levels of the modulus switching chain are decrypted by the 
+        // Decryptor of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_decryptor())
+        {
+            next_decryptor()->decrypt(encrypted, destination, pool);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
@@ -146,34 +201,48 @@ namespace seal
 
         // put < (c_1 , c_2, ... , c_{count-1}) , (s,s^2,...,s^{count-1}) > mod q in destination
 
+        // Make a copy of c_1, ..., c_{count-1} for NTT
+        Pointer encrypted_copy(allocate_poly((encrypted_size - 1) * coeff_count, coeff_mod_count, pool));
+        set_poly_poly(encrypted.pointer(1), (encrypted_size - 1) * coeff_count, coeff_mod_count, encrypted_copy.get());
+
         // Now do the dot product of encrypted_copy and the secret key array using NTT. The secret key powers are already NTT transformed.
-        Pointer copy_operand1(allocate_uint(coeff_count, pool));
+        // Lazy reduction; ciphertexts in NTT form need no transform
+        if (!encrypted.is_ntt_form_)
+        {
+            ntt_negacyclic_harvey_lazy(encrypted_copy.get(), coeff_count, coeff_mod_count, small_ntt_tables_->data(), encrypted_size - 1);
+        }
+
         for (int i = 0; i < coeff_mod_count; i++)
         {
             // Initialize pointers for multiplication
-            const uint64_t *current_array1 = encrypted.pointer(1) + (i * coeff_count);
+            uint64_t *current_array1 = encrypted_copy.get() + (i * coeff_count);
             const uint64_t *current_array2 = secret_key_array_.get() + (i * coeff_count);
 
             for (int j = 0; j < encrypted_size - 1; j++)
             {
                 // Perform the dyadic product. 
-                set_uint_uint(current_array1, coeff_count, copy_operand1.get());
-
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables_[i]);
-
-                dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count, small_ntt_tables_[i].modulus(), copy_operand1.get());
-                add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count), copy_operand1.get(), coeff_count, small_ntt_tables_[i].modulus(), 
+                dyadic_product_coeffmod(current_array1, current_array2, coeff_count, (*small_ntt_tables_)[i].modulus(), current_array1);
+                add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count), current_array1, coeff_count, (*small_ntt_tables_)[i].modulus(),
                     tmp_dest_modq.get() + (i * coeff_count));
 
                 current_array1 += array_poly_uint64_count;
                 current_array2 += array_poly_uint64_count;
             }
+        }
 
-            // Perform inverse NTT
-            inverse_ntt_negacyclic_harvey(tmp_dest_modq.get() + (i * coeff_count), small_ntt_tables_[i]);
+        // For ciphertexts in NTT form also c_0 must be added before the inverse NTT
+        if (encrypted.is_ntt_form_)
+        {
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count), encrypted.pointer() + (i * coeff_count), 
+                    coeff_count, parms_.coeff_modulus()[i], tmp_dest_modq.get() + (i * coeff_count));
+            }
         }
 
+        // Perform inverse NTT
+        inverse_ntt_negacyclic_harvey(tmp_dest_modq.get(), coeff_count, coeff_mod_count, small_ntt_tables_->data());
+
         // add c_0 into destination
         for (int i = 0; i < coeff_mod_count; i++)
         {
@@ -181,31 +250,34 @@ namespace seal
             //    coeff_count, coeff_modulus_[i], tmp_dest_modq.get() + (i * coeff_count));
 
             // Lazy reduction
-            for (int j = 0; j < coeff_count; j++)
+            if (!encrypted.is_ntt_form_)
             {
-                tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                for (int j = 0; j < coeff_count; j++)
+                {
+                    tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                }
             }
 
             // Compute |gamma * plain|qi * ct(s)
             multiply_poly_scalar_coeffmod(tmp_dest_modq.get() + (i * coeff_count), coeff_count, 
-                base_converter_.get_plain_gamma_product()[i], parms_.coeff_modulus()[i], tmp_dest_modq.get() + (i * coeff_count));
+                base_converter_->get_plain_gamma_product()[i], parms_.coeff_modulus()[i], tmp_dest_modq.get() + (i * coeff_count));
         }
         
         // Make another temp destination to get the poly in mod {gamma U plain_modulus}
         Pointer tmp_dest_plain_gamma(allocate_poly(coeff_count, plain_gamma_uint64_count, pool));
 
         // Compute FastBConvert from q to {gamma, plain_modulus}
-        base_converter_.fastbconv_plain_gamma(tmp_dest_modq.get(), tmp_dest_plain_gamma.get(), pool);
+        base_converter_->fastbconv_plain_gamma(tmp_dest_modq.get(), tmp_dest_plain_gamma.get(), pool);
         
         // Compute result multiply by coeff_modulus inverse in mod {gamma U plain_modulus}
         for (int i = 0; i < plain_gamma_uint64_count; i++)
         {
             multiply_poly_scalar_coeffmod(tmp_dest_plain_gamma.get() + (i * coeff_count), coeff_count, 
-                base_converter_.get_neg_inv_coeff()[i], base_converter_.get_plain_gamma_array()[i], tmp_dest_plain_gamma.get() + (i * coeff_count));
+                base_converter_->get_neg_inv_coeff()[i], base_converter_->get_plain_gamma_array()[i], tmp_dest_plain_gamma.get() + (i * coeff_count));
         }
 
         // First correct the values which are larger than floor(gamma/2)
-        uint64_t gamma_div_2 = base_converter_.get_plain_gamma_array()[1].value() >> 1;
+        uint64_t gamma_div_2 = base_converter_->get_plain_gamma_array()[1].value() >> 1;
 
         // Now compute the subtraction to remove error and perform final multiplication by gamma inverse mod plain_modulus
         for (int i = 0; i < coeff_count; i++)
@@ -214,17 +286,17 @@ namespace seal
             if (tmp_dest_plain_gamma[i + coeff_count] > gamma_div_2)
             {
                 // Compute -(gamma - a) instead of (a - gamma)
-                tmp_dest_plain_gamma[i + coeff_count] = base_converter_.get_plain_gamma_array()[1].value() - tmp_dest_plain_gamma[i + coeff_count];
-                tmp_dest_plain_gamma[i + coeff_count] %= base_converter_.get_plain_gamma_array()[0].value();
+                tmp_dest_plain_gamma[i + coeff_count] = base_converter_->get_plain_gamma_array()[1].value() - tmp_dest_plain_gamma[i + coeff_count];
+                tmp_dest_plain_gamma[i + coeff_count] %= base_converter_->get_plain_gamma_array()[0].value();
                 wide_destination[i] = add_uint_uint_mod(tmp_dest_plain_gamma[i], tmp_dest_plain_gamma[i + coeff_count], 
-                    base_converter_.get_plain_gamma_array()[0]);
+                    base_converter_->get_plain_gamma_array()[0]);
             }
             // No correction needed
             else
             {
-                tmp_dest_plain_gamma[i + coeff_count] %= base_converter_.get_plain_gamma_array()[0].value();
+                tmp_dest_plain_gamma[i + coeff_count] %= base_converter_->get_plain_gamma_array()[0].value();
                 wide_destination[i] = sub_uint_uint_mod(tmp_dest_plain_gamma[i], tmp_dest_plain_gamma[i + coeff_count], 
-                    base_converter_.get_plain_gamma_array()[0]);
+                    base_converter_->get_plain_gamma_array()[0]);
             }
         }
 
@@ -235,8 +307,8 @@ namespace seal
         destination.resize(plain_coeff_count);
 
         // Perform final multiplication by gamma inverse mod plain_modulus
-        multiply_poly_scalar_coeffmod(wide_destination.get(), plain_coeff_count, base_converter_.get_inv_gamma(), 
-            base_converter_.get_plain_gamma_array()[0], destination.pointer());
+        multiply_poly_scalar_coeffmod(wide_destination.get(), plain_coeff_count, base_converter_->get_inv_gamma(), 
+            base_converter_->get_plain_gamma_array()[0], destination.pointer());
     }
 
     void Decryptor::compute_secret_key_array(int max_power)
@@ -335,7 +407,7 @@ namespace seal
         {
             for (int j = 0; j < coeff_mod_count; j++)
             {
-                uint64_t tmp = multiply_uint_uint_mod(coefficients_ptr[j], base_converter_.get_inv_coeff_mod_coeff_array()[j], parms_.coeff_modulus()[j]);
+                uint64_t tmp = multiply_uint_uint_mod(coefficients_ptr[j], base_converter_->get_inv_coeff_mod_coeff_array()[j], parms_.coeff_modulus()[j]);
                 multiply_uint_uint64(coeff_products_array_.get() + (j * coeff_mod_count), coeff_mod_count, tmp, coeff_mod_count, temp.get());
                 add_uint_uint_mod(temp.get(), value + (i * coeff_mod_count), mod_.get(), coeff_mod_count, value + (i * coeff_mod_count));
             }
@@ -351,6 +423,13 @@ namespace seal
         int array_poly_uint64_count = coeff_count * coeff_mod_count;
         int encrypted_size = encrypted.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are decrypted by the 
+        // Decryptor of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_decryptor())
+        {
+            return next_decryptor()->invariant_noise_budget(encrypted, pool);
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
@@ -382,38 +461,51 @@ namespace seal
         set_poly_poly(encrypted.pointer(1), (encrypted_size - 1) * coeff_count, coeff_mod_count, encrypted_copy.get());
 
         // Now do the dot product of encrypted_copy and the secret key array using NTT. The secret key powers are already NTT transformed.
-        Pointer copy_operand1(allocate_uint(coeff_count, pool));
+        // Lazy reduction; ciphertexts in NTT form need no transform
+        if (!encrypted.is_ntt_form_)
+        {
+            ntt_negacyclic_harvey_lazy(encrypted_copy.get(), coeff_count, coeff_mod_count, small_ntt_tables_->data(), encrypted_size - 1);
+        }
+
         for (int i = 0; i < coeff_mod_count; i++)
         {
             // Initialize pointers for multiplication
-            const uint64_t *current_array1 = encrypted.pointer(1) + (i * coeff_count);
+            uint64_t *current_array1 = encrypted_copy.get() + (i * coeff_count);
             const uint64_t *current_array2 = secret_key_array_.get() + (i * coeff_count);
 
             for (int j = 0; j < encrypted_size - 1; j++)
             {
                 // Perform the dyadic product. 
-                set_uint_uint(current_array1, coeff_count, copy_operand1.get());
-
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables_[i]);
-
-                dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count, small_ntt_tables_[i].modulus(), copy_operand1.get());
-                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), copy_operand1.get(), coeff_count, small_ntt_tables_[i].modulus(),
+                dyadic_product_coeffmod(current_array1, current_array2, coeff_count, (*small_ntt_tables_)[i].modulus(), current_array1);
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), current_array1, coeff_count, (*small_ntt_tables_)[i].modulus(),
                     noise_poly.get() + (i * coeff_count));
 
                 current_array1 += array_poly_uint64_count;
                 current_array2 += array_poly_uint64_count;
             }
+        }
 
-            // Perform inverse NTT
-            inverse_ntt_negacyclic_harvey(noise_poly.get() + (i * coeff_count), small_ntt_tables_[i]);
+        // For ciphertexts in NTT form c_0 is added before the inverse NTT
+        if (encrypted.is_ntt_form_)
+        {
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), encrypted.pointer() + (i * coeff_count),
+                    coeff_count, parms_.coeff_modulus()[i], noise_poly.get() + (i * coeff_count));
+            }
         }
 
+        // Perform inverse NTT
+        inverse_ntt_negacyclic_harvey(noise_poly.get(), coeff_count, coeff_mod_count, small_ntt_tables_->data());
+
         for (int i = 0; i < coeff_mod_count; i++)
         {
             // add c_0 into noise_poly
-            add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), encrypted.pointer() + (i * coeff_count),
-                coeff_count, parms_.coeff_modulus()[i], noise_poly.get() + (i * coeff_count));
+            if (!encrypted.is_ntt_form_)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), encrypted.pointer() + (i * coeff_count),
+                    coeff_count, parms_.coeff_modulus()[i], noise_poly.get() + (i * coeff_count));
+            }
 
             // Multiply by parms_.plain_modulus() and reduce mod parms_.coeff_modulus() to get parms_.coeff_modulus()*noise
             multiply_poly_scalar_coeffmod(noise_poly.get() + (i * coeff_count), coeff_count,
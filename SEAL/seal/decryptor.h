@@ -1,6 +1,8 @@
 #pragma once
 
 #include <utility>
+#include <memory>
+#include <vector>
 #include "seal/bigpolyarray.h"
 #include "seal/encryptionparams.h"
 #include "seal/context.h"
@@ -20,7 +22,8 @@ namespace seal
     /**
     Decrypts Ciphertext objects into Plaintext objects. Constructing a Decryptor requires
     a SEALContext with valid encryption parameters, and the secret key. The Decryptor is
-    also used to compute the invariant noise budget in a given ciphertext.
+    also used to compute the invariant noise budget in a given ciphertext. Ciphertexts at
+    every level of the modulus switching chain of the SEALContext can be decrypted.
 
     @par Overloads
     For the decrypt function we provide two overloads concerning the memory pool used in
@@ -146,6 +149,16 @@ namespace seal
 
         Decryptor &operator =(Decryptor &&assign) = delete;
 
+        // Creates the Decryptor for a lower level of the modulus switching chain
+        Decryptor(const std::shared_ptr<const SEALContext> &context, const std::uint64_t *secret_key, 
+            const MemoryPoolHandle &pool);
+
+        void initialize(const SEALContext &context, const std::uint64_t *secret_key);
+
+        // Returns the Decryptor for the next level of the modulus switching chain, or nullptr
+        // if this is the last level; it is created the first time it is needed
+        Decryptor *next_decryptor();
+
         void compute_secret_key_array(int max_power);
 
         void compose(std::uint64_t *value);
@@ -156,9 +169,9 @@ namespace seal
 
         EncryptionParameterQualifiers qualifiers_;
 
-        util::BaseConverter base_converter_;
+        std::shared_ptr<const util::BaseConverter> base_converter_;
 
-        std::vector<util::SmallNTTTables> small_ntt_tables_;
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> small_ntt_tables_;
 
         util::Pointer coeff_products_array_;
 
@@ -175,5 +188,12 @@ namespace seal
         util::Pointer secret_key_array_;
 
         mutable util::ReaderWriterLocker secret_key_array_locker_;
+
+        // The context of this level, from which the next level is created
+        std::shared_ptr<const SEALContext> context_;
+
+        std::unique_ptr<Decryptor> next_decryptor_;
+
+        mutable util::ReaderWriterLocker next_decryptor_locker_;
     };
 }
@@ -36,8 +36,7 @@ namespace seal
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
         int coeff_mod_count = parms_.coeff_modulus().size();
 
-        // Set SmallNTTTables
-        small_ntt_tables_.resize(coeff_mod_count, pool_);
+        // Share SmallNTTTables with the context
         small_ntt_tables_ = context.small_ntt_tables_;
         
         // Allocate space and copy over key
@@ -77,6 +76,10 @@ namespace seal
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = parms_.coeff_modulus().size();
 
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
         if (plain.coeff_count() > coeff_count || (plain.coeff_count() == coeff_count && plain[coeff_count - 1] != 0))
         {
             throw invalid_argument("plain is not valid for encryption parameters");
@@ -93,8 +96,9 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
-        // Make destination have right size and hash block
+        // Make destination have right size and hash block; fresh ciphertexts are in coefficient form
         destination.resize(parms_, 2);
+        destination.is_ntt_form_ = false;
 
         /*
         Ciphertext (c_0,c_1) should be a BigPolyArray
@@ -116,7 +120,7 @@ namespace seal
         for (int i = 0; i < coeff_mod_count; i++)
         {
             ntt_double_multiply_poly_nttpoly(u.get() + (i * coeff_count), public_key_.get() + (i * coeff_count), 
-                public_key_.get() + (coeff_count * coeff_mod_count) + (i * coeff_count), small_ntt_tables_[i], 
+                public_key_.get() + (coeff_count * coeff_mod_count) + (i * coeff_count), (*small_ntt_tables_)[i], 
                 destination.mutable_pointer() + (i * coeff_count), destination.mutable_pointer(1) + (i * coeff_count), pool);
         }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include "seal/encryptionparams.h"
 #include "seal/util/polymodulus.h"
 #include "seal/plaintext.h"
@@ -68,6 +69,7 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the encrypted plaintext
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         @throws std::invalid_argument if pool is uninitialized
         */
@@ -82,6 +84,7 @@ namespace seal
         @param[in] plain The plaintext to encrypt
         @param[out] destination The ciphertext to overwrite with the encrypted plaintext
         @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         inline void encrypt(const Plaintext &plain, Ciphertext &destination)
@@ -108,7 +111,7 @@ namespace seal
 
         EncryptionParameterQualifiers qualifiers_;
 
-        std::vector<util::SmallNTTTables> small_ntt_tables_;
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> small_ntt_tables_;
 
         std::uint64_t plain_upper_half_threshold_;
 
@@ -34,6 +34,18 @@ namespace seal
     would want to optimize the dbc to be as large as possible for performance. The dbc is 
     upper-bounded by the value of 60, and lower-bounded by the value of 1.
 
+    @par RNS Digits
+    Evaluation keys generated with KeyGenerator::generate_rns_evaluation_keys have a
+    decomposition bit count of 0. Instead of bits, they decompose the ciphertexts into the
+    residues modulo each of the primes in the coefficient modulus, so they hold only one
+    piece of data per prime, and relinearization needs far fewer NTTs. When such keys are 
+    used with a ciphertext at a lower level of the modulus switching chain, the primes that 
+    have been switched away act as special primes: the result is computed modulo all primes 
+    of the keys and then divided by the special primes, which keeps the noise added by 
+    relinearization small. At the top level the noise added is larger than with a moderate
+    dbc, so it is often worth generating the keys with one prime more than needed, and 
+    switching fresh ciphertexts down to the next level right away.
+
     @par Thread Safety
     In general, reading from EvaluationKeys is thread-safe as long as no other thread is
     concurrently mutating it. This is due to the underlying data structure storing the 
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <limits>
 #include "seal/evaluator.h"
 #include "seal/util/common.h"
 #include "seal/util/uintcore.h"
@@ -15,10 +16,51 @@ using namespace seal::util;
 
 namespace seal
 {
+    namespace
+    {
+        // Number of sets of Galois keys whose shortest path trees are cached by an Evaluator
+        const size_t max_galois_key_path_count = 16;
+
+        // Reduces the coefficients of poly modulo modulus with Barrett reduction, which unlike 
+        // modulo_poly_coeffs does not need a division for each coefficient
+        void reduce_poly_coeffs_barrett(const uint64_t *poly, int coeff_count, const SmallModulus &modulus, 
+            uint64_t *result)
+        {
+            uint64_t wide_coeff[2]{ 0, 0 };
+            for (int i = 0; i < coeff_count; i++)
+            {
+                wide_coeff[0] = *poly++;
+                *result++ = barrett_reduce_128(wide_coeff, modulus);
+            }
+        }
+
+        // Walks a shortest path tree computed by Evaluator::galois_key_path back from 
+        // galois_elt to the identity, collecting the keys on the way
+        vector<uint64_t> walk_galois_key_path(const vector<uint64_t> &tree, uint64_t galois_elt, uint64_t m)
+        {
+            vector<uint64_t> path;
+            uint64_t elt = galois_elt;
+            while (elt != 1)
+            {
+                uint64_t key_elt = tree[elt >> 1];
+                uint64_t key_elt_inverse;
+                if (key_elt == 0 || !try_mod_inverse(key_elt, m, key_elt_inverse))
+                {
+                    throw invalid_argument("galois key not present");
+                }
+                path.push_back(key_elt);
+                elt = (elt * key_elt_inverse) & (m - 1);
+            }
+            return path;
+        }
+    }
+
     Evaluator::Evaluator(const SEALContext &context, const MemoryPoolHandle &pool) :
         pool_(pool), parms_(context.parms()), qualifiers_(context.qualifiers()), 
         base_converter_(context.base_converter_), 
-        coeff_modulus_(context.coeff_modulus()) 
+        coeff_modulus_(context.coeff_modulus()),
+        galois_key_paths_locker_(new ReaderWriterLocker),
+        next_evaluator_locker_(new ReaderWriterLocker)
     {
         // Verify parameters
         if (!qualifiers_.parameters_set)
@@ -29,24 +71,57 @@ namespace seal
         {
             throw invalid_argument("pool is uninitialized");
         }
-        
+
+        // The top level decomposes in key switching with its own factors
+        key_hash_block_ = parms_.hash_block();
+        key_switch_factors_ = base_converter_->get_inv_coeff_mod_coeff_array();
+        key_coeff_modulus_ = coeff_modulus_;
+        key_small_ntt_tables_ = context.small_ntt_tables_;
+        context_ = make_shared<const SEALContext>(context);
+        initialize(context);
+
+        // Slot masks are plaintexts, so every level can use the same PolyCRTBuilder
+        if (qualifiers_.enable_batching)
+        {
+            poly_crt_builder_ = make_shared<PolyCRTBuilder>(context, pool_);
+        }
+    }
+
+    Evaluator::Evaluator(const shared_ptr<const SEALContext> &context, const Evaluator &parent) :
+        pool_(parent.pool_), parms_(context->parms()), qualifiers_(context->qualifiers()), 
+        base_converter_(context->base_converter_), 
+        poly_crt_builder_(parent.poly_crt_builder_),
+        coeff_modulus_(context->coeff_modulus()),
+        galois_key_paths_locker_(new ReaderWriterLocker),
+        key_hash_block_(parent.key_hash_block_),
+        key_switch_factors_(parent.key_switch_factors_),
+        key_coeff_modulus_(parent.key_coeff_modulus_),
+        key_small_ntt_tables_(parent.key_small_ntt_tables_),
+        thread_pool_(parent.thread_pool_),
+        context_(context),
+        next_evaluator_locker_(new ReaderWriterLocker)
+    {
+        initialize(*context);
+    }
+
+    void Evaluator::initialize(const SEALContext &context)
+    {
         int coeff_count = parms_.poly_modulus().coeff_count();
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
         int coeff_mod_count = coeff_modulus_.size();
-        bsk_base_mod_count_ = base_converter_.bsk_base_mod_count();
+        bsk_base_mod_count_ = base_converter_->bsk_base_mod_count();
         
-        // Set SmallNTTTables
-        bsk_small_ntt_tables_.resize(bsk_base_mod_count_, pool_);
-        bsk_small_ntt_tables_ = base_converter_.get_bsk_small_ntt_table();
-
-        coeff_small_ntt_tables_.resize(coeff_mod_count, pool_);
+        // Share SmallNTTTables with the context; the Bsk tables are owned by the base converter
+        bsk_small_ntt_tables_ = shared_ptr<const vector<SmallNTTTables>>(base_converter_, 
+            &base_converter_->get_bsk_small_ntt_table());
         coeff_small_ntt_tables_ = context.small_ntt_tables_;
+        galois_tables_ = context.galois_tables_;
 
         // Copy over bsk moduli array
-        bsk_mod_array_ = base_converter_.get_bsk_mod_array();
+        bsk_mod_array_ = base_converter_->get_bsk_mod_array();
 
         // Copy over inverse of coeff moduli products mod each coeff moduli
-        inv_coeff_products_mod_coeff_array_ = base_converter_.get_inv_coeff_mod_coeff_array();
+        inv_coeff_products_mod_coeff_array_ = base_converter_->get_inv_coeff_mod_coeff_array();
 
         // Populate coeff products array for compose functions (used in noise budget)
         coeff_products_array_ = allocate_uint(coeff_mod_count * coeff_mod_count, pool_);
@@ -119,8 +194,37 @@ namespace seal
         mod_ = Modulus(product_modulus_.get(), coeff_mod_count);
         polymod_ = PolyModulus(parms_.poly_modulus().pointer(), coeff_count, poly_coeff_uint64_count);
 
-        // Calculate map from Zmstar to generator representation
-        populate_Zmstar_to_generator();
+        // Calculate the inverses of the primes above this level for key switching with RNS digits
+        int key_mod_count = key_coeff_modulus_.size();
+        inv_special_primes_mod_coeff_.resize(key_mod_count - coeff_mod_count);
+        for (int t = coeff_mod_count; t < key_mod_count; t++)
+        {
+            vector<uint64_t> &inv_special_prime = inv_special_primes_mod_coeff_[t - coeff_mod_count];
+            inv_special_prime.resize(t);
+            for (int j = 0; j < t; j++)
+            {
+                if (!try_mod_inverse(key_coeff_modulus_[t].value() % key_coeff_modulus_[j].value(), 
+                    key_coeff_modulus_[j].value(), inv_special_prime[j]))
+                {
+                    throw invalid_argument("encryption parameters are not set correctly");
+                }
+            }
+        }
+
+        // Calculate the inverse of the last prime modulo the others for modulus switching
+        if (coeff_mod_count > 1)
+        {
+            uint64_t last_modulus = coeff_modulus_[coeff_mod_count - 1].value();
+            inv_last_coeff_mod_coeff_array_.resize(coeff_mod_count - 1);
+            for (int i = 0; i < coeff_mod_count - 1; i++)
+            {
+                if (!try_mod_inverse(last_modulus % coeff_modulus_[i].value(), coeff_modulus_[i].value(), 
+                    inv_last_coeff_mod_coeff_array_[i]))
+                {
+                    throw invalid_argument("encryption parameters are not set correctly");
+                }
+            }
+        }
     }
 
     Evaluator::Evaluator(const Evaluator &copy) :
@@ -128,13 +232,23 @@ namespace seal
         base_converter_(copy.base_converter_),
         coeff_small_ntt_tables_(copy.coeff_small_ntt_tables_),
         bsk_small_ntt_tables_(copy.bsk_small_ntt_tables_),
+        galois_tables_(copy.galois_tables_),
+        poly_crt_builder_(copy.poly_crt_builder_),
         plain_upper_half_threshold_(copy.plain_upper_half_threshold_),
         plain_upper_half_increment_array_(copy.plain_upper_half_increment_array_),
         coeff_modulus_(copy.coeff_modulus_),
         bsk_mod_array_(copy.bsk_mod_array_),
         inv_coeff_products_mod_coeff_array_(copy.inv_coeff_products_mod_coeff_array_),
         bsk_base_mod_count_(copy.bsk_base_mod_count_),
-        Zmstar_to_generator_(copy.Zmstar_to_generator_)
+        galois_key_paths_locker_(new ReaderWriterLocker),
+        key_hash_block_(copy.key_hash_block_),
+        key_switch_factors_(copy.key_switch_factors_),
+        key_coeff_modulus_(copy.key_coeff_modulus_),
+        key_small_ntt_tables_(copy.key_small_ntt_tables_),
+        inv_special_primes_mod_coeff_(copy.inv_special_primes_mod_coeff_),
+        inv_last_coeff_mod_coeff_array_(copy.inv_last_coeff_mod_coeff_array_),
+        context_(copy.context_),
+        next_evaluator_locker_(new ReaderWriterLocker)
     {
         int coeff_count = parms_.poly_modulus().coeff_count();
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
@@ -168,6 +282,81 @@ namespace seal
         // Initialize moduli.
         mod_ = Modulus(product_modulus_.get(), coeff_mod_count);
         polymod_ = PolyModulus(parms_.poly_modulus().pointer(), coeff_count, poly_coeff_uint64_count);
+
+        // The levels of the modulus switching chain that copy has created are copied too
+        ReaderLock reader_lock(copy.next_evaluator_locker_->acquire_read());
+        if (copy.next_evaluator_)
+        {
+            next_evaluator_.reset(new Evaluator(*copy.next_evaluator_));
+        }
+        reader_lock.release();
+
+        // The copy gets a thread pool of its own, which is shared by its modulus switching chain
+        if (copy.thread_pool_ && key_hash_block_ == parms_.hash_block())
+        {
+            set_thread_pool(make_shared<ThreadPool>(copy.thread_pool_->thread_count()));
+        }
+    }
+
+    Evaluator *Evaluator::next_evaluator()
+    {
+        // The next Evaluator never changes once it has been created, so it can be used after 
+        // the lock is released
+        ReaderLock reader_lock(next_evaluator_locker_->acquire_read());
+        if (next_evaluator_)
+        {
+            return next_evaluator_.get();
+        }
+        reader_lock.release();
+
+        auto next_context = context_->next_context();
+        if (!next_context)
+        {
+            return nullptr;
+        }
+        WriterLock writer_lock(next_evaluator_locker_->acquire_write());
+        if (!next_evaluator_)
+        {
+            next_evaluator_.reset(new Evaluator(next_context, *this));
+        }
+        return next_evaluator_.get();
+    }
+
+    void Evaluator::set_thread_count(int thread_count)
+    {
+        if (thread_count < 1)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+        if (thread_count == this->thread_count())
+        {
+            return;
+        }
+        set_thread_pool(thread_count > 1 ? make_shared<ThreadPool>(thread_count) : nullptr);
+    }
+
+    void Evaluator::set_thread_pool(const shared_ptr<ThreadPool> &thread_pool)
+    {
+        // Levels created later take the thread pool of the level above
+        WriterLock writer_lock(next_evaluator_locker_->acquire_write());
+        thread_pool_ = thread_pool;
+        if (next_evaluator_)
+        {
+            next_evaluator_->set_thread_pool(thread_pool);
+        }
+    }
+
+    void Evaluator::parallel_for(int task_count, const function<void(int)> &task)
+    {
+        if (thread_pool_)
+        {
+            thread_pool_->parallel_for(task_count, task);
+            return;
+        }
+        for (int i = 0; i < task_count; i++)
+        {
+            task(i);
+        }
     }
 
     void Evaluator::compose(uint64_t *value, const MemoryPoolHandle &pool)
@@ -214,20 +403,58 @@ namespace seal
         }
     }
 
-    void Evaluator::populate_Zmstar_to_generator()
+    vector<uint64_t> Evaluator::galois_key_path(uint64_t galois_elt, const GaloisKeys &galois_keys)
     {
         uint64_t n = parms_.poly_modulus().coeff_count() - 1;
         uint64_t m = n << 1;
 
-        for (uint64_t i = 0; i < n / 2; i++)
+        // The Galois elements with keys present identify the shortest path tree to use
+        vector<uint64_t> key_elts;
+        for (size_t index = 0; index < galois_keys.data().size(); index++)
+        {
+            if (!galois_keys.data()[index].empty())
+            {
+                key_elts.push_back((index << 1) + 1);
+            }
+        }
+
+        ReaderLock reader_lock(galois_key_paths_locker_->acquire_read());
+        auto tree_it = galois_key_paths_.find(key_elts);
+        if (tree_it != galois_key_paths_.end())
+        {
+            return walk_galois_key_path(tree_it->second, galois_elt, m);
+        }
+        reader_lock.release();
+
+        // Breadth-first search over the group of Galois elements from the identity. The
+        // group is abelian, so tree[(elt - 1) / 2] holds the last key of a shortest product
+        // reaching elt, in any order, or zero if elt cannot be reached at all.
+        vector<uint64_t> tree(n, 0);
+        vector<uint64_t> queue;
+        queue.reserve(n);
+        tree[0] = 1;
+        queue.push_back(1);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            for (size_t k = 0; k < key_elts.size(); k++)
+            {
+                uint64_t next_elt = (queue[head] * key_elts[k]) & (m - 1);
+                if (tree[next_elt >> 1] == 0)
+                {
+                    tree[next_elt >> 1] = key_elts[k];
+                    queue.push_back(next_elt);
+                }
+            }
+        }
+        vector<uint64_t> path = walk_galois_key_path(tree, galois_elt, m);
+
+        WriterLock writer_lock(galois_key_paths_locker_->acquire_write());
+        if (galois_key_paths_.size() >= max_galois_key_path_count)
         {
-            uint64_t galois_elt = (exponentiate_uint64(3, i)) & (m - 1);
-            pair<uint64_t, uint64_t> temp_pair1{ i, 0 };
-            Zmstar_to_generator_.emplace(galois_elt, temp_pair1);
-            galois_elt = (exponentiate_uint64(3, i) * (m - 1)) & (m - 1);
-            pair<uint64_t, uint64_t> temp_pair2 = { i, 1 };
-            Zmstar_to_generator_.emplace(galois_elt, temp_pair2);
+            galois_key_paths_.clear();
         }
+        galois_key_paths_.emplace(move(key_elts), move(tree));
+        return path;
     }
 
     void Evaluator::negate(Ciphertext &encrypted)
@@ -237,6 +464,14 @@ namespace seal
         int coeff_mod_count = coeff_modulus_.size();
         int encrypted_size = encrypted.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->negate(encrypted);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
@@ -264,6 +499,14 @@ namespace seal
         int max_count = max(encrypted1_size, encrypted2_size);
         int min_count = min(encrypted1_size, encrypted2_size);
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted1.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->add(encrypted1, encrypted2);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted1.hash_block_ != parms_.hash_block())
         {
@@ -273,6 +516,10 @@ namespace seal
         {
             throw invalid_argument("encrypted2 is not valid for encryption parameters");
         }
+        if (encrypted1.is_ntt_form_ != encrypted2.is_ntt_form_)
+        {
+            throw invalid_argument("encrypted1 and encrypted2 must both be in NTT form or both in coefficient form");
+        }
 
         // Prepare destination
         encrypted1.resize(parms_, max_count);
@@ -298,16 +545,85 @@ namespace seal
 
     void Evaluator::add_many(const vector<Ciphertext> &encrypteds, Ciphertext &destination)
     {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+
+        // Verify parameters.
         if (encrypteds.empty())
         {
             throw invalid_argument("encrypteds cannot be empty");
         }
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypteds[0].hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->add_many(encrypteds, destination);
+            return;
+        }
+
+        int max_size = 0;
+        bool destination_aliased = false;
+        for (const Ciphertext &encrypted : encrypteds)
+        {
+            if (encrypted.hash_block_ != parms_.hash_block())
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+            if (encrypted.is_ntt_form_ != encrypteds[0].is_ntt_form_)
+            {
+                throw invalid_argument("encrypteds must all be in NTT form or all in coefficient form");
+            }
+            max_size = max(max_size, encrypted.size());
+            destination_aliased = destination_aliased || (&encrypted == &destination);
+        }
+
+        // Prepare destination; if it is one of the summands the sum is formed separately
+        Ciphertext sum(pool_);
+        Ciphertext &result = destination_aliased ? sum : destination;
+        result.resize(parms_, max_size);
+        result.is_ntt_form_ = encrypteds[0].is_ntt_form_;
+
+        /*
+        The residues are summed up without reduction into the 64-bit coefficients of the 
+        result, one limb of one component at a time. The coefficients stay below q after a 
+        reduction, so with residues less than q they can take (2^64 - 1) / (q - 1) - 1 more 
+        summands before they need to be reduced again, e.g. 15 for 60-bit primes and millions 
+        for 40-bit primes. The limbs are independent and are split across the thread pool.
+        */
+        parallel_for(max_size * coeff_mod_count, [&](int index)
+        {
+            int j = index / coeff_mod_count;
+            int i = index % coeff_mod_count;
+            uint64_t modulus = coeff_modulus_[i].value();
+            uint64_t reduction_interval = numeric_limits<uint64_t>::max() / (modulus - 1) - 1;
+            uint64_t *sum_ptr = result.mutable_pointer(j) + (i * coeff_count);
+            set_zero_uint(coeff_count, sum_ptr);
+            uint64_t unreduced_count = 0;
+            for (const Ciphertext &encrypted : encrypteds)
+            {
+                if (encrypted.size() <= j)
+                {
+                    continue;
+                }
+                if (unreduced_count == reduction_interval)
+                {
+                    reduce_poly_coeffs_barrett(sum_ptr, coeff_count, coeff_modulus_[i], sum_ptr);
+                    unreduced_count = 0;
+                }
+                const uint64_t *encrypted_ptr = encrypted.pointer(j) + (i * coeff_count);
+                for (int m = 0; m < coeff_count; m++)
+                {
+                    sum_ptr[m] += encrypted_ptr[m];
+                }
+                unreduced_count++;
+            }
+            reduce_poly_coeffs_barrett(sum_ptr, coeff_count, coeff_modulus_[i], sum_ptr);
+        });
 
-        destination = encrypteds[0];
-        int encrypteds_size = encrypteds.size();
-        for (size_t i = 1; i < encrypteds_size; i++)
+        if (destination_aliased)
         {
-            add(destination, encrypteds[i]);
+            destination = sum;
         }
     }
 
@@ -321,6 +637,14 @@ namespace seal
         int max_count = max(encrypted1_size, encrypted2_size);
         int min_count = min(encrypted1_size, encrypted2_size);
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted1.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->sub(encrypted1, encrypted2);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted1.hash_block_ != parms_.hash_block())
         {
@@ -330,6 +654,10 @@ namespace seal
         {
             throw invalid_argument("encrypted2 is not valid for encryption parameters");
         }
+        if (encrypted1.is_ntt_form_ != encrypted2.is_ntt_form_)
+        {
+            throw invalid_argument("encrypted1 and encrypted2 must both be in NTT form or both in coefficient form");
+        }
 
         // Prepare destination
         encrypted1.resize(parms_, max_count);
@@ -358,14 +686,33 @@ namespace seal
     }
 
     void Evaluator::multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, const MemoryPoolHandle &pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Temporaries are allocated from pool as they are needed
+        EvaluatorWorkspace workspace(parms_.hash_block(), pool);
+        multiply(encrypted1, encrypted2, workspace);
+    }
+
+    void Evaluator::multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, EvaluatorWorkspace &workspace)
     {
         // Extract encryption parameters.
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = coeff_modulus_.size();
-        int bsk_mtilde_count = bsk_base_mod_count_ + 1;
         int encrypted1_size = encrypted1.size();
         int encrypted2_size = encrypted2.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted1.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->multiply(encrypted1, encrypted2, workspace);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted1.hash_block_ != parms_.hash_block())
         {
@@ -375,10 +722,11 @@ namespace seal
         {
             throw invalid_argument("encrypted2 is not valid for encryption parameters");
         }
-        if (!pool)
+        if (!is_valid_workspace(workspace))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("workspace is not valid for encryption parameters");
         }
+        workspace.reset();
 
         // Determine destination.size()
         // Default is 3 (c_0, c_1, c_2)
@@ -387,320 +735,274 @@ namespace seal
         // Prepare destination
         encrypted1.resize(parms_, dest_count);
 
-        int encrypted_ptr_increment = coeff_count * coeff_mod_count;
-        int encrypted_bsk_mtilde_ptr_increment = coeff_count * bsk_mtilde_count;
-        int encrypted_bsk_ptr_increment = coeff_count * bsk_base_mod_count_;
-
-        // Make temp polys for FastBConverter result from q ---> Bsk U {m_tilde}
-        Pointer tmp_encrypted1_bsk_mtilde(allocate_poly(coeff_count * encrypted1_size, bsk_mtilde_count, pool));
-        Pointer tmp_encrypted2_bsk_mtilde(allocate_poly(coeff_count * encrypted2_size, bsk_mtilde_count, pool));
-
-        // Make temp polys for FastBConverter result from Bsk U {m_tilde} -----> Bsk
-        Pointer tmp_encrypted1_bsk(allocate_poly(coeff_count * encrypted1_size, bsk_base_mod_count_, pool));
-        Pointer tmp_encrypted2_bsk(allocate_poly(coeff_count * encrypted2_size, bsk_base_mod_count_, pool));
+        // The product is written to encrypted1 in coefficient form
+        multiply_behz(encrypted1.pointer(), encrypted1_size, encrypted1.is_ntt_form_, encrypted2.pointer(), 
+            encrypted2_size, encrypted2.is_ntt_form_, encrypted1.mutable_pointer(), 
+            encrypted1.mutable_pointer(dest_count - 1), workspace);
 
-        // Step 0: fast base convert from q to Bsk U {m_tilde}
-        // Step 1: reduce q-overflows in Bsk
-        // Iterate over all the ciphertexts inside encrypted1
-        for (int i = 0; i < encrypted1_size; i++)
-        {
-            base_converter_.fastbconv_mtilde(encrypted1.pointer(i), 
-                tmp_encrypted1_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment), pool);
-            base_converter_.mont_rq(tmp_encrypted1_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment), 
-                tmp_encrypted1_bsk.get() + (i * encrypted_bsk_ptr_increment));
-        }
-        
-        // Iterate over all the ciphertexts inside encrypted2
-        for (int i = 0; i < encrypted2_size; i++)
+        // The product is returned in the form of encrypted1
+        if (encrypted1.is_ntt_form_)
         {
-            base_converter_.fastbconv_mtilde(encrypted2.pointer(i), 
-                tmp_encrypted2_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment), pool);
-            base_converter_.mont_rq(tmp_encrypted2_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment), 
-                tmp_encrypted2_bsk.get() + (i * encrypted_bsk_ptr_increment));
+            ntt_negacyclic_harvey(encrypted1.mutable_pointer(), coeff_count, coeff_mod_count, 
+                coeff_small_ntt_tables_->data(), dest_count);
         }
-        
-        // Step 2: compute product and multiply plain modulus to the result
-        // We need to multiply both in q and Bsk. Values in encrypted_safe are in base q and values in tmp_encrypted_bsk are in base Bsk
-        // We iterate over destination poly array and generate each poly based on the indices of inputs (arbitrary sizes for ciphertexts)
-        // First allocate two temp polys: one for results in base q and the other for the result in base Bsk
-        // These need to be zero for the arbitrary size multiplication; not for 2x2 though
-        Pointer tmp_des_coeff_base(allocate_zero_poly(coeff_count * dest_count, coeff_mod_count, pool));
-        Pointer tmp_des_bsk_base(allocate_zero_poly(coeff_count * dest_count, bsk_base_mod_count_, pool));
-
-        // Allocate two tmp polys: one for NTT multiplication results in base q and one for result in base Bsk
-        Pointer tmp1_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-        Pointer tmp1_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count_, pool));
-        Pointer tmp2_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-        Pointer tmp2_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count_, pool));
-
-        int current_encrypted1_limit = 0;
-
-        // First convert all the inputs into NTT form
-        Pointer copy_encrypted1_ntt_coeff_mod(allocate_poly(coeff_count * encrypted1_size, coeff_mod_count, pool));
-        set_poly_poly(encrypted1.pointer(), coeff_count * encrypted1_size, coeff_mod_count, copy_encrypted1_ntt_coeff_mod.get());
-
-        Pointer copy_encrypted1_ntt_bsk_base_mod(allocate_poly(coeff_count * encrypted1_size, bsk_base_mod_count_, pool));
-        set_poly_poly(tmp_encrypted1_bsk.get(), coeff_count * encrypted1_size, bsk_base_mod_count_, copy_encrypted1_ntt_bsk_base_mod.get());
+    }
 
-        Pointer copy_encrypted2_ntt_coeff_mod(allocate_poly(coeff_count * encrypted2_size, coeff_mod_count, pool));
-        set_poly_poly(encrypted2.pointer(), coeff_count * encrypted2_size, coeff_mod_count, copy_encrypted2_ntt_coeff_mod.get());
+    void Evaluator::multiply_behz(const uint64_t *encrypted1, int encrypted1_size, bool encrypted1_is_ntt_form, 
+        const uint64_t *encrypted2, int encrypted2_size, bool encrypted2_is_ntt_form, 
+        uint64_t *destination, uint64_t *destination_last, EvaluatorWorkspace &workspace)
+    {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int bsk_mtilde_count = bsk_base_mod_count_ + 1;
+        int total_mod_count = coeff_mod_count + bsk_base_mod_count_;
+        int input_count = encrypted1_size + encrypted2_size;
+        int dest_count = encrypted1_size + encrypted2_size - 1;
 
-        Pointer copy_encrypted2_ntt_bsk_base_mod(allocate_poly(coeff_count * encrypted2_size, bsk_base_mod_count_, pool));
-        set_poly_poly(tmp_encrypted2_bsk.get(), coeff_count * encrypted2_size, bsk_base_mod_count_, copy_encrypted2_ntt_bsk_base_mod.get());
+        int encrypted_ptr_increment = coeff_count * coeff_mod_count;
+        int encrypted_bsk_mtilde_ptr_increment = coeff_count * bsk_mtilde_count;
+        int encrypted_bsk_ptr_increment = coeff_count * bsk_base_mod_count_;
 
-        for (int i = 0; i < encrypted1_size; i++)
-        {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_encrypted1_ntt_coeff_mod.get() + (j * coeff_count) + (i * encrypted_ptr_increment), coeff_small_ntt_tables_[j]);
-            }
-            for (int j = 0; j < bsk_base_mod_count_; j++)
-            {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_encrypted1_ntt_bsk_base_mod.get() + (j * coeff_count) + (i * encrypted_bsk_ptr_increment), bsk_small_ntt_tables_[j]);
-            }
-        }
+        /*
+        The work is split into independent tasks, one per poly for the base conversions, and 
+        one per poly and prime for everything else. Each task writes to its own part of the 
+        temporaries, so the result does not depend on how the tasks are scheduled.
+        */
 
-        for (int i = 0; i < encrypted2_size; i++)
+        // Base conversion needs the inputs in coefficient form; NTT form inputs are transformed 
+        // to a temporary copy, and their NTT form is used directly below
+        const uint64_t *encrypted1_coeff_ptr = encrypted1;
+        if (encrypted1_is_ntt_form)
         {
-            for (int j = 0; j < coeff_mod_count; j++)
+            uint64_t *encrypted1_coeff_form = workspace.get_poly(coeff_count * encrypted1_size, coeff_mod_count);
+            parallel_for(encrypted1_size * coeff_mod_count, [&](int index)
             {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_encrypted2_ntt_coeff_mod.get() + (j * coeff_count) + (i * encrypted_ptr_increment), coeff_small_ntt_tables_[j]);
-            }
-            for (int j = 0; j < bsk_base_mod_count_; j++)
+                int offset = index * coeff_count;
+                set_uint_uint(encrypted1 + offset, coeff_count, encrypted1_coeff_form + offset);
+                inverse_ntt_negacyclic_harvey(encrypted1_coeff_form + offset, coeff_count, 1, 
+                    coeff_small_ntt_tables_->data() + (index % coeff_mod_count));
+            });
+            encrypted1_coeff_ptr = encrypted1_coeff_form;
+        }
+        const uint64_t *encrypted2_coeff_ptr = encrypted2;
+        if (encrypted2_is_ntt_form)
+        {
+            uint64_t *encrypted2_coeff_form = workspace.get_poly(coeff_count * encrypted2_size, coeff_mod_count);
+            parallel_for(encrypted2_size * coeff_mod_count, [&](int index)
             {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_encrypted2_ntt_bsk_base_mod.get() + (j * coeff_count) + (i * encrypted_bsk_ptr_increment), bsk_small_ntt_tables_[j]);
-            }
+                int offset = index * coeff_count;
+                set_uint_uint(encrypted2 + offset, coeff_count, encrypted2_coeff_form + offset);
+                inverse_ntt_negacyclic_harvey(encrypted2_coeff_form + offset, coeff_count, 1, 
+                    coeff_small_ntt_tables_->data() + (index % coeff_mod_count));
+            });
+            encrypted2_coeff_ptr = encrypted2_coeff_form;
         }
 
-        // Perform Karatsuba multiplication on size 2 ciphertexts
-        if (encrypted1_size == 2 && encrypted2_size == 2)
-        {
-            Pointer tmp_first_mul_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
+        // Scratch space for the base conversions, one poly's worth per concurrent conversion
+        int base_conversion_temp_increment = coeff_count * (coeff_mod_count + 2);
+        uint64_t *base_conversion_temp = workspace.get_poly(coeff_count * max(input_count, dest_count), 
+            coeff_mod_count + 2);
 
-            // Compute c0 + c1 and c0*d0 in base q
-            uint64_t *temp_ptr_1 = tmp1_poly_coeff_base.get();
-            uint64_t *temp_ptr_2 = copy_encrypted1_ntt_coeff_mod.get();
-            uint64_t *temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment;
-            for (int i = 0; i < coeff_mod_count; i++)
-            {
-                //add_poly_poly_coeffmod(copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count), 
-                //    copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment, 
-                //    coeff_count, coeff_modulus_[i], tmp1_poly_coeff_base.get() + (i * coeff_count));
+        // Make temp polys for FastBConverter result from q ---> Bsk U {m_tilde}
+        uint64_t *tmp_encrypted_bsk_mtilde = workspace.get_poly(coeff_count * input_count, bsk_mtilde_count);
 
-                // Lazy reduction
-                for (int j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                dyadic_product_coeffmod(copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count), 
-                    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count), coeff_count, coeff_modulus_[i], 
-                    tmp_first_mul_coeff_base.get() + (i * coeff_count));
-            }
+        // Make temp polys for FastBConverter result from Bsk U {m_tilde} -----> Bsk; the polys of
+        // encrypted2 follow those of encrypted1
+        uint64_t *tmp_encrypted1_bsk = workspace.get_poly(coeff_count * input_count, bsk_base_mod_count_);
+        uint64_t *tmp_encrypted2_bsk = tmp_encrypted1_bsk + (encrypted1_size * encrypted_bsk_ptr_increment);
 
-            Pointer tmp_first_mul_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count_, pool));
+        // Step 0: fast base convert from q to Bsk U {m_tilde}
+        // Step 1: reduce q-overflows in Bsk
+        // Iterate over all the ciphertexts inside encrypted1 and encrypted2
+        parallel_for(input_count, [&](int index)
+        {
+            const uint64_t *input_ptr = (index < encrypted1_size) ? 
+                encrypted1_coeff_ptr + (index * encrypted_ptr_increment) : 
+                encrypted2_coeff_ptr + ((index - encrypted1_size) * encrypted_ptr_increment);
+            base_converter_->fastbconv_mtilde(input_ptr, 
+                tmp_encrypted_bsk_mtilde + (index * encrypted_bsk_mtilde_ptr_increment), 
+                base_conversion_temp + (index * base_conversion_temp_increment));
+            base_converter_->mont_rq(tmp_encrypted_bsk_mtilde + (index * encrypted_bsk_mtilde_ptr_increment), 
+                tmp_encrypted1_bsk + (index * encrypted_bsk_ptr_increment));
+        });
+
+        // Convert all the inputs into NTT form; inputs already in NTT form are used as they are, and 
+        // the Bsk parts are transformed in place
+        const uint64_t *copy_encrypted1_ntt_coeff_mod = encrypted1;
+        uint64_t *encrypted1_ntt_copy = nullptr;
+        if (!encrypted1_is_ntt_form)
+        {
+            encrypted1_ntt_copy = workspace.get_poly(coeff_count * encrypted1_size, coeff_mod_count);
+            copy_encrypted1_ntt_coeff_mod = encrypted1_ntt_copy;
+        }
+        const uint64_t *copy_encrypted2_ntt_coeff_mod = encrypted2;
+        uint64_t *encrypted2_ntt_copy = nullptr;
+        if (!encrypted2_is_ntt_form)
+        {
+            encrypted2_ntt_copy = workspace.get_poly(coeff_count * encrypted2_size, coeff_mod_count);
+            copy_encrypted2_ntt_coeff_mod = encrypted2_ntt_copy;
+        }
+        const uint64_t *copy_encrypted1_ntt_bsk_base_mod = tmp_encrypted1_bsk;
+        const uint64_t *copy_encrypted2_ntt_bsk_base_mod = tmp_encrypted2_bsk;
 
-            // Compute c0 + c1 and c0*d0 in base bsk
-            temp_ptr_1 = tmp1_poly_bsk_base.get();
-            temp_ptr_2 = copy_encrypted1_ntt_bsk_base_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_bsk_ptr_increment;
-            for (int i = 0; i < bsk_base_mod_count_; i++)
+        // Lazy reduction
+        parallel_for(input_count * total_mod_count, [&](int index)
+        {
+            int input_index = index / total_mod_count;
+            int mod_index = index % total_mod_count;
+            if (mod_index >= coeff_mod_count)
             {
-                //add_poly_poly_coeffmod(copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count), 
-                //    copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment, 
-                //    coeff_count, bsk_mod_array_[i], tmp1_poly_bsk_base.get() + (i * coeff_count));
-                for (int j = 0; j < coeff_count; j++)
+                mod_index -= coeff_mod_count;
+                ntt_negacyclic_harvey_lazy(tmp_encrypted1_bsk + (input_index * encrypted_bsk_ptr_increment) + 
+                    (mod_index * coeff_count), (*bsk_small_ntt_tables_)[mod_index]);
+                return;
+            }
+            int offset = mod_index * coeff_count;
+            if (input_index < encrypted1_size)
+            {
+                if (encrypted1_is_ntt_form)
                 {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
+                    return;
                 }
-                dyadic_product_coeffmod(copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count), 
-                    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count), coeff_count, bsk_mod_array_[i], 
-                    tmp_first_mul_bsk_base.get() + (i * coeff_count));
+                offset += input_index * encrypted_ptr_increment;
+                set_uint_uint(encrypted1 + offset, coeff_count, encrypted1_ntt_copy + offset);
+                ntt_negacyclic_harvey_lazy(encrypted1_ntt_copy + offset, (*coeff_small_ntt_tables_)[mod_index]);
             }
-
-            Pointer tmp_second_mul_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            // Compute d0 + d1 and c1*d1 in base q
-            temp_ptr_1 = tmp2_poly_coeff_base.get();
-            temp_ptr_2 = copy_encrypted2_ntt_coeff_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment;
-            for (int i = 0; i < coeff_mod_count; i++)
+            else
             {
-                //add_poly_poly_coeffmod(copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count), 
-                //    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment, 
-                //    coeff_count, coeff_modulus_[i], tmp2_poly_coeff_base.get() + (i * coeff_count));
-                for (int j = 0; j < coeff_count; j++)
+                if (encrypted2_is_ntt_form)
                 {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
+                    return;
                 }
-                dyadic_product_coeffmod(copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment, 
-                    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment, 
-                    coeff_count, coeff_modulus_[i], tmp_second_mul_coeff_base.get() + (i * coeff_count));
+                offset += (input_index - encrypted1_size) * encrypted_ptr_increment;
+                set_uint_uint(encrypted2 + offset, coeff_count, encrypted2_ntt_copy + offset);
+                ntt_negacyclic_harvey_lazy(encrypted2_ntt_copy + offset, (*coeff_small_ntt_tables_)[mod_index]);
             }
+        });
 
-            Pointer tmp_second_mul_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count_, pool));
+        // Step 2: compute product and multiply plain modulus to the result
+        // We need to multiply both in q and Bsk. Values in encrypted_safe are in base q and values in tmp_encrypted_bsk are in base Bsk
+        // We iterate over destination poly array and generate each poly based on the indices of inputs (arbitrary sizes for ciphertexts)
+        // First allocate two temp polys: one for results in base q and the other for the result in base Bsk
+        uint64_t *tmp_des_coeff_base = workspace.get_poly(coeff_count * dest_count, coeff_mod_count);
+        uint64_t *tmp_des_bsk_base = workspace.get_poly(coeff_count * dest_count, bsk_base_mod_count_);
 
-            // Compute d0 + d1 and c1*d1 in base bsk
-            temp_ptr_1 = tmp2_poly_bsk_base.get();
-            temp_ptr_2 = copy_encrypted2_ntt_bsk_base_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_bsk_ptr_increment;
-            for (int i = 0; i < bsk_base_mod_count_; i++)
+        // Allocate two tmp polys: one for NTT multiplication results in base q and one for result in base Bsk
+        uint64_t *tmp1_poly_coeff_base = workspace.get_poly(coeff_count, coeff_mod_count);
+        uint64_t *tmp1_poly_bsk_base = workspace.get_poly(coeff_count, bsk_base_mod_count_);
+        uint64_t *tmp2_poly_coeff_base = workspace.get_poly(coeff_count, coeff_mod_count);
+        uint64_t *tmp2_poly_bsk_base = workspace.get_poly(coeff_count, bsk_base_mod_count_);
+
+        // The products are computed one prime at a time; the primes of q come first, followed by
+        // those of Bsk
+        auto multiply_mod = [&](int mod_index)
+        {
+            bool is_coeff_base = mod_index < coeff_mod_count;
+            int i = is_coeff_base ? mod_index : mod_index - coeff_mod_count;
+            const SmallModulus &modulus = is_coeff_base ? coeff_modulus_[i] : bsk_mod_array_[i];
+            int ptr_increment = is_coeff_base ? encrypted_ptr_increment : encrypted_bsk_ptr_increment;
+            int offset = i * coeff_count;
+            const uint64_t *encrypted1_ptr = (is_coeff_base ? 
+                copy_encrypted1_ntt_coeff_mod : copy_encrypted1_ntt_bsk_base_mod) + offset;
+            const uint64_t *encrypted2_ptr = (is_coeff_base ? 
+                copy_encrypted2_ntt_coeff_mod : copy_encrypted2_ntt_bsk_base_mod) + offset;
+            uint64_t *tmp1_ptr = (is_coeff_base ? tmp1_poly_coeff_base : tmp1_poly_bsk_base) + offset;
+            uint64_t *tmp2_ptr = (is_coeff_base ? tmp2_poly_coeff_base : tmp2_poly_bsk_base) + offset;
+            uint64_t *des_ptr = (is_coeff_base ? tmp_des_coeff_base : tmp_des_bsk_base) + offset;
+
+            // Perform Karatsuba multiplication on size 2 ciphertexts
+            if (encrypted1_size == 2 && encrypted2_size == 2)
             {
-                //add_poly_poly_coeffmod(copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count), 
-                //    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment, 
-                //    coeff_count, bsk_mod_array_[i], tmp2_poly_bsk_base.get() + (i * coeff_count));
+                // Compute c0 + c1 and d0 + d1 with lazy reduction
                 for (int j = 0; j < coeff_count; j++)
                 {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
+                    tmp1_ptr[j] = encrypted1_ptr[j] + encrypted1_ptr[j + ptr_increment];
+                    tmp2_ptr[j] = encrypted2_ptr[j] + encrypted2_ptr[j + ptr_increment];
                 }
-                dyadic_product_coeffmod(copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment, 
-                    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment, 
-                    coeff_count, bsk_mod_array_[i], tmp_second_mul_bsk_base.get() + (i * coeff_count));
-            }
-
-            Pointer tmp_mul_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-            Pointer tmp_mul_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count_, pool));
 
-            // Set destination first and third polys in base q
-            // Des[0] in base q
-            set_poly_poly(tmp_first_mul_coeff_base.get(), coeff_count, coeff_mod_count, tmp_des_coeff_base.get());
+                // Des[0] = c0*d0 and Des[2] = c1*d1
+                dyadic_product_coeffmod(encrypted1_ptr, encrypted2_ptr, coeff_count, modulus, des_ptr);
+                dyadic_product_coeffmod(encrypted1_ptr + ptr_increment, encrypted2_ptr + ptr_increment, 
+                    coeff_count, modulus, des_ptr + 2 * ptr_increment);
 
-            // Des[2] in base q
-            set_poly_poly(tmp_second_mul_coeff_base.get(), coeff_count, coeff_mod_count, tmp_des_coeff_base.get() + 2 * encrypted_ptr_increment);
-            
-            // Compute (c0 + c1)*(d0 + d1) - c0*d0 - c1*d1 in base q
-            for (int i = 0; i < coeff_mod_count; i++)
-            {
-                dyadic_product_coeffmod(tmp1_poly_coeff_base.get() + (i * coeff_count), tmp2_poly_coeff_base.get() + (i * coeff_count), 
-                    coeff_count, coeff_modulus_[i], tmp_mul_poly_coeff_base.get() + (i * coeff_count));
-                sub_poly_poly_coeffmod(tmp_mul_poly_coeff_base.get() + (i * coeff_count), 
-                    tmp_first_mul_coeff_base.get() + (i * coeff_count), coeff_count, coeff_modulus_[i], 
-                    tmp_mul_poly_coeff_base.get() + (i * coeff_count));
-                
-                // Des[1] in base q
-                sub_poly_poly_coeffmod(tmp_mul_poly_coeff_base.get() + (i * coeff_count), 
-                    tmp_second_mul_coeff_base.get() + (i * coeff_count), coeff_count, coeff_modulus_[i], 
-                    tmp_des_coeff_base.get() + (i * coeff_count) + encrypted_ptr_increment);
+                // Des[1] = (c0 + c1)*(d0 + d1) - c0*d0 - c1*d1
+                dyadic_product_coeffmod(tmp1_ptr, tmp2_ptr, coeff_count, modulus, tmp1_ptr);
+                sub_poly_poly_coeffmod(tmp1_ptr, des_ptr, coeff_count, modulus, tmp1_ptr);
+                sub_poly_poly_coeffmod(tmp1_ptr, des_ptr + 2 * ptr_increment, coeff_count, modulus, 
+                    des_ptr + ptr_increment);
+                return;
             }
 
-            // Set destination first and third polys in base bsk
-            // Des[0] in base bsk
-            set_poly_poly(tmp_first_mul_bsk_base.get(), coeff_count, bsk_base_mod_count_, tmp_des_bsk_base.get());
-
-            // Des[2] in base q
-            set_poly_poly(tmp_second_mul_bsk_base.get(), coeff_count, bsk_base_mod_count_, 
-                tmp_des_bsk_base.get() + 2 * encrypted_bsk_ptr_increment);
-
-            // Compute (c0 + c1)*(d0 + d1)  - c0d0 - c1d1 in base bsk
-            for (int i = 0; i < bsk_base_mod_count_; i++)
-            {
-                dyadic_product_coeffmod(tmp1_poly_bsk_base.get() + (i * coeff_count), 
-                    tmp2_poly_bsk_base.get() + (i * coeff_count), coeff_count, bsk_mod_array_[i], 
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count));
-                sub_poly_poly_coeffmod(tmp_mul_poly_bsk_base.get() + (i * coeff_count), 
-                    tmp_first_mul_bsk_base.get() + (i * coeff_count), coeff_count, bsk_mod_array_[i], 
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count));
-
-                // Des[1] in bsk
-                sub_poly_poly_coeffmod(tmp_mul_poly_bsk_base.get() + (i * coeff_count), 
-                    tmp_second_mul_bsk_base.get() + (i * coeff_count), coeff_count, bsk_mod_array_[i], 
-                    tmp_des_bsk_base.get() + (i * coeff_count) + encrypted_bsk_ptr_increment); 
-            }
-        }
-        else
-        {
             // Perform multiplication on arbitrary size ciphertexts
             for (int secret_power_index = 0; secret_power_index < dest_count; secret_power_index++)
             {
+                uint64_t *des_power_ptr = des_ptr + (secret_power_index * ptr_increment);
+                set_zero_uint(coeff_count, des_power_ptr);
+
                 // Loop over encrypted1 components [i], seeing if a match exists with an encrypted2 
                 // component [j] such that [i+j]=[secret_power_index]
                 // Only need to check encrypted1 components up to and including [secret_power_index], 
                 // and strictly less than [encrypted_array.size()]
-                current_encrypted1_limit = min(encrypted1_size, secret_power_index + 1);
-
+                int current_encrypted1_limit = min(encrypted1_size, secret_power_index + 1);
                 for (int encrypted1_index = 0; encrypted1_index < current_encrypted1_limit; encrypted1_index++)
                 {
                     // check if a corresponding component in encrypted2 exists
                     if (encrypted2_size > secret_power_index - encrypted1_index)
                     {
                         int encrypted2_index = secret_power_index - encrypted1_index;
-
-                        // NTT Multiplication and addition for results in q
-                        for (int i = 0; i < coeff_mod_count; i++)
-                        {
-                            dyadic_product_coeffmod(copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + (encrypted_ptr_increment * encrypted1_index), 
-                                copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + (encrypted_ptr_increment * encrypted2_index), 
-                                coeff_count, coeff_modulus_[i], tmp1_poly_coeff_base.get() + (i * coeff_count));
-                            add_poly_poly_coeffmod(tmp1_poly_coeff_base.get() + (i * coeff_count), 
-                                tmp_des_coeff_base.get() + (i * coeff_count) + (secret_power_index * coeff_count * coeff_mod_count), coeff_count, 
-                                coeff_modulus_[i], tmp_des_coeff_base.get() + (i * coeff_count) + (secret_power_index * coeff_count * coeff_mod_count));
-                        }
-
-                        // NTT Multiplication and addition for results in Bsk
-                        for (int i = 0; i < bsk_base_mod_count_; i++)
-                        {
-                            dyadic_product_coeffmod(copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count) + (encrypted_bsk_ptr_increment * encrypted1_index), 
-                                copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count) + (encrypted_bsk_ptr_increment * encrypted2_index), 
-                                coeff_count, bsk_mod_array_[i], tmp1_poly_bsk_base.get() + (i * coeff_count));
-                            add_poly_poly_coeffmod(tmp1_poly_bsk_base.get() + (i * coeff_count), 
-                                tmp_des_bsk_base.get() + (i * coeff_count) + (secret_power_index * coeff_count * bsk_base_mod_count_), 
-                                coeff_count, bsk_mod_array_[i], 
-                                tmp_des_bsk_base.get() + (i * coeff_count) + (secret_power_index * coeff_count * bsk_base_mod_count_));
-                        }
+                        dyadic_product_coeffmod(encrypted1_ptr + (ptr_increment * encrypted1_index), 
+                            encrypted2_ptr + (ptr_increment * encrypted2_index), coeff_count, modulus, tmp1_ptr);
+                        add_poly_poly_coeffmod(tmp1_ptr, des_power_ptr, coeff_count, modulus, des_power_ptr);
                     }
                 }
             }
-        }
-        // Convert back outputs from NTT form
-        for (int i = 0; i < dest_count; i++)
-        {
-            for (int j = 0; j < coeff_mod_count; j++)
+        };
+        parallel_for(total_mod_count, multiply_mod);
+
+        // Now we convert the outputs back from NTT form, multiply plain modulus to both results in 
+        // base q and Bsk, and allocate them together in one container as 
+        // (te0)q(te'0)Bsk | ... |te count)q (te' count)Bsk to make it ready for fast_floor 
+        uint64_t *tmp_coeff_bsk_together = workspace.get_poly(coeff_count, dest_count * total_mod_count);
+        parallel_for(dest_count * total_mod_count, [&](int index)
+        {
+            int dest_index = index / total_mod_count;
+            int mod_index = index % total_mod_count;
+            uint64_t *together_ptr = tmp_coeff_bsk_together + (index * coeff_count);
+            if (mod_index < coeff_mod_count)
             {
-                inverse_ntt_negacyclic_harvey(tmp_des_coeff_base.get() + (i * (encrypted_ptr_increment)) + (j * coeff_count), coeff_small_ntt_tables_[j]);
+                uint64_t *des_ptr = tmp_des_coeff_base + (dest_index * encrypted_ptr_increment) + 
+                    (mod_index * coeff_count);
+                inverse_ntt_negacyclic_harvey(des_ptr, coeff_count, 1, coeff_small_ntt_tables_->data() + mod_index);
+                multiply_poly_scalar_coeffmod(des_ptr, coeff_count, parms_.plain_modulus().value(), 
+                    coeff_modulus_[mod_index], together_ptr);
             }
-            for (int j = 0; j < bsk_base_mod_count_; j++)
+            else
             {
-                inverse_ntt_negacyclic_harvey(tmp_des_bsk_base.get() + (i * (encrypted_bsk_ptr_increment)) + (j * coeff_count), bsk_small_ntt_tables_[j]);
+                mod_index -= coeff_mod_count;
+                uint64_t *des_ptr = tmp_des_bsk_base + (dest_index * encrypted_bsk_ptr_increment) + 
+                    (mod_index * coeff_count);
+                inverse_ntt_negacyclic_harvey(des_ptr, coeff_count, 1, bsk_small_ntt_tables_->data() + mod_index);
+                multiply_poly_scalar_coeffmod(des_ptr, coeff_count, parms_.plain_modulus().value(), 
+                    bsk_mod_array_[mod_index], together_ptr);
             }
-        }
-
-        // Now we multiply plain modulus to both results in base q and Bsk and allocate them together in one 
-        // container as (te0)q(te'0)Bsk | ... |te count)q (te' count)Bsk to make it ready for fast_floor 
-        Pointer tmp_coeff_bsk_together(allocate_poly(coeff_count, dest_count * (coeff_mod_count + bsk_base_mod_count_), pool));
-        uint64_t *tmp_coeff_bsk_together_ptr = tmp_coeff_bsk_together.get();
-
-        // Base q 
-        for (int i = 0; i < dest_count; i++)
-        {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                multiply_poly_scalar_coeffmod(tmp_des_coeff_base.get() + (j * coeff_count) + (i * encrypted_ptr_increment), 
-                    coeff_count, parms_.plain_modulus().value(), coeff_modulus_[j], tmp_coeff_bsk_together_ptr + (j * coeff_count));
-            }
-            tmp_coeff_bsk_together_ptr += encrypted_ptr_increment;
-            
-            for (int k = 0; k < bsk_base_mod_count_; k++)
-            {
-                multiply_poly_scalar_coeffmod(tmp_des_bsk_base.get() + (k * coeff_count) + (i * encrypted_bsk_ptr_increment), 
-                    coeff_count, parms_.plain_modulus().value(), bsk_mod_array_[k], tmp_coeff_bsk_together_ptr + (k * coeff_count));
-            }
-            tmp_coeff_bsk_together_ptr += encrypted_bsk_ptr_increment;
-        }
+        });
 
         // Allocate a new poly for fast floor result in Bsk
-        Pointer tmp_result_bsk(allocate_poly(coeff_count, dest_count * bsk_base_mod_count_, pool));
-        for (int i = 0; i < dest_count; i++)
+        uint64_t *tmp_result_bsk = workspace.get_poly(coeff_count, dest_count * bsk_base_mod_count_);
+        parallel_for(dest_count, [&](int i)
         {
+            uint64_t *temp_ptr = base_conversion_temp + (i * base_conversion_temp_increment);
+
             // Step 3: fast floor from q U {Bsk} to Bsk 
-            base_converter_.fast_floor(tmp_coeff_bsk_together.get() + (i * (encrypted_ptr_increment + encrypted_bsk_ptr_increment)), 
-                tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), pool);
+            base_converter_->fast_floor(tmp_coeff_bsk_together + (i * (encrypted_ptr_increment + encrypted_bsk_ptr_increment)), 
+                tmp_result_bsk + (i * encrypted_bsk_ptr_increment), temp_ptr);
 
             // Step 4: fast base convert from Bsk to q
-            base_converter_.fastbconv_sk(tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), encrypted1.mutable_pointer(i), pool);
-        }
+            uint64_t *destination_ptr = (i == dest_count - 1) ? destination_last : destination + (i * encrypted_ptr_increment);
+            base_converter_->fastbconv_sk(tmp_result_bsk + (i * encrypted_bsk_ptr_increment), destination_ptr, 
+                temp_ptr);
+        });
     }
 
     void Evaluator::square(Ciphertext &encrypted, const MemoryPoolHandle &pool)
@@ -724,6 +1026,14 @@ namespace seal
         // Determine destination_array.size()
         int dest_count = (encrypted_size << 1) - 1;
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->square(encrypted, pool);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
@@ -737,6 +1047,19 @@ namespace seal
         // Prepare destination
         encrypted.resize(parms_, dest_count);
 
+        // Base conversion needs the input in coefficient form; an NTT form input is transformed 
+        // to a temporary copy, and its NTT form is used directly below
+        Pointer encrypted_coeff_form;
+        const uint64_t *encrypted_coeff_ptr = encrypted.pointer();
+        if (encrypted.is_ntt_form_)
+        {
+            encrypted_coeff_form = allocate_poly(coeff_count * encrypted_size, coeff_mod_count, pool);
+            set_poly_poly(encrypted.pointer(), coeff_count * encrypted_size, coeff_mod_count, encrypted_coeff_form.get());
+            inverse_ntt_negacyclic_harvey(encrypted_coeff_form.get(), coeff_count, coeff_mod_count, 
+                coeff_small_ntt_tables_->data(), encrypted_size);
+            encrypted_coeff_ptr = encrypted_coeff_form.get();
+        }
+
         // Make temp poly for FastBConverter result from q ---> Bsk U {m_tilde}
         Pointer tmp_encrypted_bsk_mtilde(allocate_poly(coeff_count * encrypted_size, bsk_mtilde_count, pool));
 
@@ -748,9 +1071,9 @@ namespace seal
         // Iterate over all the ciphertexts inside encrypted1
         for (int i = 0; i < encrypted_size; i++)
         {
-            base_converter_.fastbconv_mtilde(encrypted.pointer(i),
+            base_converter_->fastbconv_mtilde(encrypted_coeff_ptr + (i * encrypted_ptr_increment),
                 tmp_encrypted_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment), pool);
-            base_converter_.mont_rq(tmp_encrypted_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment),
+            base_converter_->mont_rq(tmp_encrypted_bsk_mtilde.get() + (i * encrypted_bsk_mtilde_ptr_increment),
                 tmp_encrypted_bsk.get() + (i * encrypted_bsk_ptr_increment));
         }
 
@@ -770,17 +1093,14 @@ namespace seal
         Pointer copy_encrypted_ntt_bsk_base_mod(allocate_poly(coeff_count * encrypted_size, bsk_base_mod_count_, pool));
         set_poly_poly(tmp_encrypted_bsk.get(), coeff_count * encrypted_size, bsk_base_mod_count_, copy_encrypted_ntt_bsk_base_mod.get());
 
-        for (int i = 0; i < encrypted_size; i++)
+        // Lazy reduction
+        if (!encrypted.is_ntt_form_)
         {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                ntt_negacyclic_harvey_lazy(copy_encrypted_ntt_coeff_mod.get() + (j * coeff_count) + (i * encrypted_ptr_increment), coeff_small_ntt_tables_[j]);
-            }
-            for (int j = 0; j < bsk_base_mod_count_; j++)
-            {
-                ntt_negacyclic_harvey_lazy(copy_encrypted_ntt_bsk_base_mod.get() + (j * coeff_count) + (i * encrypted_bsk_ptr_increment), bsk_small_ntt_tables_[j]);
-            }
+            ntt_negacyclic_harvey_lazy(copy_encrypted_ntt_coeff_mod.get(), coeff_count, coeff_mod_count,
+                coeff_small_ntt_tables_->data(), encrypted_size);
         }
+        ntt_negacyclic_harvey_lazy(copy_encrypted_ntt_bsk_base_mod.get(), coeff_count, bsk_base_mod_count_,
+            bsk_small_ntt_tables_->data(), encrypted_size);
 
         // Perform fast squaring
         // Compute c0^2 in base q
@@ -838,18 +1158,10 @@ namespace seal
         }
 
         // Convert back outputs from NTT form
-        for (int i = 0; i < dest_count; i++)
-        {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                inverse_ntt_negacyclic_harvey_lazy(tmp_des_coeff_base.get() + (i * (encrypted_ptr_increment)) + (j * coeff_count),
-                    coeff_small_ntt_tables_[j]);
-            }
-            for (int j = 0; j < bsk_base_mod_count_; j++)
-            {
-                inverse_ntt_negacyclic_harvey_lazy(tmp_des_bsk_base.get() + (i * (encrypted_bsk_ptr_increment)) + (j * coeff_count), bsk_small_ntt_tables_[j]);
-            }
-        }
+        inverse_ntt_negacyclic_harvey_lazy(tmp_des_coeff_base.get(), coeff_count, coeff_mod_count,
+            coeff_small_ntt_tables_->data(), dest_count);
+        inverse_ntt_negacyclic_harvey_lazy(tmp_des_bsk_base.get(), coeff_count, bsk_base_mod_count_,
+            bsk_small_ntt_tables_->data(), dest_count);
 
         // Now we multiply plain modulus to both results in base q and Bsk and allocate them together in one 
         // container as (te0)q(te'0)Bsk | ... |te count)q (te' count)Bsk to make it ready for fast_floor 
@@ -879,19 +1191,150 @@ namespace seal
         for (int i = 0; i < dest_count; i++)
         {
             // Step 3: fast floor from q U {Bsk} to Bsk 
-            base_converter_.fast_floor(tmp_coeff_bsk_together.get() + (i * (encrypted_ptr_increment + encrypted_bsk_ptr_increment)),
+            base_converter_->fast_floor(tmp_coeff_bsk_together.get() + (i * (encrypted_ptr_increment + encrypted_bsk_ptr_increment)),
                 tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), pool);
 
             // Step 4: fast base convert from Bsk to q
-            base_converter_.fastbconv_sk(tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), encrypted.mutable_pointer(i), pool);
+            base_converter_->fastbconv_sk(tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), encrypted.mutable_pointer(i), pool);
+        }
+
+        // The square is returned in the form of encrypted
+        if (encrypted.is_ntt_form_)
+        {
+            ntt_negacyclic_harvey(encrypted.mutable_pointer(), coeff_count, coeff_mod_count, 
+                coeff_small_ntt_tables_->data(), dest_count);
+        }
+    }
+
+    void Evaluator::mod_switch_to_next(Ciphertext &encrypted, const MemoryPoolHandle &pool)
+    {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int next_coeff_mod_count = coeff_modulus_.size() - 1;
+        int encrypted_size = encrypted.size();
+
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->mod_switch_to_next(encrypted, pool);
+            return;
+        }
+
+        // Verify parameters.
+        if (encrypted.hash_block_ != parms_.hash_block())
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        Evaluator *next_evaluator = this->next_evaluator();
+        if (!next_evaluator)
+        {
+            throw invalid_argument("encrypted is already at the last level");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // The new limbs of each poly are moved to their place in the compacted ciphertext, 
+        // in place of old limbs that have already been used
+        Pointer temp(allocate_poly(coeff_count, next_coeff_mod_count, pool));
+        int next_poly_uint64_count = coeff_count * next_coeff_mod_count;
+        for (int i = 0; i < encrypted_size; i++)
+        {
+            uint64_t *encrypted_ptr = encrypted.mutable_pointer(i);
+            divide_round_by_last(encrypted_ptr, next_coeff_mod_count + 1, encrypted.is_ntt_form_, 
+                inv_last_coeff_mod_coeff_array_.data(), temp.get());
+            copy(encrypted_ptr, encrypted_ptr + next_poly_uint64_count, 
+                encrypted.mutable_pointer() + (i * next_poly_uint64_count));
+        }
+
+        // The ciphertext moves to the next level without reallocation
+        encrypted.resize(next_evaluator->parms_, encrypted_size);
+    }
+
+    void Evaluator::divide_round_by_last(uint64_t *poly, int limb_count, bool is_ntt_form, 
+        const uint64_t *inv_last_mod, uint64_t *temp)
+    {
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int next_limb_count = limb_count - 1;
+
+        /*
+        The poly c is replaced by (c - r) / q, where q is the last prime and r is the remainder 
+        of c modulo q in [-q/2, q/2); this is c / q rounded to the nearest integer. The remainder 
+        is computed from the last limb in coefficient form as ((c + floor(q/2)) mod q) - floor(q/2) 
+        and reduced modulo each of the other primes, where the division is a multiplication by 
+        the inverse of q.
+        */
+        const SmallModulus &last_modulus = key_coeff_modulus_[next_limb_count];
+        uint64_t half = last_modulus.value() >> 1;
+        uint64_t *last_ptr = poly + (next_limb_count * coeff_count);
+        if (is_ntt_form)
+        {
+            inverse_ntt_negacyclic_harvey(last_ptr, (*key_small_ntt_tables_)[next_limb_count]);
+        }
+        for (int m = 0; m < coeff_count - 1; m++)
+        {
+            last_ptr[m] = add_uint_uint_mod(last_ptr[m], half, last_modulus);
+        }
+
+        parallel_for(next_limb_count, [&](int j)
+        {
+            const SmallModulus &modulus = key_coeff_modulus_[j];
+            uint64_t half_mod = half % modulus.value();
+            uint64_t *remainder_ptr = temp + (j * coeff_count);
+            reduce_poly_coeffs_barrett(last_ptr, coeff_count - 1, modulus, remainder_ptr);
+            for (int m = 0; m < coeff_count - 1; m++)
+            {
+                remainder_ptr[m] = sub_uint_uint_mod(remainder_ptr[m], half_mod, modulus);
+            }
+            remainder_ptr[coeff_count - 1] = 0;
+            if (is_ntt_form)
+            {
+                ntt_negacyclic_harvey(remainder_ptr, (*key_small_ntt_tables_)[j]);
+            }
+            uint64_t *poly_ptr = poly + (j * coeff_count);
+            sub_poly_poly_coeffmod(poly_ptr, remainder_ptr, coeff_count, modulus, poly_ptr);
+            multiply_poly_scalar_coeffmod(poly_ptr, coeff_count, inv_last_mod[j], modulus, poly_ptr);
+        });
+    }
+
+    void Evaluator::divide_round_by_special_primes(uint64_t *poly, uint64_t *temp)
+    {
+        int coeff_mod_count = coeff_modulus_.size();
+        for (int t = key_coeff_modulus_.size() - 1; t >= coeff_mod_count; t--)
+        {
+            divide_round_by_last(poly, t + 1, true, inv_special_primes_mod_coeff_[t - coeff_mod_count].data(), temp);
+        }
+    }
+
+    void Evaluator::relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, int destination_size, 
+        const MemoryPoolHandle &pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
         }
+
+        // Temporaries are allocated from pool as they are needed
+        EvaluatorWorkspace workspace(parms_.hash_block(), pool);
+        relinearize(encrypted, evaluation_keys, destination_size, workspace);
     }
 
-    void Evaluator::relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, int destination_size, const MemoryPoolHandle &pool)
+    void Evaluator::relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, int destination_size, 
+        EvaluatorWorkspace &workspace)
     {
         // Extract encryption parameters.
         int encrypted_size = encrypted.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->relinearize(encrypted, evaluation_keys, destination_size, workspace);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
@@ -901,7 +1344,7 @@ namespace seal
         {
             throw invalid_argument("destination_size must be greater than or equal to 2 and less than or equal to current count");
         }
-        if (evaluation_keys.hash_block() != parms_.hash_block())
+        if (evaluation_keys.hash_block() != key_hash_block_)
         {
             throw invalid_argument("evaluation_keys is not valid for encryption parameters");
         }
@@ -909,9 +1352,9 @@ namespace seal
         {
             throw invalid_argument("not enough evaluation keys");
         }
-        if (!pool)
+        if (!is_valid_workspace(workspace))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("workspace is not valid for encryption parameters");
         }
 
         // If encrypted is already at the desired level, return
@@ -926,7 +1369,10 @@ namespace seal
         // Update temp to store the current result after relinearization
         for (int i = 0; i < relins_needed; i++)
         {
-            relinearize_one_step(encrypted.mutable_pointer(), encrypted_size, evaluation_keys, pool);
+            // Each step reuses the temporaries of the previous one
+            workspace.reset();
+            relinearize_one_step(encrypted.mutable_pointer(), encrypted_size, encrypted.is_ntt_form_, evaluation_keys, 
+                workspace);
             encrypted_size--;
         }
 
@@ -935,7 +1381,102 @@ namespace seal
         encrypted.resize(parms_, destination_size);
     }
 
-    void Evaluator::relinearize_one_step(uint64_t *encrypted, int encrypted_size, const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool)
+    void Evaluator::multiply_relinearize(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+        const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Temporaries are allocated from pool as they are needed
+        EvaluatorWorkspace workspace(parms_.hash_block(), pool);
+        multiply_relinearize(encrypted1, encrypted2, evaluation_keys, workspace);
+    }
+
+    void Evaluator::multiply_relinearize(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+        const EvaluationKeys &evaluation_keys, EvaluatorWorkspace &workspace)
+    {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int encrypted1_size = encrypted1.size();
+        int encrypted2_size = encrypted2.size();
+
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted1.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->multiply_relinearize(encrypted1, encrypted2, evaluation_keys, workspace);
+            return;
+        }
+
+        // Verify parameters.
+        if (encrypted1.hash_block_ != parms_.hash_block())
+        {
+            throw invalid_argument("encrypted1 is not valid for encryption parameters");
+        }
+        if (encrypted2.hash_block_ != parms_.hash_block())
+        {
+            throw invalid_argument("encrypted2 is not valid for encryption parameters");
+        }
+        if (evaluation_keys.hash_block() != key_hash_block_)
+        {
+            throw invalid_argument("evaluation_keys is not valid for encryption parameters");
+        }
+        if (evaluation_keys.size() < encrypted1_size + encrypted2_size - 3)
+        {
+            throw invalid_argument("not enough evaluation keys");
+        }
+        if (!is_valid_workspace(workspace))
+        {
+            throw invalid_argument("workspace is not valid for encryption parameters");
+        }
+
+        // Only the product of two size 2 ciphertexts is fused
+        if (encrypted1_size != 2 || encrypted2_size != 2)
+        {
+            multiply(encrypted1, encrypted2, workspace);
+            relinearize(encrypted1, evaluation_keys, workspace);
+            return;
+        }
+        workspace.reset();
+
+        // The first two components of the product are written directly to encrypted1, 
+        // and the third one only to a temporary poly in coefficient form as needed by 
+        // the decomposition
+        uint64_t *encrypted_last = workspace.get_poly(coeff_count, coeff_mod_count);
+        multiply_behz(encrypted1.pointer(), 2, encrypted1.is_ntt_form_, encrypted2.pointer(), 
+            2, encrypted2.is_ntt_form_, encrypted1.mutable_pointer(), encrypted_last, workspace);
+
+        // Key switching result in NTT form
+        uint64_t *innerresult = workspace.get_poly(2 * coeff_count, coeff_mod_count);
+        switch_key_ntt(encrypted_last, evaluation_keys.data()[0], evaluation_keys.decomposition_bit_count(), 
+            innerresult, workspace);
+
+        // Add the key switching result in the form of encrypted1; in NTT form only the
+        // first two components are transformed and no inverse transforms are needed
+        bool is_ntt_form = encrypted1.is_ntt_form_;
+        uint64_t *encrypted_ptr = encrypted1.mutable_pointer();
+        parallel_for(2 * coeff_mod_count, [&](int index)
+        {
+            int i = index % coeff_mod_count;
+            int offset = index * coeff_count;
+            if (is_ntt_form)
+            {
+                ntt_negacyclic_harvey(encrypted_ptr + offset, coeff_count, 1, coeff_small_ntt_tables_->data() + i);
+            }
+            else
+            {
+                inverse_ntt_negacyclic_harvey(innerresult + offset, coeff_count, 1, coeff_small_ntt_tables_->data() + i);
+            }
+            add_poly_poly_coeffmod(encrypted_ptr + offset, innerresult + offset, coeff_count, coeff_modulus_[i], 
+                encrypted_ptr + offset);
+        });
+    }
+
+    void Evaluator::relinearize_one_step(uint64_t *encrypted, int encrypted_size, bool is_ntt_form, 
+        const EvaluationKeys &evaluation_keys, EvaluatorWorkspace &workspace)
     {
 #ifdef SEAL_DEBUG
         if (encrypted == nullptr)
@@ -946,7 +1487,7 @@ namespace seal
         {
             throw invalid_argument("encrypted_size must be at least 3");
         }
-        if (evaluation_keys.hash_block() != parms_.hash_block())
+        if (evaluation_keys.hash_block() != key_hash_block_)
         {
             throw invalid_argument("evaluation_keys is not valid for encryption parameters");
         }
@@ -954,121 +1495,234 @@ namespace seal
         {
             throw invalid_argument("not enough evaluation keys");
         }
-        if (!pool)
-        {
-            throw invalid_argument("pool is uninitialized");
-        }
 #endif
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = coeff_modulus_.size();
         int array_poly_uint64_count = coeff_count * coeff_mod_count;
 
         const uint64_t *encrypted_coeff = encrypted + (encrypted_size - 1) * array_poly_uint64_count;
-        Pointer encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
 
-        // Decompose encrypted_array[count-1] into base w
-        // Want to create an array of polys, each of whose components i is (encrypted_array[count-1])^(i) - in the notation of FV paper
-        // This allocation stores one of the decomposed factors modulo one of the primes
-        Pointer decomp_encrypted_last(allocate_uint(coeff_count, pool));
+        // Decomposition needs the last component in coefficient form; the key switching 
+        // result is computed in the NTT domain and added to encrypted in its own form
+        uint64_t *encrypted_last_coeff_form = nullptr;
+        if (is_ntt_form)
+        {
+            encrypted_last_coeff_form = workspace.get_poly(coeff_count, coeff_mod_count);
+            parallel_for(coeff_mod_count, [&](int i)
+            {
+                int offset = i * coeff_count;
+                set_uint_uint(encrypted_coeff + offset, coeff_count, encrypted_last_coeff_form + offset);
+                inverse_ntt_negacyclic_harvey(encrypted_last_coeff_form + offset, coeff_count, 1, 
+                    coeff_small_ntt_tables_->data() + i);
+            });
+            encrypted_coeff = encrypted_last_coeff_form;
+        }
+
+        // Key switching result in NTT form
+        uint64_t *innerresult = workspace.get_poly(2 * coeff_count, coeff_mod_count);
+        // The last component multiplies s^(encrypted_size - 1), whose key has index encrypted_size - 3
+        switch_key_ntt(encrypted_coeff, evaluation_keys.data()[encrypted_size - 3], 
+            evaluation_keys.decomposition_bit_count(), innerresult, workspace);
+
+        parallel_for(2 * coeff_mod_count, [&](int index)
+        {
+            int i = index % coeff_mod_count;
+            int offset = index * coeff_count;
+            if (!is_ntt_form)
+            {
+                inverse_ntt_negacyclic_harvey(innerresult + offset, coeff_count, 1, coeff_small_ntt_tables_->data() + i);
+            }
+            add_poly_poly_coeffmod(encrypted + offset, innerresult + offset, coeff_count, coeff_modulus_[i], 
+                encrypted + offset);
+        });
+    }
+
+    void Evaluator::switch_key_ntt(const uint64_t *encrypted_last, const vector<Ciphertext> &key, 
+        int decomposition_bit_count, uint64_t *destination, EvaluatorWorkspace &workspace)
+    {
+        // Keys with a decomposition bit count of 0 use RNS digits
+        if (decomposition_bit_count == 0)
+        {
+            switch_key_rns_ntt(encrypted_last, key, destination, workspace);
+            return;
+        }
+
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int array_poly_uint64_count = coeff_count * coeff_mod_count;
+
+        uint64_t *encrypted_coeff_prod_inv_coeff = workspace.get_poly(coeff_count, coeff_mod_count);
+        parallel_for(coeff_mod_count, [&](int i)
+        {
+            multiply_poly_scalar_coeffmod(encrypted_last + (i * coeff_count), coeff_count, 
+                key_switch_factors_[i], coeff_modulus_[i], 
+                encrypted_coeff_prod_inv_coeff + (i * coeff_count));
+        });
 
         // Lazy reduction   
-        Pointer wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        Pointer wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        Pointer innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        Pointer temp_decomp_coeff(allocate_uint(coeff_count, pool));
+        uint64_t *wide_innerresult0 = workspace.get_poly(coeff_count, 2 * coeff_mod_count);
+        uint64_t *wide_innerresult1 = workspace.get_poly(coeff_count, 2 * coeff_mod_count);
+
+        // Decompose encrypted_array[count-1] into base w
+        // Want to create an array of polys, each of whose components i is (encrypted_array[count-1])^(i) - in the notation of FV paper
+        // This allocation stores one of the decomposed factors modulo one of the primes, for each of the primes
+        uint64_t *temp_decomp_coeff = workspace.get_poly(coeff_count, coeff_mod_count);
 
         /*
         For lazy reduction to work here, we need to ensure that the 128-bit accumulators (wide_innerresult0 and wide_innerresult1)
         do not overflow. Since the modulus primes are at most 60 bits, if the total number of summands is K, then the size of the
         total sum of products (without reduction) is at most 62 + 60 + bit_length(K). We need this to be at most 128, thus we need
-        bit_length(K) <= 6. Thus, we need K <= 63. In this case, this means sum_i evaluation_keys.data()[0][i].size() / 2 <= 63.
+        bit_length(K) <= 6. Thus, we need K <= 63. In this case, this means sum_i key[i].size() / 2 <= 63.
+
+        The accumulators of each prime j are independent, so the work is split by j; each task 
+        decomposes every prime i of encrypted_last and sums up the products modulo its own prime.
         */
-        for (int i = 0; i < coeff_mod_count; i++)
+        parallel_for(coeff_mod_count, [&](int j)
         {
-            multiply_poly_scalar_coeffmod(encrypted_coeff + (i * coeff_count), coeff_count, 
-                inv_coeff_products_mod_coeff_array_[i], coeff_modulus_[i], encrypted_coeff_prod_inv_coeff.get());
+            uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff + (j * coeff_count);
+            uint64_t *wide_innerresult0_start = wide_innerresult0 + (j * 2 * coeff_count);
+            uint64_t *wide_innerresult1_start = wide_innerresult1 + (j * 2 * coeff_count);
+            set_zero_uint(2 * coeff_count, wide_innerresult0_start);
+            set_zero_uint(2 * coeff_count, wide_innerresult1_start);
 
-            int shift = 0;
-            const Ciphertext &key_component_ref = evaluation_keys.data()[0][i];
-            int keys_size = key_component_ref.size();
-            for (int k = 0; k < keys_size; k += 2)
+            for (int i = 0; i < coeff_mod_count; i++)
             {
-                const uint64_t *key_ptr_0 = key_component_ref.pointer(k);
-                const uint64_t *key_ptr_1 = key_component_ref.pointer(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = evaluation_keys.decomposition_bit_count();
-                for (int coeff_index = 0; coeff_index < coeff_count; coeff_index++)
+                const uint64_t *encrypted_coeff_ptr = encrypted_coeff_prod_inv_coeff + (i * coeff_count);
+                int shift = 0;
+                const Ciphertext &key_component_ref = key[i];
+                int keys_size = key_component_ref.size();
+                for (int k = 0; k < keys_size; k += 2)
                 {
-                    decomp_encrypted_last[coeff_index] = encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= (1ULL << decomposition_bit_count) - 1;
-                }
+                    const uint64_t *key_ptr_0 = key_component_ref.pointer(k) + (j * coeff_count);
+                    const uint64_t *key_ptr_1 = key_component_ref.pointer(k + 1) + (j * coeff_count);
 
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (int j = 0; j < coeff_mod_count; j++)
-                {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
+                    // Decompose here
+                    for (int coeff_index = 0; coeff_index < coeff_count; coeff_index++)
+                    {
+                        temp_decomp_coeff_ptr[coeff_index] = encrypted_coeff_ptr[coeff_index] >> shift;
+                        temp_decomp_coeff_ptr[coeff_index] &= (1ULL << decomposition_bit_count) - 1;
+                    }
 
                     // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables_[j]);
+                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, (*coeff_small_ntt_tables_)[j]);
 
                     // Lazy reduction
                     uint64_t wide_innerproduct[2];
-                    for (int m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
+                    uint64_t *wide_innerresult0_ptr = wide_innerresult0_start;
+                    uint64_t *wide_innerresult1_ptr = wide_innerresult1_start;
+                    for (int m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2, wide_innerresult1_ptr += 2)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
+                        multiply_uint64(temp_decomp_coeff_ptr[m], key_ptr_0[m], wide_innerproduct);
                         unsigned char carry = add_uint64(wide_innerresult0_ptr[0], wide_innerproduct[0], 0,
                             wide_innerresult0_ptr);
                         wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
-                    }
 
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (int m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0], wide_innerproduct[0], 0,
+                        multiply_uint64(temp_decomp_coeff_ptr[m], key_ptr_1[m], wide_innerproduct);
+                        carry = add_uint64(wide_innerresult1_ptr[0], wide_innerproduct[0], 0,
                             wide_innerresult1_ptr);
                         wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
                     }
+                    shift += decomposition_bit_count;
                 }
-                shift += decomposition_bit_count;
             }
+
+            uint64_t *destination0_ptr = destination + (j * coeff_count);
+            uint64_t *destination1_ptr = destination0_ptr + array_poly_uint64_count;
+            for (int m = 0; m < coeff_count; m++)
+            {
+                destination0_ptr[m] = barrett_reduce_128(wide_innerresult0_start + (2 * m), coeff_modulus_[j]);
+                destination1_ptr[m] = barrett_reduce_128(wide_innerresult1_start + (2 * m), coeff_modulus_[j]);
+            }
+        });
+    }
+
+    void Evaluator::switch_key_rns_ntt(const uint64_t *encrypted_last, const vector<Ciphertext> &key, 
+        uint64_t *destination, EvaluatorWorkspace &workspace)
+    {
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int key_mod_count = key_coeff_modulus_.size();
+        int key_poly_uint64_count = coeff_count * key_mod_count;
+
+        /*
+        The digits are the residues c_i of encrypted_last times the inverse of the product of 
+        the other primes of the current level modulo q_i, so that their sum weighted by those 
+        products is encrypted_last modulo the primes of the current level. The key for prime i 
+        encrypts the product of all primes of the top level but q_i, which is that weight times 
+        the product P of the primes above the current level; the sum of the digits times the keys, 
+        computed modulo all primes of the top level, therefore encrypts P times encrypted_last, 
+        and is divided by P with rounding afterwards. At the top level P is 1.
+        */
+        uint64_t *digits = workspace.get_poly(coeff_count, coeff_mod_count);
+        parallel_for(coeff_mod_count, [&](int i)
+        {
+            multiply_poly_scalar_coeffmod(encrypted_last + (i * coeff_count), coeff_count, 
+                inv_coeff_products_mod_coeff_array_[i], coeff_modulus_[i], digits + (i * coeff_count));
+        });
+
+        uint64_t *switched = destination;
+        if (key_mod_count > coeff_mod_count)
+        {
+            switched = workspace.get_poly(2 * coeff_count, key_mod_count);
         }
+        uint64_t *temp_digit = workspace.get_poly(coeff_count, key_mod_count);
+        uint64_t *wide_innerresult = workspace.get_poly(coeff_count, 4 * key_mod_count);
 
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted;
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (int i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        // Each digit is extended to every prime of the keys and multiplied with lazy reduction; 
+        // there are at most 63 summands as in switch_key_ntt
+        parallel_for(key_mod_count, [&](int j)
         {
-            for (int m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            const SmallModulus &modulus = key_coeff_modulus_[j];
+            uint64_t *temp_digit_ptr = temp_digit + (j * coeff_count);
+            uint64_t *wide_innerresult0_start = wide_innerresult + (j * 4 * coeff_count);
+            uint64_t *wide_innerresult1_start = wide_innerresult0_start + (2 * coeff_count);
+            set_zero_uint(4 * coeff_count, wide_innerresult0_start);
+
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                reduce_poly_coeffs_barrett(digits + (i * coeff_count), coeff_count, modulus, temp_digit_ptr);
+
+                // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
+                ntt_negacyclic_harvey_lazy(temp_digit_ptr, (*key_small_ntt_tables_)[j]);
+
+                const uint64_t *key_ptr_0 = key[i].pointer(0) + (j * coeff_count);
+                const uint64_t *key_ptr_1 = key[i].pointer(1) + (j * coeff_count);
+                uint64_t wide_innerproduct[2];
+                uint64_t *wide_innerresult0_ptr = wide_innerresult0_start;
+                uint64_t *wide_innerresult1_ptr = wide_innerresult1_start;
+                for (int m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2, wide_innerresult1_ptr += 2)
+                {
+                    multiply_uint64(temp_digit_ptr[m], key_ptr_0[m], wide_innerproduct);
+                    unsigned char carry = add_uint64(wide_innerresult0_ptr[0], wide_innerproduct[0], 0,
+                        wide_innerresult0_ptr);
+                    wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+
+                    multiply_uint64(temp_digit_ptr[m], key_ptr_1[m], wide_innerproduct);
+                    carry = add_uint64(wide_innerresult1_ptr[0], wide_innerproduct[0], 0,
+                        wide_innerresult1_ptr);
+                    wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                }
+            }
+
+            uint64_t *switched0_ptr = switched + (j * coeff_count);
+            uint64_t *switched1_ptr = switched0_ptr + key_poly_uint64_count;
+            for (int m = 0; m < coeff_count; m++)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(wide_innerresult_coeff_ptr, coeff_modulus_[i]);
+                switched0_ptr[m] = barrett_reduce_128(wide_innerresult0_start + (2 * m), modulus);
+                switched1_ptr[m] = barrett_reduce_128(wide_innerresult1_start + (2 * m), modulus);
             }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables_[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus_[i], encrypted_ptr);
-        }
+        });
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted + array_poly_uint64_count;
-        innerresult_coeff_ptr = innerresult_poly_ptr;
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (int i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        if (key_mod_count > coeff_mod_count)
         {
-            for (int m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            // The temporary digits are no longer needed
+            for (int k = 0; k < 2; k++)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(wide_innerresult_coeff_ptr, coeff_modulus_[i]);
+                uint64_t *switched_ptr = switched + (k * key_poly_uint64_count);
+                divide_round_by_special_primes(switched_ptr, temp_digit);
+                set_uint_uint(switched_ptr, coeff_count * coeff_mod_count, 
+                    destination + (k * coeff_count * coeff_mod_count));
             }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables_[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus_[i], encrypted_ptr);
         }
     }
 
@@ -1084,6 +1738,14 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypteds[0].hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->multiply_many(encrypteds, evaluation_keys, destination, pool);
+            return;
+        }
+
         // If there is only one ciphertext, return it after checking validity.
         if (encrypteds.size() == 1)
         {
@@ -1120,43 +1782,230 @@ namespace seal
         destination = encrypteds[encrypteds.size() - 1];
     }
 
-    void Evaluator::exponentiate(Ciphertext &encrypted, uint64_t exponent, const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool)
+    void Evaluator::multiply_many_parallel(const vector<Ciphertext> &encrypteds, const EvaluationKeys &evaluation_keys, 
+        Ciphertext &destination, int lazy_relin_levels)
     {
         // Verify parameters.
-        if (encrypted.hash_block_ != parms_.hash_block())
+        if (encrypteds.empty())
         {
-            throw invalid_argument("encrypted is not valid for encryption parameters");
+            throw invalid_argument("encrypteds vector must not be empty");
         }
-        if (exponent == 0)
+        if (lazy_relin_levels < 0)
         {
-            throw invalid_argument("exponent cannot be 0");
+            throw invalid_argument("lazy_relin_levels cannot be negative");
         }
-        if (!pool)
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypteds[0].hash_block_ != parms_.hash_block() && next_evaluator())
         {
-            throw invalid_argument("pool is uninitialized");
+            next_evaluator()->multiply_many_parallel(encrypteds, evaluation_keys, destination, lazy_relin_levels);
+            return;
         }
 
-        if (exponent == 1)
+        for (const Ciphertext &encrypted : encrypteds)
         {
-            return;
+            if (encrypted.hash_block_ != parms_.hash_block())
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+        }
+        if (evaluation_keys.hash_block() != key_hash_block_)
+        {
+            throw invalid_argument("evaluation_keys is not valid for encryption parameters");
         }
 
-        // Create a vector of aliased ciphertexts
-        vector<Ciphertext> exp_vector(exponent, Ciphertext(parms_, encrypted.size(), encrypted.mutable_pointer()));
-        multiply_many(exp_vector, evaluation_keys, encrypted, pool);
-    }
+        // Number of levels in the product tree
+        int level_count = 0;
+        for (size_t count = encrypteds.size(); count > 1; count = (count + 1) / 2)
+        {
+            level_count++;
+        }
+        lazy_relin_levels = min(lazy_relin_levels, level_count);
 
-    void Evaluator::add_plain(Ciphertext &encrypted, const Plaintext &plain)
+        // The workers are tasks on the thread pool, and each allocates from its own memory
+        // pool. The pools are not thread-safe, so products are created and destroyed only in
+        // this thread, and each product is always computed by the worker owning its pool.
+        int worker_count = max(min(thread_count(), static_cast<int>(encrypteds.size() / 2)), 1);
+        vector<MemoryPoolHandle> worker_pools;
+        for (int i = 0; i < worker_count; i++)
+        {
+            worker_pools.emplace_back(MemoryPoolHandle::New(false));
+        }
+
+        // The operands of each level point to the inputs or to the products of the level 
+        // below; all products are kept until the end
+        vector<const Ciphertext*> operands;
+        for (const Ciphertext &encrypted : encrypteds)
+        {
+            operands.push_back(&encrypted);
+        }
+        vector<vector<Ciphertext> > levels(level_count);
+
+        for (int level = 0; level < level_count; level++)
+        {
+            // Products of the top lazy_relin_levels levels are not relinearized
+            bool relinearize_level = level < level_count - lazy_relin_levels;
+            int pair_count = static_cast<int>(operands.size() / 2);
+            vector<Ciphertext> &products = levels[level];
+            for (int i = 0; i < pair_count; i++)
+            {
+                products.emplace_back(worker_pools[i % worker_count]);
+            }
+
+            // Worker w computes pairs w, w + worker_count, ... so the work split is deterministic
+            auto worker = [&](int worker_index)
+            {
+                const MemoryPoolHandle &pool = worker_pools[worker_index];
+                for (int i = worker_index; i < pair_count; i += worker_count)
+                {
+                    products[i] = *operands[2 * i];
+                    multiply(products[i], *operands[2 * i + 1], pool);
+                    if (relinearize_level)
+                    {
+                        relinearize(products[i], evaluation_keys, pool);
+                    }
+                }
+            };
+            parallel_for(min(worker_count, pair_count), worker);
+
+            // An unpaired last operand moves up to the next level as it is
+            const Ciphertext *unpaired = (operands.size() % 2) ? operands.back() : nullptr;
+            operands.clear();
+            for (const Ciphertext &product : products)
+            {
+                operands.push_back(&product);
+            }
+            if (unpaired)
+            {
+                operands.push_back(unpaired);
+            }
+        }
+
+        destination = *operands[0];
+        if (lazy_relin_levels > 0)
+        {
+            relinearize(destination, evaluation_keys, pool_);
+        }
+    }
+
+    void Evaluator::dot_product(const vector<Ciphertext> &encrypteds1, const vector<Ciphertext> &encrypteds2, 
+        const EvaluationKeys &evaluation_keys, Ciphertext &destination, const MemoryPoolHandle &pool)
+    {
+        // Verify parameters.
+        if (encrypteds1.empty())
+        {
+            throw invalid_argument("encrypteds1 cannot be empty");
+        }
+        if (encrypteds1.size() != encrypteds2.size())
+        {
+            throw invalid_argument("encrypteds1 and encrypteds2 must have the same size");
+        }
+        if (evaluation_keys.hash_block() != key_hash_block_)
+        {
+            throw invalid_argument("evaluation_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // The products are summed up unrelinearized; add handles the size differences
+        Ciphertext sum(parms_, pool);
+        Ciphertext product(parms_, pool);
+        multiply(encrypteds1[0], encrypteds2[0], sum, pool);
+        for (size_t i = 1; i < encrypteds1.size(); i++)
+        {
+            multiply(encrypteds1[i], encrypteds2[i], product, pool);
+            add(sum, product);
+        }
+
+        // Relinearize only once
+        relinearize(sum, evaluation_keys, pool);
+        destination = sum;
+    }
+
+    void Evaluator::exponentiate(Ciphertext &encrypted, uint64_t exponent, const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool)
+    {
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->exponentiate(encrypted, exponent, evaluation_keys, pool);
+            return;
+        }
+
+        // Verify parameters.
+        if (encrypted.hash_block_ != parms_.hash_block())
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (exponent == 0)
+        {
+            throw invalid_argument("exponent cannot be 0");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        if (exponent == 1)
+        {
+            return;
+        }
+
+        // Square repeatedly to find encrypted^(2^i) for every bit i set in exponent, and multiply
+        // the powers into the result in order of increasing i. Each product then has depth one
+        // more than its newest power, so the result has depth ceil(log2(exponent)), using
+        // floor(log2(exponent)) squarings and one fewer multiplications than there are bits set.
+        Ciphertext power(encrypted);
+        bool result_set = (exponent & 1) != 0;
+        for (exponent >>= 1; exponent > 0; exponent >>= 1)
+        {
+            square(power, pool);
+            relinearize(power, evaluation_keys, pool);
+            if (!(exponent & 1))
+            {
+                continue;
+            }
+            if (result_set)
+            {
+                multiply_relinearize(encrypted, power, evaluation_keys, pool);
+            }
+            else
+            {
+                encrypted = power;
+                result_set = true;
+            }
+        }
+    }
+
+    void Evaluator::add_plain(Ciphertext &encrypted, const Plaintext &plain)
     {
         // Extract encryption parameters.
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = coeff_modulus_.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->add_plain(encrypted, plain);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
+        if (encrypted.is_ntt_form_)
+        {
+            throw invalid_argument("encrypted cannot be in NTT form");
+        }
+        if (plain.is_ntt_form_)
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
         if (plain.coeff_count() > coeff_count || (plain.coeff_count() == coeff_count && plain[coeff_count - 1] != 0))
         {
             throw invalid_argument("plain is not valid for encryption parameters");
@@ -1201,11 +2050,27 @@ namespace seal
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = coeff_modulus_.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->sub_plain(encrypted, plain);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
+        if (encrypted.is_ntt_form_)
+        {
+            throw invalid_argument("encrypted cannot be in NTT form");
+        }
+        if (plain.is_ntt_form_)
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
         if (plain.coeff_count() > coeff_count || (plain.coeff_count() == coeff_count && plain[coeff_count - 1] != 0))
         {
             throw invalid_argument("plain is not valid for encryption parameters");
@@ -1251,7 +2116,14 @@ namespace seal
         int coeff_mod_count = coeff_modulus_.size();
         int encrypted_size = encrypted.size();
         int plain_coeff_count = plain.coeff_count();
-        int plain_nonzero_coeff_count = plain.nonzero_coeff_count();
+
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->multiply_plain(encrypted, plain, pool);
+            return;
+        }
 
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
@@ -1264,6 +2136,35 @@ namespace seal
             throw invalid_argument("plain cannot be zero");
         }
 #endif
+
+        // Plaintexts prepared with transform_to_ntt are already lifted and transformed; one
+        // prepared at a higher level of the modulus switching chain is used through its
+        // first primes
+        if (plain.is_ntt_form_)
+        {
+            if (plain_coeff_count < coeff_count * coeff_mod_count || plain_coeff_count % coeff_count != 0)
+            {
+                throw invalid_argument("plain is not valid for encryption parameters");
+            }
+#ifdef SEAL_DEBUG
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                if (poly_infty_norm_coeffmod(plain.pointer(i * coeff_count), coeff_count, 
+                    coeff_modulus_[i]) >= coeff_modulus_[i].value())
+                {
+                    throw invalid_argument("plain is not valid for encryption parameters");
+                }
+                if (plain[coeff_count - 1 + (i * coeff_count)] != 0)
+                {
+                    throw invalid_argument("plain is not valid for encryption parameters");
+                }
+            }
+#endif
+            multiply_plain_ntt_poly(encrypted, plain.pointer());
+            return;
+        }
+
+        int plain_nonzero_coeff_count = plain.nonzero_coeff_count();
         if (plain.coeff_count() > coeff_count || (plain.coeff_count() == coeff_count && plain[coeff_count - 1] != 0))
         {
             throw invalid_argument("plain is not valid for encryption parameters");
@@ -1280,7 +2181,7 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
-        // Multiplying just by a constant?
+        // Multiplying just by a constant? This works the same in coefficient and NTT form.
         if (plain_coeff_count == 1)
         {
             if (!qualifiers_.enable_fast_plain_lift)
@@ -1308,7 +2209,7 @@ namespace seal
                         for (int j = 0; j < coeff_mod_count; j++)
                         {
                             multiply_poly_scalar_coeffmod(encrypted.pointer(i) + (j * coeff_count), coeff_count, 
-                                plain[j], coeff_modulus_[j], encrypted.mutable_pointer(i) + (j * coeff_count));
+                                plain[0], coeff_modulus_[j], encrypted.mutable_pointer(i) + (j * coeff_count));
                         }
                     }
                 }
@@ -1345,10 +2246,10 @@ namespace seal
             }
         }
 
-        // Multiplying by a monomial?
-        if (plain_nonzero_coeff_count == 1)
+        // Multiplying by a monomial? NTT form ciphertexts take the generic path.
+        if (plain_nonzero_coeff_count == 1 && !encrypted.is_ntt_form_)
         {
-            int mono_power = plain_coeff_count - 1;
+            int mono_power = plain.significant_coeff_count() - 1;
 
             if (!qualifiers_.enable_fast_plain_lift)
             {
@@ -1375,7 +2276,7 @@ namespace seal
                         for (int j = 0; j < coeff_mod_count; j++)
                         {
                             multiply_poly_mono_coeffmod(encrypted.pointer(i) + (j * coeff_count), coeff_count,
-                                plain[j], mono_power, coeff_modulus_[j], encrypted.mutable_pointer(i) + (j * coeff_count), pool);
+                                plain[mono_power], mono_power, coeff_modulus_[j], encrypted.mutable_pointer(i) + (j * coeff_count), pool);
                         }
                     }
                 }
@@ -1462,10 +2363,16 @@ namespace seal
 
         // Need to multiply each component in encrypted with decomposed_poly (plain poly)
         // Transform plain poly only once
-        for (int i = 0; i < coeff_mod_count; i++)
-        {
-            ntt_negacyclic_harvey(poly_to_transform + (i * coeff_count), coeff_small_ntt_tables_[i]);
-        }
+        ntt_negacyclic_harvey(poly_to_transform, coeff_count, coeff_mod_count, coeff_small_ntt_tables_->data());
+        multiply_plain_ntt_poly(encrypted, poly_to_transform);
+    }
+
+    void Evaluator::multiply_plain_ntt_poly(Ciphertext &encrypted, const uint64_t *plain_ntt)
+    {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int encrypted_size = encrypted.size();
 
         for (int i = 0; i < encrypted_size; i++)
         {
@@ -1473,16 +2380,21 @@ namespace seal
             for (int j = 0; j < coeff_mod_count; j++, encrypted_ptr += coeff_count)
             {
                 // Explicit inline to avoid unnecessary copy
-                //ntt_multiply_poly_nttpoly(encrypted.pointer(i) + (j * coeff_count), poly_to_transform + (j * coeff_count),
-                //    coeff_small_ntt_tables_[j], encrypted.mutable_pointer(i) + (j * coeff_count), pool);
+                //ntt_multiply_poly_nttpoly(encrypted.pointer(i) + (j * coeff_count), plain_ntt + (j * coeff_count),
+                //    (*coeff_small_ntt_tables_)[j], encrypted.mutable_pointer(i) + (j * coeff_count), pool);
 
-                int coeff_count = coeff_small_ntt_tables_[j].coeff_count() + 1;
+                if (encrypted.is_ntt_form_)
+                {
+                    dyadic_product_coeffmod(encrypted_ptr, plain_ntt + (j * coeff_count),
+                        coeff_count, (*coeff_small_ntt_tables_)[j].modulus(), encrypted_ptr);
+                    continue;
+                }
 
                 // Lazy reduction
-                ntt_negacyclic_harvey_lazy(encrypted_ptr, coeff_small_ntt_tables_[j]);
-                dyadic_product_coeffmod(encrypted_ptr, poly_to_transform + (j * coeff_count),
-                    coeff_count, coeff_small_ntt_tables_[j].modulus(), encrypted_ptr);
-                inverse_ntt_negacyclic_harvey(encrypted_ptr, coeff_small_ntt_tables_[j]);
+                ntt_negacyclic_harvey_lazy(encrypted_ptr, (*coeff_small_ntt_tables_)[j]);
+                dyadic_product_coeffmod(encrypted_ptr, plain_ntt + (j * coeff_count),
+                    coeff_count, (*coeff_small_ntt_tables_)[j].modulus(), encrypted_ptr);
+                inverse_ntt_negacyclic_harvey(encrypted_ptr, (*coeff_small_ntt_tables_)[j]);
             }
         }
     }
@@ -1495,6 +2407,10 @@ namespace seal
         int plain_coeff_count = plain.coeff_count();
 
         // Verify parameters.
+        if (plain.is_ntt_form_)
+        {
+            throw invalid_argument("plain is already in NTT form");
+        }
         if (plain.coeff_count() > coeff_count)
         {
             throw invalid_argument("plain is not valid for encryption parameters");
@@ -1558,10 +2474,8 @@ namespace seal
         }
 
         // Transform to NTT domain
-        for (int i = 0; i < coeff_mod_count; i++)
-        {
-            ntt_negacyclic_harvey(plain.pointer() + (i * coeff_count), coeff_small_ntt_tables_[i]);
-        }
+        ntt_negacyclic_harvey(plain.pointer(), coeff_count, coeff_mod_count, coeff_small_ntt_tables_->data());
+        plain.is_ntt_form_ = true;
     }
 
     void Evaluator::transform_to_ntt(Ciphertext &encrypted)
@@ -1571,20 +2485,28 @@ namespace seal
         int coeff_mod_count = coeff_modulus_.size();
         int encrypted_size = encrypted.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->transform_to_ntt(encrypted);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted.hash_block_ != parms_.hash_block())
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-
-        // Transform each polynomial to NTT domain
-        for (int i = 0; i < encrypted_size; i++)
+        if (encrypted.is_ntt_form_)
         {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                ntt_negacyclic_harvey(encrypted.mutable_pointer(i) + (j * coeff_count), coeff_small_ntt_tables_[j]);
-            }
+            throw invalid_argument("encrypted is already in NTT form");
         }
+
+        // Transform each polynomial to NTT domain
+        ntt_negacyclic_harvey(encrypted.mutable_pointer(), coeff_count, coeff_mod_count, 
+            coeff_small_ntt_tables_->data(), encrypted_size);
+        encrypted.is_ntt_form_ = true;
     }
 
     void Evaluator::transform_from_ntt(Ciphertext &encrypted_ntt)
@@ -1594,20 +2516,28 @@ namespace seal
         int coeff_mod_count = coeff_modulus_.size();
         int encrypted_ntt_size = encrypted_ntt.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted_ntt.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->transform_from_ntt(encrypted_ntt);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted_ntt.hash_block_ != parms_.hash_block())
         {
             throw invalid_argument("encrypted_ntt is not valid for encryption parameters");
         }
-
-        // Transform each polynomial from NTT domain
-        for (int i = 0; i < encrypted_ntt_size; i++)
+        if (!encrypted_ntt.is_ntt_form_)
         {
-            for (int j = 0; j < coeff_mod_count; j++)
-            {
-                inverse_ntt_negacyclic_harvey(encrypted_ntt.mutable_pointer(i) + (j * coeff_count), coeff_small_ntt_tables_[j]);
-            }
+            throw invalid_argument("encrypted_ntt is not in NTT form");
         }
+
+        // Transform each polynomial from NTT domain
+        inverse_ntt_negacyclic_harvey(encrypted_ntt.mutable_pointer(), coeff_count, coeff_mod_count,
+            coeff_small_ntt_tables_->data(), encrypted_ntt_size);
+        encrypted_ntt.is_ntt_form_ = false;
     }
 
     void Evaluator::multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt)
@@ -1617,12 +2547,28 @@ namespace seal
         int coeff_mod_count = coeff_modulus_.size();
         int encrypted_size = encrypted_ntt.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted_ntt.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->multiply_plain_ntt(encrypted_ntt, plain_ntt);
+            return;
+        }
+
         // Verify parameters.
         if (encrypted_ntt.hash_block_ != parms_.hash_block())
         {
             throw invalid_argument("encrypted_ntt is not valid for encryption parameters");
         }
-        if (plain_ntt.coeff_count() != coeff_count * coeff_mod_count)
+        if (!encrypted_ntt.is_ntt_form_)
+        {
+            throw invalid_argument("encrypted_ntt is not in NTT form");
+        }
+        if (!plain_ntt.is_ntt_form_)
+        {
+            throw invalid_argument("plain_ntt is not in NTT form");
+        }
+        if (plain_ntt.coeff_count() < coeff_count * coeff_mod_count || plain_ntt.coeff_count() % coeff_count != 0)
         {
             throw invalid_argument("plain_ntt is not valid for encryption parameters");
         }
@@ -1656,13 +2602,252 @@ namespace seal
         }
     }
 
-    void Evaluator::apply_galois(Ciphertext &encrypted, uint64_t galois_elt, const GaloisKeys &galois_keys, const MemoryPoolHandle &pool)
+    void Evaluator::dot_product_plain(const vector<Ciphertext> &encrypteds_ntt, const vector<Plaintext> &plains_ntt, 
+        Ciphertext &destination, const MemoryPoolHandle &pool)
+    {
+        // Verify parameters.
+        if (encrypteds_ntt.empty())
+        {
+            throw invalid_argument("encrypteds_ntt cannot be empty");
+        }
+        if (encrypteds_ntt.size() != plains_ntt.size())
+        {
+            throw invalid_argument("encrypteds_ntt and plains_ntt must have the same size");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        vector<const Ciphertext*> encrypted_ptrs;
+        vector<const Plaintext*> plain_ptrs;
+        for (size_t k = 0; k < encrypteds_ntt.size(); k++)
+        {
+            encrypted_ptrs.push_back(&encrypteds_ntt[k]);
+            plain_ptrs.push_back(&plains_ntt[k]);
+        }
+        dot_product_plain(encrypted_ptrs, plain_ptrs, destination, pool);
+    }
+
+    void Evaluator::dot_product_plain(const vector<const Ciphertext*> &encrypteds_ntt, 
+        const vector<const Plaintext*> &plains_ntt, Ciphertext &destination, const MemoryPoolHandle &pool)
+    {
+        // Extract encryption parameters.
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypteds_ntt[0]->hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->dot_product_plain(encrypteds_ntt, plains_ntt, destination, pool);
+            return;
+        }
+
+        int max_size = 0;
+        bool destination_aliased = false;
+        for (size_t k = 0; k < encrypteds_ntt.size(); k++)
+        {
+            if (encrypteds_ntt[k]->hash_block_ != parms_.hash_block())
+            {
+                throw invalid_argument("encrypteds_ntt is not valid for encryption parameters");
+            }
+            if (!encrypteds_ntt[k]->is_ntt_form_)
+            {
+                throw invalid_argument("encrypteds_ntt is not in NTT form");
+            }
+            if (!plains_ntt[k]->is_ntt_form_)
+            {
+                throw invalid_argument("plains_ntt is not in NTT form");
+            }
+            if (plains_ntt[k]->coeff_count() < coeff_count * coeff_mod_count || 
+                plains_ntt[k]->coeff_count() % coeff_count != 0)
+            {
+                throw invalid_argument("plains_ntt is not valid for encryption parameters");
+            }
+            max_size = max(max_size, encrypteds_ntt[k]->size());
+            destination_aliased = destination_aliased || (encrypteds_ntt[k] == &destination);
+        }
+
+        // Prepare destination; if it is one of the inputs the result is formed separately
+        Ciphertext sum(pool);
+        Ciphertext &result = destination_aliased ? sum : destination;
+        result.resize(parms_, max_size);
+        result.is_ntt_form_ = false;
+
+        /*
+        The dyadic products are summed up without reduction into 128-bit accumulators, one limb 
+        of one component at a time. A product of two residues modulo a b-bit prime has at most 
+        2b bits, so the accumulators can take 2^(128-2b) - 1 products after a reduction before 
+        they need to be reduced again, e.g. 255 for 60-bit primes.
+        */
+        int ntt_coeff_count = coeff_count - 1;
+        Pointer wide_sum(allocate_uint(2 * ntt_coeff_count, pool));
+        for (int i = 0; i < coeff_mod_count; i++)
+        {
+            int reduction_shift = 128 - 2 * coeff_modulus_[i].bit_count();
+            uint64_t reduction_interval = (reduction_shift >= 64) ? 
+                numeric_limits<uint64_t>::max() : (1ULL << reduction_shift) - 1;
+            for (int j = 0; j < max_size; j++)
+            {
+                set_zero_uint(2 * ntt_coeff_count, wide_sum.get());
+                uint64_t unreduced_count = 0;
+                for (size_t k = 0; k < encrypteds_ntt.size(); k++)
+                {
+                    if (encrypteds_ntt[k]->size() <= j)
+                    {
+                        continue;
+                    }
+                    uint64_t *wide_sum_ptr = wide_sum.get();
+                    if (unreduced_count == reduction_interval)
+                    {
+                        for (int m = 0; m < ntt_coeff_count; m++, wide_sum_ptr += 2)
+                        {
+                            wide_sum_ptr[0] = barrett_reduce_128(wide_sum_ptr, coeff_modulus_[i]);
+                            wide_sum_ptr[1] = 0;
+                        }
+                        wide_sum_ptr = wide_sum.get();
+                        unreduced_count = 0;
+                    }
+                    const uint64_t *encrypted_ptr = encrypteds_ntt[k]->pointer(j) + (i * coeff_count);
+                    const uint64_t *plain_ptr = plains_ntt[k]->pointer() + (i * coeff_count);
+                    uint64_t wide_product[2];
+                    for (int m = 0; m < ntt_coeff_count; m++, wide_sum_ptr += 2)
+                    {
+                        multiply_uint64(*encrypted_ptr++, *plain_ptr++, wide_product);
+                        unsigned char carry = add_uint64(wide_sum_ptr[0], wide_product[0], 0, wide_sum_ptr);
+                        wide_sum_ptr[1] += wide_product[1] + carry;
+                    }
+                    unreduced_count++;
+                }
+
+                uint64_t *result_ptr = result.mutable_pointer(j) + (i * coeff_count);
+                const uint64_t *wide_sum_ptr = wide_sum.get();
+                for (int m = 0; m < ntt_coeff_count; m++, wide_sum_ptr += 2)
+                {
+                    *result_ptr++ = barrett_reduce_128(wide_sum_ptr, coeff_modulus_[i]);
+                }
+                *result_ptr = 0;
+            }
+        }
+
+        // Transform the sum back from NTT form
+        inverse_ntt_negacyclic_harvey(result.mutable_pointer(), coeff_count, coeff_mod_count, 
+            coeff_small_ntt_tables_->data(), max_size);
+
+        if (destination_aliased)
+        {
+            destination = sum;
+        }
+    }
+
+    void Evaluator::linear_transform(Ciphertext &encrypted, const LinearTransform &transform, 
+        const GaloisKeys &galois_keys, const MemoryPoolHandle &pool)
+    {
+        int baby_step_count = transform.baby_step_count_;
+        int giant_step_count = transform.giant_step_count_;
+
+        // Verify parameters
+        if (transform.hash_block_ != key_hash_block_)
+        {
+            throw invalid_argument("transform is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Only the baby steps with a nonzero diagonal are rotated
+        vector<int> baby_steps = transform.baby_steps();
+
+        // The baby steps are rotated in NTT form, sharing one decomposition of the input
+        bool is_ntt_form = encrypted.is_ntt_form_;
+        const Ciphertext *encrypted_ntt = &encrypted;
+        Ciphertext encrypted_copy(pool);
+        if (!is_ntt_form)
+        {
+            encrypted_copy = encrypted;
+            transform_to_ntt(encrypted_copy);
+            encrypted_ntt = &encrypted_copy;
+        }
+        vector<Ciphertext> rotated;
+        rotate_rows_many(*encrypted_ntt, baby_steps, galois_keys, rotated, pool);
+        vector<const Ciphertext*> baby_rotated(baby_step_count, encrypted_ntt);
+        for (size_t s = 0; s < baby_steps.size(); s++)
+        {
+            baby_rotated[baby_steps[s]] = &rotated[s];
+        }
+
+        // Each giant step sums the products of its diagonals with the baby steps with lazy
+        // reduction, and rotates the sum into place
+        Ciphertext result(pool);
+        Ciphertext giant_step_sum(pool);
+        vector<const Ciphertext*> operands;
+        vector<const Plaintext*> diagonals;
+        for (int k = 0; k < giant_step_count; k++)
+        {
+            operands.clear();
+            diagonals.clear();
+            for (int j = 0; j < baby_step_count; j++)
+            {
+                const Plaintext &diagonal = transform.diagonals_[k * baby_step_count + j];
+                if (diagonal.coeff_count() > 0)
+                {
+                    operands.push_back(baby_rotated[j]);
+                    diagonals.push_back(&diagonal);
+                }
+            }
+            if (operands.empty())
+            {
+                continue;
+            }
+
+            // The first diagonal is always present, so the first giant step forms the result
+            Ciphertext &sum = (k == 0) ? result : giant_step_sum;
+            dot_product_plain(operands, diagonals, sum, pool);
+            rotate_rows(sum, k * baby_step_count, galois_keys, pool);
+            if (k > 0)
+            {
+                add(result, giant_step_sum);
+            }
+        }
+
+        if (is_ntt_form)
+        {
+            transform_to_ntt(result);
+        }
+        encrypted = result;
+    }
+
+    void Evaluator::apply_galois(Ciphertext &encrypted, uint64_t galois_elt, const GaloisKeys &galois_keys, 
+        const MemoryPoolHandle &pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Temporaries are allocated from pool as they are needed
+        EvaluatorWorkspace workspace(parms_.hash_block(), pool);
+        apply_galois(encrypted, galois_elt, galois_keys, workspace);
+    }
+
+    void Evaluator::apply_galois(Ciphertext &encrypted, uint64_t galois_elt, const GaloisKeys &galois_keys, 
+        EvaluatorWorkspace &workspace)
     {
         // Extract paramters
         int coeff_count = parms_.poly_modulus().coeff_count();
         int coeff_mod_count = parms_.coeff_modulus().size();
         int encrypted_size = encrypted.size();
 
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
+        {
+            next_evaluator()->apply_galois(encrypted, galois_elt, galois_keys, workspace);
+            return;
+        }
+
         // Verify parameters
         if (!(galois_elt & 1) || (galois_elt >= 2 * (coeff_count - 1)))
         {
@@ -1672,7 +2857,7 @@ namespace seal
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (galois_keys.hash_block_ != parms_.hash_block())
+        if (galois_keys.hash_block_ != key_hash_block_)
         {
             throw invalid_argument("galois_keys is not valid for encryption parameters");
         }
@@ -1680,223 +2865,467 @@ namespace seal
         {
             throw invalid_argument("ciphertext size must be 2");
         }
-        if (!pool)
+        if (!is_valid_workspace(workspace))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("workspace is not valid for encryption parameters");
         }
 
         int n = coeff_count - 1;
-        int m = n << 1;
-        int subgroup_size = n >> 1;
         int n_power_of_two = get_power_of_two(n);
 
         // Check if Galois key is generated or not.
-        // If not, attempt a bit decomposition; maybe we have log(n) many keys
+        // If not, apply the shortest sequence of keys that are present
         if (!galois_keys.has_key(galois_elt))
         {
-            // galois_elt = 3^order1 * (-1)^order2
-            uint64_t order1 = Zmstar_to_generator_.at(galois_elt).first;
-            uint64_t order2 = Zmstar_to_generator_.at(galois_elt).second;
-
-            // We use either 3 or -3 as our generator, depending on which gives smaller HW
-            uint64_t two_power_of_gen = 3;
-
-            // Does order1 or n/2-order1 have smaller Hamming weight?
-            if (hamming_weight(subgroup_size - order1) < hamming_weight(order1))
+            vector<uint64_t> path = galois_key_path(galois_elt, galois_keys);
+            for (size_t i = 0; i < path.size(); i++)
             {
-                order1 = subgroup_size - order1;
-                try_mod_inverse(3, m, two_power_of_gen);
+                apply_galois(encrypted, path[i], galois_keys, workspace);
             }
+            return;
+        }
+        workspace.reset();
 
-            while(order1)
+        // In NTT form the automorphism is only a permutation of the values, and only the second
+        // component is transformed to coefficient form as needed by the decomposition; the key 
+        // switching result is kept in the NTT domain. In coefficient form the automorphism is 
+        // applied directly. Both are gathers with the cached tables of galois_elt.
+        bool is_ntt_form = encrypted.is_ntt_form_;
+        uint64_t *encrypted_ptr = encrypted.mutable_pointer();
+        const uint32_t *galois_index = is_ntt_form ? galois_tables_->ntt_index(galois_elt) : 
+            galois_tables_->coeff_index(galois_elt);
+
+        // Apply Galois for each ciphertext; temp0 and temp1 hold the two components
+        uint64_t *temp = workspace.get_poly(2 * coeff_count, coeff_mod_count);
+        uint64_t *temp0 = temp;
+        uint64_t *temp1 = temp + (coeff_count * coeff_mod_count);
+        parallel_for(2 * coeff_mod_count, [&](int index)
+        {
+            int i = index % coeff_mod_count;
+            int offset = index * coeff_count;
+            // The last coefficient is always zero and stays in place
+            temp[offset + n] = 0;
+            if (is_ntt_form)
             {
-                if (order1 & 1)
+                util::apply_galois_ntt(encrypted_ptr + offset, n, galois_index, temp + offset);
+                if (index >= coeff_mod_count)
                 {
-                    if (!galois_keys.has_key(two_power_of_gen))
-                    {
-                        throw invalid_argument("galois key not present");
-                    }
-                    apply_galois(encrypted, two_power_of_gen, galois_keys, pool);
+                    inverse_ntt_negacyclic_harvey(temp + offset, coeff_count, 1, 
+                        coeff_small_ntt_tables_->data() + i);
                 }
-                two_power_of_gen *= two_power_of_gen;
-                two_power_of_gen &= (m - 1);
-                order1 >>= 1;
             }
-            if (order2)
+            else
             {
-                if (!galois_keys.has_key(m - 1))
-                {
-                    throw invalid_argument("galois key not present");
-                }
-                apply_galois(encrypted, m - 1, galois_keys, pool);
+                util::apply_galois(encrypted_ptr + offset, n_power_of_two, galois_index, coeff_modulus_[i], 
+                    temp + offset);
+            }
+        });
+
+        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
+        uint64_t *innerresult = workspace.get_poly(2 * coeff_count, coeff_mod_count);
+        switch_key_ntt(temp1, galois_keys.key(galois_elt), galois_keys.decomposition_bit_count(), 
+            innerresult, workspace);
+        parallel_for(2 * coeff_mod_count, [&](int index)
+        {
+            int i = index % coeff_mod_count;
+            int offset = index * coeff_count;
+            if (!is_ntt_form)
+            {
+                inverse_ntt_negacyclic_harvey(innerresult + offset, coeff_count, 1, 
+                    coeff_small_ntt_tables_->data() + i);
             }
+            if (index < coeff_mod_count)
+            {
+                add_poly_poly_coeffmod(temp0 + offset, innerresult + offset, coeff_count, coeff_modulus_[i], 
+                    encrypted_ptr + offset);
+            }
+            else
+            {
+                set_uint_uint(innerresult + offset, coeff_count, encrypted_ptr + offset);
+            }
+        });
+    }
+
+    void Evaluator::rotate_rows(Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const MemoryPoolHandle &pool)
+    {
+        // Is there anything to do?
+        if (steps == 0)
+        {
             return;
         }
 
-        // Apply Galois for each ciphertext
-        Pointer temp0(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
-        for (int i = 0; i < coeff_mod_count; i++)
+        // Perform rotation and key switching
+        apply_galois(encrypted, row_rotation_galois_elt(steps), galois_keys, pool);
+    }
+
+    void Evaluator::rotate_rows(Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, 
+        EvaluatorWorkspace &workspace)
+    {
+        // Is there anything to do?
+        if (steps == 0)
         {
-            util::apply_galois(encrypted.pointer() + (i * coeff_count), n_power_of_two,
-                galois_elt, coeff_modulus_[i], temp0.get() + (i * coeff_count));
+            return;
         }
-        Pointer temp1(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
-        for (int i = 0; i < coeff_mod_count; i++)
+
+        // Perform rotation and key switching
+        apply_galois(encrypted, row_rotation_galois_elt(steps), galois_keys, workspace);
+    }
+
+    void Evaluator::rotate_rows_many(const Ciphertext &encrypted, const vector<int> &steps, 
+        const GaloisKeys &galois_keys, vector<Ciphertext> &destinations, const MemoryPoolHandle &pool)
+    {
+        // Extract encryption parameters
+        int coeff_count = parms_.poly_modulus().coeff_count();
+        int coeff_mod_count = coeff_modulus_.size();
+        int n_power_of_two = get_power_of_two(coeff_count - 1);
+        int steps_count = steps.size();
+
+        // Ciphertexts at lower levels of the modulus switching chain are handled by the 
+        // Evaluator of their level
+        if (encrypted.hash_block_ != parms_.hash_block() && next_evaluator())
         {
-            util::apply_galois(encrypted.pointer(1) + (i * coeff_count), n_power_of_two,
-                galois_elt, coeff_modulus_[i], temp1.get() + (i * coeff_count));
+            next_evaluator()->rotate_rows_many(encrypted, steps, galois_keys, destinations, pool);
+            return;
         }
 
-        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
-        const uint64_t *encrypted_coeff = temp1.get();
-        Pointer encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
+        // Verify parameters
+        if (encrypted.hash_block_ != parms_.hash_block())
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (galois_keys.hash_block_ != key_hash_block_)
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (encrypted.size() > 2)
+        {
+            throw invalid_argument("ciphertext size must be 2");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
 
-        // decompose encrypted_array[count-1] into base w
-        // want to create an array of polys, each of whose components i is (encrypted_array[count-1])^(i) - in the notation of FV paper
-        // This allocation stores one of the decomposed factors modulo one of the primes
-        Pointer decomp_encrypted_last(allocate_uint(coeff_count, pool));
+        // If encrypted is one of the destinations, writing the results would change it before
+        // all rotations have read it, so the rotations are formed from a copy instead
+        for (size_t s = 0; s < destinations.size(); s++)
+        {
+            if (&destinations[s] == &encrypted)
+            {
+                Ciphertext encrypted_copy(encrypted);
+                rotate_rows_many(encrypted_copy, steps, galois_keys, destinations, pool);
+                return;
+            }
+        }
 
-        // Lazy reduction
-        Pointer wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        Pointer wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        Pointer innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        Pointer temp_decomp_coeff(allocate_uint(coeff_count, pool));
+        // Find the Galois elements; only those with a key present can share the decomposition,
+        // and the others are rotated one at a time with rotate_rows
+        vector<uint64_t> galois_elts(steps_count, 0);
+        bool hoist = false;
+        for (int s = 0; s < steps_count; s++)
+        {
+            if (steps[s] != 0)
+            {
+                galois_elts[s] = row_rotation_galois_elt(steps[s]);
+                hoist = hoist || galois_keys.has_key(galois_elts[s]);
+            }
+        }
 
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators (wide_innerresult0 and wide_innerresult1)
-        do not overflow. Since the modulus primes are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K). We need this to be at most 128, thus we need
-        bit_length(K) <= 6. Thus, we need K <= 63. In this case, this means sum_i galois_keys.key(galois_elt)[i].size() / 2 <= 63.
-        */
+        destinations.resize(steps_count);
+        for (int s = 0; s < steps_count; s++)
+        {
+            if (steps[s] == 0 || !galois_keys.has_key(galois_elts[s]))
+            {
+                destinations[s] = encrypted;
+                rotate_rows(destinations[s], steps[s], galois_keys, pool);
+            }
+        }
+        if (!hoist)
+        {
+            return;
+        }
+
+        // The automorphism is applied to encrypted[0] in its own form, and to the 
+        // decomposition of encrypted[1] in the NTT domain, where it is only a permutation
+        bool is_ntt_form = encrypted.is_ntt_form_;
+        Pointer encrypted_coeff_form;
+        const uint64_t *encrypted_coeff = encrypted.pointer(1);
+        if (is_ntt_form)
+        {
+            encrypted_coeff_form = allocate_poly(coeff_count, coeff_mod_count, pool);
+            set_poly_poly(encrypted.pointer(1), coeff_count, coeff_mod_count, encrypted_coeff_form.get());
+            inverse_ntt_negacyclic_harvey(encrypted_coeff_form.get(), coeff_count, coeff_mod_count,
+                coeff_small_ntt_tables_->data());
+            encrypted_coeff = encrypted_coeff_form.get();
+        }
+
+        // Decompose encrypted[1] into base w and transform every digit under every prime, 
+        // exactly as apply_galois does, but only once for all steps. The digits of prime i 
+        // start at digit_index[i] in decomp_ntt. With RNS digits there is one digit per prime,
+        // which is transformed under every prime of the keys as in switch_key_rns_ntt.
+        int decomposition_bit_count = galois_keys.decomposition_bit_count();
+        bool rns_digits = decomposition_bit_count == 0;
+        int limb_count = rns_digits ? key_coeff_modulus_.size() : coeff_mod_count;
+        vector<int> digit_index(coeff_mod_count + 1, 0);
+        for (int i = 0; i < coeff_mod_count; i++)
+        {
+            digit_index[i + 1] = digit_index[i] + (rns_digits ? 1 :
+                divide_round_up(coeff_modulus_[i].bit_count(), decomposition_bit_count));
+        }
+        int digit_count = digit_index[coeff_mod_count];
+        Pointer decomp_ntt(allocate_poly(coeff_count * digit_count, limb_count, pool));
+        Pointer encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
+        uint64_t *decomp_ntt_ptr = decomp_ntt.get();
         for (int i = 0; i < coeff_mod_count; i++)
         {
-            multiply_poly_scalar_coeffmod(encrypted_coeff + (i * coeff_count), coeff_count, 
-                inv_coeff_products_mod_coeff_array_[i], coeff_modulus_[i], encrypted_coeff_prod_inv_coeff.get());
+            if (rns_digits)
+            {
+                multiply_poly_scalar_coeffmod(encrypted_coeff + (i * coeff_count), coeff_count,
+                    inv_coeff_products_mod_coeff_array_[i], coeff_modulus_[i], encrypted_coeff_prod_inv_coeff.get());
+                for (int j = 0; j < limb_count; j++)
+                {
+                    reduce_poly_coeffs_barrett(encrypted_coeff_prod_inv_coeff.get(), coeff_count, key_coeff_modulus_[j], 
+                        decomp_ntt_ptr + (j * coeff_count));
+                }
+                ntt_negacyclic_harvey_lazy(decomp_ntt_ptr, coeff_count, limb_count, key_small_ntt_tables_->data());
+                decomp_ntt_ptr += coeff_count * limb_count;
+                continue;
+            }
+
+            multiply_poly_scalar_coeffmod(encrypted_coeff + (i * coeff_count), coeff_count,
+                key_switch_factors_[i], coeff_modulus_[i], encrypted_coeff_prod_inv_coeff.get());
 
             int shift = 0;
-            const Ciphertext &key_component_ref = galois_keys.key(galois_elt)[i];
-            int keys_size = key_component_ref.size();
-            for (int k = 0; k < keys_size; k += 2)
+            for (int k = digit_index[i]; k < digit_index[i + 1]; k++)
             {
-                const uint64_t *key_ptr_0 = key_component_ref.pointer(k);
-                const uint64_t *key_ptr_1 = key_component_ref.pointer(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = galois_keys.decomposition_bit_count();
                 for (int coeff_index = 0; coeff_index < coeff_count; coeff_index++)
                 {
-                    decomp_encrypted_last[coeff_index] = encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= (1ULL << decomposition_bit_count) - 1;
+                    decomp_ntt_ptr[coeff_index] = encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
+                    decomp_ntt_ptr[coeff_index] &= (1ULL << decomposition_bit_count) - 1;
+                }
+                for (int j = 1; j < coeff_mod_count; j++)
+                {
+                    set_uint_uint(decomp_ntt_ptr, coeff_count, decomp_ntt_ptr + (j * coeff_count));
                 }
 
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (int j = 0; j < coeff_mod_count; j++)
+                // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
+                ntt_negacyclic_harvey_lazy(decomp_ntt_ptr, coeff_count, coeff_mod_count, 
+                    coeff_small_ntt_tables_->data());
+                decomp_ntt_ptr += coeff_count * coeff_mod_count;
+                shift += decomposition_bit_count;
+            }
+        }
+
+        // Keep encrypted[0] in case encrypted is overwritten
+        Pointer encrypted_zero(allocate_poly(coeff_count, coeff_mod_count, pool));
+        set_poly_poly(encrypted.pointer(), coeff_count, coeff_mod_count, encrypted_zero.get());
+
+        Pointer temp0(allocate_zero_uint(coeff_count, pool));
+        Pointer wide_innerresult0(allocate_poly(coeff_count, 2 * limb_count, pool));
+        Pointer wide_innerresult1(allocate_poly(coeff_count, 2 * limb_count, pool));
+
+        // Below the top level the key switching result modulo all primes of the keys is 
+        // divided by the special primes before it is moved to the destination
+        Pointer switched;
+        Pointer temp_special;
+        if (limb_count > coeff_mod_count)
+        {
+            switched = allocate_poly(2 * coeff_count, limb_count, pool);
+            temp_special = allocate_poly(coeff_count, limb_count - 1, pool);
+        }
+        for (int s = 0; s < steps_count; s++)
+        {
+            uint64_t galois_elt = galois_elts[s];
+            if (steps[s] == 0 || !galois_keys.has_key(galois_elt))
+            {
+                continue;
+            }
+            const vector<Ciphertext> &key = galois_keys.key(galois_elt);
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                if (key[i].size() != 2 * (digit_index[i + 1] - digit_index[i]))
                 {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
+                    throw invalid_argument("galois_keys is not valid for encryption parameters");
+                }
+            }
 
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables_[j]);
+            // In the NTT domain the automorphism maps the value at index galois_index[m] to index m;
+            // the last coefficient is always zero and is skipped
+            const uint32_t *galois_index = galois_tables_->ntt_index(galois_elt);
+            const uint32_t *galois_coeff_index = is_ntt_form ? nullptr : galois_tables_->coeff_index(galois_elt);
 
-                    // Lazy reduction
-                    uint64_t wide_innerproduct[2];
-                    for (int m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
+            // Calculate (sum of permuted digits times galois keys) with lazy reduction as in apply_galois
+            set_zero_uint(2 * coeff_count * limb_count, wide_innerresult0.get());
+            set_zero_uint(2 * coeff_count * limb_count, wide_innerresult1.get());
+            decomp_ntt_ptr = decomp_ntt.get();
+            for (int i = 0; i < coeff_mod_count; i++)
+            {
+                const Ciphertext &key_component_ref = key[i];
+                int keys_size = key_component_ref.size();
+                for (int k = 0; k < keys_size; k += 2)
+                {
+                    for (int j = 0; j < limb_count; j++, decomp_ntt_ptr += coeff_count)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0], wide_innerproduct[0], 0,
-                            wide_innerresult0_ptr);
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        const uint64_t *key_ptr_0 = key_component_ref.pointer(k) + (j * coeff_count);
+                        const uint64_t *key_ptr_1 = key_component_ref.pointer(k + 1) + (j * coeff_count);
+                        uint64_t *wide_innerresult0_ptr = wide_innerresult0.get() + (j * 2 * coeff_count);
+                        uint64_t *wide_innerresult1_ptr = wide_innerresult1.get() + (j * 2 * coeff_count);
+
+                        // Permute the digit on the fly
+                        uint64_t wide_innerproduct[2];
+                        for (int m = 0; m < coeff_count - 1; m++, wide_innerresult0_ptr += 2)
+                        {
+                            multiply_uint64(decomp_ntt_ptr[galois_index[m]], key_ptr_0[m], wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult0_ptr[0], wide_innerproduct[0], 0,
+                                wide_innerresult0_ptr);
+                            wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        }
+
+                        for (int m = 0; m < coeff_count - 1; m++, wide_innerresult1_ptr += 2)
+                        {
+                            multiply_uint64(decomp_ntt_ptr[galois_index[m]], key_ptr_1[m], wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult1_ptr[0], wide_innerproduct[0], 0,
+                                wide_innerresult1_ptr);
+                            wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        }
                     }
+                }
+            }
+
+            Ciphertext &destination = destinations[s];
+            destination.resize(parms_, 2);
+            destination.is_ntt_form_ = is_ntt_form;
 
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (int m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
+            // Reduce the key switching result, in NTT form, to the destination
+            uint64_t *switched_ptr = switched.is_set() ? switched.get() : destination.mutable_pointer();
+            for (int k = 0; k < 2; k++)
+            {
+                uint64_t *wide_innerresult_coeff_ptr = k ? wide_innerresult1.get() : wide_innerresult0.get();
+                for (int j = 0; j < limb_count; j++, switched_ptr += coeff_count)
+                {
+                    for (int m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0], wide_innerproduct[0], 0,
-                            wide_innerresult1_ptr);
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        switched_ptr[m] = barrett_reduce_128(wide_innerresult_coeff_ptr, key_coeff_modulus_[j]);
                     }
                 }
-                shift += decomposition_bit_count;
             }
-        }
+            if (switched.is_set())
+            {
+                for (int k = 0; k < 2; k++)
+                {
+                    uint64_t *switched_poly_ptr = switched.get() + (k * coeff_count * limb_count);
+                    divide_round_by_special_primes(switched_poly_ptr, temp_special.get());
+                    set_uint_uint(switched_poly_ptr, coeff_count * coeff_mod_count, destination.mutable_pointer(k));
+                }
+            }
 
-        uint64_t *temp_ptr = temp0.get();
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted.mutable_pointer();
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (int i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count,
-            temp_ptr += coeff_count)
-        {
-            for (int m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            uint64_t *encrypted_ptr = destination.mutable_pointer();
+            for (int i = 0; i < coeff_mod_count; i++, encrypted_ptr += coeff_count)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(wide_innerresult_coeff_ptr, coeff_modulus_[i]);
+                if (is_ntt_form)
+                {
+                    util::apply_galois_ntt(encrypted_zero.get() + (i * coeff_count), coeff_count - 1, 
+                        galois_index, temp0.get());
+                }
+                else
+                {
+                    inverse_ntt_negacyclic_harvey(encrypted_ptr, (*coeff_small_ntt_tables_)[i]);
+                    util::apply_galois(encrypted_zero.get() + (i * coeff_count), n_power_of_two,
+                        galois_coeff_index, coeff_modulus_[i], temp0.get());
+                }
+                add_poly_poly_coeffmod(temp0.get(), encrypted_ptr, coeff_count, coeff_modulus_[i], encrypted_ptr);
             }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables_[i]);
-            add_poly_poly_coeffmod(temp_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus_[i], encrypted_ptr);
-        }
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted.mutable_pointer(1);
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (int i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            innerresult_coeff_ptr = encrypted_ptr;
-            for (int m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            if (!is_ntt_form)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(wide_innerresult_coeff_ptr, coeff_modulus_[i]);
+                inverse_ntt_negacyclic_harvey(destination.mutable_pointer(1), coeff_count, coeff_mod_count, 
+                    coeff_small_ntt_tables_->data());
             }
-            inverse_ntt_negacyclic_harvey(encrypted_ptr, coeff_small_ntt_tables_[i]);
         }
     }
 
-    void Evaluator::rotate_rows(Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, const MemoryPoolHandle &pool)
+    void Evaluator::sum_slots(Ciphertext &encrypted, const GaloisKeys &galois_keys, const MemoryPoolHandle &pool)
     {
-        // Is there anything to do?
-        if (steps == 0)
+        int row_size = (parms_.poly_modulus().coeff_count() - 1) >> 1;
+
+        // Verify parameters; the rotations verify the rest
+        if (!qualifiers_.enable_batching)
         {
-            return;
+            throw logic_error("encryption parameters are not valid for batching");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
         }
 
-        // Extract sign of steps. When steps is positive, the rotation is to the left,
-        // and when steps is negative, it is to the right.
-        bool sign = steps < 0;
-        uint32_t pos_steps = abs(steps);
-        uint32_t n = parms_.poly_modulus().coeff_count() - 1;
-        uint32_t m_power_of_two = get_power_of_two(n) + 1;
-
-        if (pos_steps >= (n >> 1))
+        // Each round adds rotated copies so that every slot holds the sum of a block of
+        // consecutive slots in its row; rounds with keys for steps s, 2s, and 3s quadruple
+        // the block size with a single decomposition, and the others double it
+        vector<Ciphertext> rotated;
+        vector<int> steps(3);
+        int step = 1;
+        while (step < row_size)
         {
-            throw invalid_argument("step count too large");
+            if ((row_size >> 2) >= step
+                && galois_keys.has_key(row_rotation_galois_elt(step))
+                && galois_keys.has_key(row_rotation_galois_elt(2 * step))
+                && galois_keys.has_key(row_rotation_galois_elt(3 * step)))
+            {
+                steps[0] = step;
+                steps[1] = 2 * step;
+                steps[2] = 3 * step;
+                rotate_rows_many(encrypted, steps, galois_keys, rotated, pool);
+                for (int i = 0; i < 3; i++)
+                {
+                    add(encrypted, rotated[i]);
+                }
+                step <<= 2;
+            }
+            else
+            {
+                rotated.resize(1);
+                rotate_rows(encrypted, step, galois_keys, rotated[0], pool);
+                add(encrypted, rotated[0]);
+                step <<= 1;
+            }
         }
 
-        pos_steps &= (1UL << m_power_of_two) - 1;
-        if (sign)
+        // Finally add the two row sums
+        rotated.resize(1);
+        rotate_columns(encrypted, galois_keys, rotated[0], pool);
+        add(encrypted, rotated[0]);
+    }
+
+    void Evaluator::replicate_slot(Ciphertext &encrypted, int slot, const GaloisKeys &galois_keys, 
+        const MemoryPoolHandle &pool)
+    {
+        int slot_count = parms_.poly_modulus().coeff_count() - 1;
+
+        // Verify parameters
+        if (!qualifiers_.enable_batching)
         {
-            steps = (n >> 1) - pos_steps;
+            throw logic_error("encryption parameters are not valid for batching");
         }
-        else
+        if (slot < 0 || slot >= slot_count)
         {
-            steps = pos_steps;
+            throw invalid_argument("slot is out of range");
         }
-
-        // Construct Galois element for row rotation
-        int gen = 3;
-        uint64_t galois_elt = 1;
-        for (int i = 0; i < steps; i++)
+        if (!pool)
         {
-            galois_elt *= gen;
-            galois_elt &= (1ULL << m_power_of_two) - 1;
+            throw invalid_argument("pool is uninitialized");
         }
 
-        // Perform rotation and key switching
-        apply_galois(encrypted, galois_elt, galois_keys, pool);
+        // Clear all other slots, and sum what is left into every slot
+        vector<uint64_t> mask(slot_count, 0);
+        mask[slot] = 1;
+        Plaintext plain_mask(pool);
+        poly_crt_builder_->compose(mask, plain_mask);
+        multiply_plain(encrypted, plain_mask, pool);
+        sum_slots(encrypted, galois_keys, pool);
+    }
+
+    uint64_t Evaluator::row_rotation_galois_elt(int steps) const
+    {
+        return util::row_rotation_galois_elt(steps, get_power_of_two(parms_.poly_modulus().coeff_count() - 1));
     }
 }
@@ -3,6 +3,8 @@
 #include <vector>
 #include <utility>
 #include <map>
+#include <memory>
+#include <functional>
 #include "seal/encryptionparams.h"
 #include "seal/context.h"
 #include "seal/evaluationkeys.h"
@@ -11,8 +13,14 @@
 #include "seal/ciphertext.h"
 #include "seal/plaintext.h"
 #include "seal/galoiskeys.h"
+#include "seal/lineartransform.h"
+#include "seal/polycrt.h"
+#include "seal/evaluatorworkspace.h"
 #include "seal/util/polymodulus.h"
 #include "seal/util/baseconverter.h"
+#include "seal/util/galoistables.h"
+#include "seal/util/locks.h"
+#include "seal/util/threadpool.h"
 #include "seal/util/uintarithsmallmod.h"
 
 using namespace std;
@@ -55,7 +63,8 @@ namespace seal
     When batching is enabled, we provide operations for rotating the plaintext matrix rows
     cyclically left or right, and for rotating the columns (swapping the rows). Rotations
     require Galois keys to have been generated, and their performance depends on the
-    decomposition bit count that the Galois keys were generated with.
+    decomposition bit count that the Galois keys were generated with. A rotation without
+    a Galois key of its own is composed from the smallest number of the keys present.
 
     @par Other Operations
     We also provide operations for transforming ciphertexts to NTT form and back, and for
@@ -65,6 +74,15 @@ namespace seal
     when e.g. one plaintext input is used in several plain multiplication, and transforming
     it several times would not make sense.
 
+    @par NTT Form Ciphertexts
+    A ciphertext transformed to NTT form with transform_to_ntt remembers its form, and can
+    stay in NTT form through a chain of computations: negate, add, sub, multiply, square,
+    relinearize, multiply_plain, multiply_plain_ntt, and the rotations all accept NTT form
+    inputs and keep the result in NTT form. This avoids transforming the ciphertext back
+    and forth between consecutive operations. The Decryptor accepts ciphertexts in either
+    form. Adding or subtracting a plaintext requires the ciphertext to be in coefficient
+    form, and both inputs to add and sub must be in the same form.
+
     @par Overloads
     For many functions we provide two flavors of overloads. In one set of overloads the
     operations act on the inputs "in place", overwriting typically the first of the input
@@ -82,6 +100,29 @@ namespace seal
     operations we provide up to four different overloads, and it is important for 
     a developer to understand how these work to avoid unnecessary performance bottlenecks.
 
+    @par Modulus Switching
+    The noise in a ciphertext grows with each multiplication relative to the coefficient 
+    modulus. Once the noise budget has been consumed down to what the remaining computation 
+    needs, mod_switch_to_next divides the ciphertext by the last prime of its coefficient 
+    modulus and rounds it, which keeps the encrypted plaintext and moves the ciphertext to 
+    the next level of the chain of SEALContexts given by SEALContext::next_context. The 
+    ciphertext then has one prime less, so every later operation on it is faster, and it 
+    is saved in less space. All operations of the Evaluator accept ciphertexts at any level
+    of the chain of the SEALContext it was created with; the inputs to an operation must 
+    all be at the same level. Evaluation keys and Galois keys generated for the full 
+    coefficient modulus work at every level, as do plaintexts transformed to NTT form with 
+    transform_to_ntt. The Evaluator for a level is created the first time a ciphertext 
+    reaches that level, so the levels that are never used cost nothing.
+
+    @par Intra-Operation Parallelism
+    By default every operation runs in the thread that calls it. After set_thread_count
+    has been called with a thread count larger than one, multiply, relinearize,
+    multiply_relinearize, and the rotations split their work on the individual primes of
+    the coefficient modulus and on the individual ciphertext polynomials across a thread
+    pool owned by the Evaluator. The results are identical to those computed by a single
+    thread. The pool runs one operation at a time; an operation started while the pool is
+    busy with another one, e.g. from a different thread, runs in its calling thread.
+
     @see EncryptionParameters for more details on encryption parameters.
     @see PolyCRTBuilder for more details on batching
     @see EvaluationKeys for more details on evaluation keys.
@@ -117,6 +158,29 @@ namespace seal
         */
         Evaluator(Evaluator &&source) = default;
 
+        /**
+        Sets the number of threads that multiply, relinearize, multiply_relinearize, add_many,
+        multiply_many_parallel, and the rotations split their work across, including the 
+        calling thread. With a thread count of one, which is the default, no threads are 
+        started. This function is not thread-safe, and must not be called while any operation 
+        is running on the Evaluator.
+
+        @param[in] thread_count The number of threads
+        @throws std::invalid_argument if thread_count is not positive
+        */
+        void set_thread_count(int thread_count);
+
+        /**
+        Returns the number of threads that operations on the Evaluator split their work 
+        across.
+
+        @see set_thread_count for more information about intra-operation parallelism.
+        */
+        inline int thread_count() const
+        {
+            return thread_pool_ ? thread_pool_->thread_count() : 1;
+        }
+
         /**
         Negates a ciphertext.
 
@@ -147,6 +211,7 @@ namespace seal
         @param[in] encrypted2 The second ciphertext to add
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the encryption 
         parameters
+        @throws std::invalid_argument if only one of encrypted1 and encrypted2 is in NTT form
         @throws std::logic_error if encrypted1 is aliased and needs to be reallocated
         */
         void add(Ciphertext &encrypted1, const Ciphertext &encrypted2);
@@ -160,6 +225,7 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the addition result
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the encryption 
         parameters
+        @throws std::invalid_argument if only one of encrypted1 and encrypted2 is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         inline void add(const Ciphertext &encrypted1, const Ciphertext &encrypted2, 
@@ -171,13 +237,18 @@ namespace seal
 
         /**
         Adds together a vector of ciphertexts and stores the result in the destination 
-        parameter.
+        parameter. The ciphertexts can have different sizes. The coefficients of the sum are 
+        accumulated in 64 bits and reduced only when the next summand could overflow them, and 
+        the limbs of the sum modulo the different coefficient modulus primes are computed 
+        concurrently on the threads set with set_thread_count.
 
         @param[in] encrypteds The ciphertexts to add
         @param[out] destination The ciphertext to overwrite with the addition result
         @throws std::invalid_argument if encrypteds is empty
         @throws std::invalid_argument if the ciphertexts are not valid for the encryption 
         parameters
+        @throws std::invalid_argument if the ciphertexts are not all in the same form (NTT or 
+        coefficient)
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         void add_many(const std::vector<Ciphertext> &encrypteds, Ciphertext &destination);
@@ -190,6 +261,7 @@ namespace seal
         @param[in] encrypted2 The ciphertext to subtract
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the encryption 
         parameters
+        @throws std::invalid_argument if only one of encrypted1 and encrypted2 is in NTT form
         @throws std::logic_error if encrypted1 is aliased and needs to be reallocated
         */
         void sub(Ciphertext &encrypted1, const Ciphertext &encrypted2);
@@ -203,6 +275,7 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the subtraction result
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the encryption 
         parameters
+        @throws std::invalid_argument if only one of encrypted1 and encrypted2 is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         inline void sub(const Ciphertext &encrypted1, const Ciphertext &encrypted2, 
@@ -214,8 +287,10 @@ namespace seal
 
         /**
         Multiplies two ciphertexts. This functions computes the product of encrypted1 and
-        encrypted2 and stores the result in encrypted1. Dynamic memory allocations in the 
-        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        encrypted2 and stores the result in encrypted1. The inputs can each be in either 
+        coefficient or NTT form, and the result is in the form of encrypted1. Dynamic memory 
+        allocations in the process are allocated from the memory pool pointed to by the given 
+        MemoryPoolHandle.
 
         @param[in] encrypted1 The first ciphertext to multiply
         @param[in] encrypted2 The second ciphertext to multiply
@@ -244,6 +319,22 @@ namespace seal
             multiply(encrypted1, encrypted2, pool_);
         }
 
+        /**
+        Multiplies two ciphertexts. This functions computes the product of encrypted1 and
+        encrypted2 and stores the result in encrypted1. All temporary memory needed in the 
+        process is taken from the given workspace, and no memory pool is used unless the 
+        workspace needs to grow.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] workspace The workspace to take temporary memory from
+        @throws std::invalid_argument if encrypted1, encrypted2, or workspace is not valid for 
+        the encryption parameters
+        @throws std::logic_error if encrypted1 is aliased and needs to be reallocated
+        */
+        void multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            EvaluatorWorkspace &workspace);
+
         /**
         Multiplies two ciphertexts. This functions computes the product of encrypted1 and
         encrypted2 and stores the result in the destination parameter. Dynamic memory
@@ -350,6 +441,77 @@ namespace seal
             square(encrypted, destination, pool_);
         }
 
+        /**
+        Switches a ciphertext to the next level of the modulus switching chain. This function
+        divides encrypted by the last prime in its coefficient modulus and rounds the result,
+        so that it encrypts the same plaintext under the coefficient modulus without that
+        prime. The ciphertext can be in either coefficient or NTT form, and stays in its form.
+        Dynamic memory allocations in the process are allocated from the memory pool pointed 
+        to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to switch to the next level
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is already at the last level
+        @throws std::invalid_argument if pool is uninitialized
+        @see SEALContext::next_context for more information about the modulus switching chain.
+        */
+        void mod_switch_to_next(Ciphertext &encrypted, const MemoryPoolHandle &pool);
+
+        /**
+        Switches a ciphertext to the next level of the modulus switching chain. This function
+        divides encrypted by the last prime in its coefficient modulus and rounds the result,
+        so that it encrypts the same plaintext under the coefficient modulus without that
+        prime. The ciphertext can be in either coefficient or NTT form, and stays in its form.
+        Dynamic memory allocations in the process are allocated from the memory pool pointed 
+        to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to switch to the next level
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is already at the last level
+        @see SEALContext::next_context for more information about the modulus switching chain.
+        */
+        inline void mod_switch_to_next(Ciphertext &encrypted)
+        {
+            mod_switch_to_next(encrypted, pool_);
+        }
+
+        /**
+        Switches a ciphertext to the next level of the modulus switching chain and stores the
+        result in the destination parameter. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to switch to the next level
+        @param[out] destination The ciphertext to overwrite with the switched ciphertext
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is already at the last level
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void mod_switch_to_next(const Ciphertext &encrypted, Ciphertext &destination, 
+            const MemoryPoolHandle &pool)
+        {
+            destination = encrypted;
+            mod_switch_to_next(destination, pool);
+        }
+
+        /**
+        Switches a ciphertext to the next level of the modulus switching chain and stores the
+        result in the destination parameter. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to switch to the next level
+        @param[out] destination The ciphertext to overwrite with the switched ciphertext
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is already at the last level
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void mod_switch_to_next(const Ciphertext &encrypted, Ciphertext &destination)
+        {
+            mod_switch_to_next(encrypted, destination, pool_);
+        }
+
         /**
         Relinearizes a ciphertext. This functions relinearizes encrypted, reducing its size 
         down to 2. If the size of encrypted is K+1, the given evaluation keys need to have 
@@ -387,6 +549,25 @@ namespace seal
             relinearize(encrypted, evaluation_keys, pool_);
         }
 
+        /**
+        Relinearizes a ciphertext. This functions relinearizes encrypted, reducing its size
+        down to 2. If the size of encrypted is K+1, the given evaluation keys need to have
+        size at least K-1. All temporary memory needed in the process is taken from the given
+        workspace, and no memory pool is used unless the workspace needs to grow.
+
+        @param[in] encrypted The ciphertext to relinearize
+        @param[in] evaluation_keys The evaluation keys
+        @param[in] workspace The workspace to take temporary memory from
+        @throws std::invalid_argument if encrypted, evaluation_keys, or workspace is not valid 
+        for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        */
+        inline void relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, 
+            EvaluatorWorkspace &workspace)
+        {
+            relinearize(encrypted, evaluation_keys, 2, workspace);
+        }
+
         /**
         Relinearizes a ciphertext. This functions relinearizes encrypted, reducing its size
         down to 2, and stores the result in the destination parameter. If the size of encrypted 
@@ -433,6 +614,108 @@ namespace seal
             relinearize(encrypted, evaluation_keys, destination, pool_);
         }
 
+        /**
+        Multiplies two ciphertexts and relinearizes the product. This function computes the 
+        product of encrypted1 and encrypted2, relinearizes it down to size 2, and stores the 
+        result in encrypted1. The result is the same as calling multiply followed by relinearize, 
+        but when both inputs have size 2 the size 3 product is never formed: its last component 
+        goes directly to key switching, and the key switching result is added to the first two 
+        components in whichever form encrypted1 is in. Dynamic memory allocations in the 
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted1, encrypted2, or evaluation_keys is not valid 
+        for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void multiply_relinearize(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool);
+
+        /**
+        Multiplies two ciphertexts and relinearizes the product. This function computes the 
+        product of encrypted1 and encrypted2, relinearizes it down to size 2, and stores the 
+        result in encrypted1. Dynamic memory allocations in the process are allocated from the 
+        memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @throws std::invalid_argument if encrypted1, encrypted2, or evaluation_keys is not valid 
+        for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        */
+        inline void multiply_relinearize(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            const EvaluationKeys &evaluation_keys)
+        {
+            multiply_relinearize(encrypted1, encrypted2, evaluation_keys, pool_);
+        }
+
+        /**
+        Multiplies two ciphertexts and relinearizes the product. This function computes the 
+        product of encrypted1 and encrypted2, relinearizes it down to size 2, and stores the 
+        result in encrypted1. All temporary memory needed in the process is taken from the 
+        given workspace, and no memory pool is used unless the workspace needs to grow.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[in] workspace The workspace to take temporary memory from
+        @throws std::invalid_argument if encrypted1, encrypted2, evaluation_keys, or workspace 
+        is not valid for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        */
+        void multiply_relinearize(Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            const EvaluationKeys &evaluation_keys, EvaluatorWorkspace &workspace);
+
+        /**
+        Multiplies two ciphertexts and relinearizes the product. This function computes the 
+        product of encrypted1 and encrypted2, relinearizes it down to size 2, and stores the 
+        result in the destination parameter. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the relinearized product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted1, encrypted2, or evaluation_keys is not valid 
+        for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void multiply_relinearize(const Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            const EvaluationKeys &evaluation_keys, Ciphertext &destination, const MemoryPoolHandle &pool)
+        {
+            destination = encrypted1;
+            multiply_relinearize(destination, encrypted2, evaluation_keys, pool);
+        }
+
+        /**
+        Multiplies two ciphertexts and relinearizes the product. This function computes the 
+        product of encrypted1 and encrypted2, relinearizes it down to size 2, and stores the 
+        result in the destination parameter. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted1 The first ciphertext to multiply
+        @param[in] encrypted2 The second ciphertext to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the relinearized product
+        @throws std::invalid_argument if encrypted1, encrypted2, or evaluation_keys is not valid 
+        for the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void multiply_relinearize(const Ciphertext &encrypted1, const Ciphertext &encrypted2, 
+            const EvaluationKeys &evaluation_keys, Ciphertext &destination)
+        {
+            multiply_relinearize(encrypted1, encrypted2, evaluation_keys, destination, pool_);
+        }
+
         /**
         Multiplies several ciphertexts together. This function computes the product of several
         ciphertext given as an std::vector and stores the result in the destination parameter.
@@ -479,12 +762,120 @@ namespace seal
             multiply_many(encrypteds, evaluation_keys, destination, pool_);
         }
 
+        /**
+        Multiplies several ciphertexts together using several threads. This function computes 
+        the product of several ciphertexts given as an std::vector and stores the result in the 
+        destination parameter. The multiplication is done in a balanced tree, and the products 
+        on each level of the tree are computed concurrently on the threads set with 
+        set_thread_count. Each thread allocates from a memory pool of its own. Relinearization 
+        is performed after every multiplication, except on the top lazy_relin_levels levels of 
+        the tree, whose products are only relinearized once at the end. This saves 
+        relinearizations at the cost of larger ciphertexts being multiplied. With k lazy levels 
+        and size 2 inputs the final product has size up to 2^k+1 before relinearization, and the 
+        evaluation keys need to have size at least the final size minus 2. In relinearization 
+        the given evaluation keys are used.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @param[in] lazy_relin_levels The number of top levels of the tree whose products are 
+        not relinearized
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if lazy_relin_levels is negative
+        @throws std::invalid_argument if the ciphertexts or evaluation_keys are not valid for
+        the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        void multiply_many_parallel(const std::vector<Ciphertext> &encrypteds, 
+            const EvaluationKeys &evaluation_keys, Ciphertext &destination, int lazy_relin_levels);
+
+        /**
+        Multiplies several ciphertexts together using several threads. This function computes 
+        the product of several ciphertexts given as an std::vector and stores the result in the 
+        destination parameter. The multiplication is done in a balanced tree, and the products 
+        on each level of the tree are computed concurrently on the threads set with 
+        set_thread_count. Each thread allocates from a memory pool of its own. Relinearization 
+        is performed automatically after every multiplication. In relinearization the given 
+        evaluation keys are used.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if the ciphertexts or evaluation_keys are not valid for
+        the encryption parameters
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void multiply_many_parallel(const std::vector<Ciphertext> &encrypteds, 
+            const EvaluationKeys &evaluation_keys, Ciphertext &destination)
+        {
+            multiply_many_parallel(encrypteds, evaluation_keys, destination, 0);
+        }
+
+        /**
+        Computes the dot product of two vectors of ciphertexts. This function multiplies the 
+        ciphertexts of encrypteds1 and encrypteds2 pairwise, adds the products together, and 
+        stores the result in the destination parameter. The products are added together before 
+        they are relinearized, so only one relinearization is performed instead of one for 
+        every product, and the result has size 2. In relinearization the given evaluation keys 
+        are used. Dynamic memory allocations in the process are allocated from the memory pool 
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds1 The first vector of ciphertexts
+        @param[in] encrypteds2 The second vector of ciphertexts
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the dot product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds1 is empty
+        @throws std::invalid_argument if encrypteds1 and encrypteds2 have different sizes
+        @throws std::invalid_argument if the ciphertexts or evaluation_keys are not valid for
+        the encryption parameters
+        @throws std::invalid_argument if the ciphertexts in encrypteds1 are not all in the same 
+        form (NTT or coefficient)
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void dot_product(const std::vector<Ciphertext> &encrypteds1, 
+            const std::vector<Ciphertext> &encrypteds2, const EvaluationKeys &evaluation_keys, 
+            Ciphertext &destination, const MemoryPoolHandle &pool);
+
+        /**
+        Computes the dot product of two vectors of ciphertexts. This function multiplies the 
+        ciphertexts of encrypteds1 and encrypteds2 pairwise, adds the products together, and 
+        stores the result in the destination parameter. The products are added together before 
+        they are relinearized, so only one relinearization is performed instead of one for 
+        every product, and the result has size 2. In relinearization the given evaluation keys 
+        are used. Dynamic memory allocations in the process are allocated from the memory pool 
+        pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypteds1 The first vector of ciphertexts
+        @param[in] encrypteds2 The second vector of ciphertexts
+        @param[in] evaluation_keys The evaluation keys
+        @param[out] destination The ciphertext to overwrite with the dot product
+        @throws std::invalid_argument if encrypteds1 is empty
+        @throws std::invalid_argument if encrypteds1 and encrypteds2 have different sizes
+        @throws std::invalid_argument if the ciphertexts or evaluation_keys are not valid for
+        the encryption parameters
+        @throws std::invalid_argument if the ciphertexts in encrypteds1 are not all in the same 
+        form (NTT or coefficient)
+        @throws std::invalid_argument if the size of evaluation_keys is too small
+        */
+        inline void dot_product(const std::vector<Ciphertext> &encrypteds1, 
+            const std::vector<Ciphertext> &encrypteds2, const EvaluationKeys &evaluation_keys, 
+            Ciphertext &destination)
+        {
+            dot_product(encrypteds1, encrypteds2, evaluation_keys, destination, pool_);
+        }
+
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power. Dynamic 
         memory allocations in the process are allocated from the memory pool pointed to by 
         the given MemoryPoolHandle. The exponentiation is done in a depth-optimal order, 
         and relinearization is performed automatically after every multiplication in the 
-        process. In relinearization the given evaluation keys are used.
+        process. In relinearization the given evaluation keys are used. The number of 
+        multiplications needed grows only logarithmically with the exponent.
 
         @param[in] encrypted The ciphertext to exponentiate
         @param[in] exponent The power to raise the ciphertext to
@@ -585,6 +976,7 @@ namespace seal
         @param[in] plain The plaintext to add
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption 
         parameters
+        @throws std::invalid_argument if encrypted or plain is in NTT form
         */
         void add_plain(Ciphertext &encrypted, const Plaintext &plain);
 
@@ -600,6 +992,7 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the addition result
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption
         parameters
+        @throws std::invalid_argument if encrypted or plain is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         inline void add_plain(const Ciphertext &encrypted, const Plaintext &plain, 
@@ -620,6 +1013,7 @@ namespace seal
         @param[in] plain The plaintext to subtract
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption
         parameters
+        @throws std::invalid_argument if encrypted or plain is in NTT form
         */
         void sub_plain(Ciphertext &encrypted, const Plaintext &plain);
 
@@ -635,6 +1029,7 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the subtraction result
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption
         parameters
+        @throws std::invalid_argument if encrypted or plain is in NTT form
         @throws std::logic_error if destination is aliased and needs to be reallocated
         */
         inline void sub_plain(const Ciphertext &encrypted, const Plaintext &plain, 
@@ -650,6 +1045,8 @@ namespace seal
         degree(poly_modulus) many non-zero coefficients, and each coefficient must be less 
         than the plaintext modulus, i.e. the plaintext must be a valid plaintext under the
         current encryption parameters. Moreover, the plaintext cannot be identially 0.
+        A plaintext prepared once with transform_to_ntt can also be given, in which case only
+        a coefficient-wise product with each polynomial of the ciphertext is computed.
         Dynamic memory allocations in the process are allocated from the memory pool pointed 
         to by the given MemoryPoolHandle.
 
@@ -670,6 +1067,8 @@ namespace seal
         degree(poly_modulus) many non-zero coefficients, and each coefficient must be less
         than the plaintext modulus, i.e. the plaintext must be a valid plaintext under the
         current encryption parameters. Moreover, the plaintext cannot be identially 0.
+        A plaintext prepared once with transform_to_ntt can also be given, in which case only
+        a coefficient-wise product with each polynomial of the ciphertext is computed.
         Dynamic memory allocations in the process are allocated from the memory pool pointed
         to by the local MemoryPoolHandle.
 
@@ -690,8 +1089,9 @@ namespace seal
         to be valid, the plaintext must have less than degree(poly_modulus) many non-zero 
         coefficients, and each coefficient must be less than the plaintext modulus, i.e. 
         the plaintext must be a valid plaintext under the current encryption parameters.
-        Moreover, the plaintext cannot be identially 0. Dynamic memory allocations in the 
-        process are allocated from the memory pool pointed to by the given MemoryPoolHandle. 
+        Moreover, the plaintext cannot be identially 0. A plaintext prepared once with 
+        transform_to_ntt can also be given. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle. 
 
         @param[in] encrypted The ciphertext to multiply
         @param[in] plain The plaintext to multiply
@@ -716,8 +1116,9 @@ namespace seal
         to be valid, the plaintext must have less than degree(poly_modulus) many non-zero
         coefficients, and each coefficient must be less than the plaintext modulus, i.e.
         the plaintext must be a valid plaintext under the current encryption parameters.
-        Moreover, the plaintext cannot be identially 0. Dynamic memory allocations in the
-        process are allocated from the memory pool pointed to by the local MemoryPoolHandle.
+        Moreover, the plaintext cannot be identially 0. A plaintext prepared once with 
+        transform_to_ntt can also be given. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the local MemoryPoolHandle.
 
         @param[in] encrypted The ciphertext to multiply
         @param[in] plain The plaintext to multiply
@@ -740,12 +1141,15 @@ namespace seal
         on the resulting polynomial.For the operation to be valid, the plaintext must have 
         less than degree(poly_modulus) many non-zero coefficients, and each coefficient must
         be less than the plaintext modulus, i.e. the plaintext must be a valid plaintext 
-        under the current encryption parameters. Dynamic memory allocations in the process
-        are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        under the current encryption parameters. The plaintext is marked to be in NTT form,
+        keeps that form when saved and loaded, and can then be passed to multiply_plain any 
+        number of times. Dynamic memory allocations in the process are allocated from the 
+        memory pool pointed to by the given MemoryPoolHandle.
 
         @param[in] plain The plaintext to transform
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is already in NTT form
         @throws std::logic_error if plain is aliased and needs to be reallocated
         @throws std::invalid_argument if pool is uninitialized
         */
@@ -758,11 +1162,14 @@ namespace seal
         on the resulting polynomial.For the operation to be valid, the plaintext must have
         less than degree(poly_modulus) many non-zero coefficients, and each coefficient must
         be less than the plaintext modulus, i.e. the plaintext must be a valid plaintext
-        under the current encryption parameters. Dynamic memory allocations in the process
-        are allocated from the memory pool pointed to by the local MemoryPoolHandle.
+        under the current encryption parameters. The plaintext is marked to be in NTT form,
+        keeps that form when saved and loaded, and can then be passed to multiply_plain any 
+        number of times. Dynamic memory allocations in the process are allocated from the 
+        memory pool pointed to by the local MemoryPoolHandle.
 
         @param[in] plain The plaintext to transform
         @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is already in NTT form
         @throws std::logic_error if plain is aliased and needs to be reallocated
         */
         inline void transform_to_ntt(Plaintext &plain)
@@ -822,6 +1229,7 @@ namespace seal
 
         @param[in] encrypted The ciphertext to transform
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is already in NTT form
         */
         void transform_to_ntt(Ciphertext &encrypted);
 
@@ -847,6 +1255,7 @@ namespace seal
 
         @param[in] encrypted_ntt The ciphertext to transform
         @throws std::invalid_argument if encrypted_ntt is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted_ntt is not in NTT form
         */
         void transform_from_ntt(Ciphertext &encrypted_ntt);
 
@@ -876,6 +1285,7 @@ namespace seal
         @param[in] plain_ntt The plaintext to multiply
         @throws std::invalid_argument if encrypted_ntt or plain_ntt is not valid for the
         encryption parameters
+        @throws std::invalid_argument if encrypted_ntt or plain_ntt is not in NTT form
         @throws std::invalid_argument if plain_ntt is zero
         */
         void multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt);
@@ -891,6 +1301,7 @@ namespace seal
         @param[out] destination_ntt The ciphertext to overwrite with the multiplication result
         @throws std::invalid_argument if encrypted_ntt or plain_ntt is not valid for the
         encryption parameters
+        @throws std::invalid_argument if encrypted_ntt or plain_ntt is not in NTT form
         @throws std::invalid_argument if plain_ntt is zero
         @throws std::logic_error if destination_ntt is aliased and needs to be reallocated
         */
@@ -901,6 +1312,56 @@ namespace seal
             multiply_plain_ntt(destination_ntt, plain_ntt);
         }
 
+        /**
+        Computes the dot product of a vector of ciphertexts and a vector of plaintexts. This 
+        function multiplies NTT transformed ciphertexts with NTT transformed plaintexts pairwise, 
+        adds the products together, and stores the result in the destination parameter in 
+        coefficient form. The products are accumulated in 128 bits and reduced only when needed, 
+        and the sum is transformed back from NTT form once. The ciphertexts can have different 
+        sizes. Dynamic memory allocations in the process are allocated from the memory pool 
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds_ntt The ciphertexts in NTT form
+        @param[in] plains_ntt The plaintexts transformed with transform_to_ntt
+        @param[out] destination The ciphertext to overwrite with the dot product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds_ntt is empty
+        @throws std::invalid_argument if encrypteds_ntt and plains_ntt have different sizes
+        @throws std::invalid_argument if the ciphertexts or plaintexts are not valid for the 
+        encryption parameters
+        @throws std::invalid_argument if the ciphertexts or plaintexts are not in NTT form
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void dot_product_plain(const std::vector<Ciphertext> &encrypteds_ntt, 
+            const std::vector<Plaintext> &plains_ntt, Ciphertext &destination, 
+            const MemoryPoolHandle &pool);
+
+        /**
+        Computes the dot product of a vector of ciphertexts and a vector of plaintexts. This 
+        function multiplies NTT transformed ciphertexts with NTT transformed plaintexts pairwise, 
+        adds the products together, and stores the result in the destination parameter in 
+        coefficient form. The products are accumulated in 128 bits and reduced only when needed, 
+        and the sum is transformed back from NTT form once. The ciphertexts can have different 
+        sizes. Dynamic memory allocations in the process are allocated from the memory pool 
+        pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypteds_ntt The ciphertexts in NTT form
+        @param[in] plains_ntt The plaintexts transformed with transform_to_ntt
+        @param[out] destination The ciphertext to overwrite with the dot product
+        @throws std::invalid_argument if encrypteds_ntt is empty
+        @throws std::invalid_argument if encrypteds_ntt and plains_ntt have different sizes
+        @throws std::invalid_argument if the ciphertexts or plaintexts are not valid for the 
+        encryption parameters
+        @throws std::invalid_argument if the ciphertexts or plaintexts are not in NTT form
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void dot_product_plain(const std::vector<Ciphertext> &encrypteds_ntt, 
+            const std::vector<Plaintext> &plains_ntt, Ciphertext &destination)
+        {
+            dot_product_plain(encrypteds_ntt, plains_ntt, destination, pool_);
+        }
+
         /**
         Rotates plaintext matrix rows cyclically. When batching is used, this function rotates
         the encrypted plaintext matrix rows cyclically to the left (steps > 0) or to the right
@@ -945,6 +1406,27 @@ namespace seal
             rotate_rows(encrypted, steps, galois_keys, pool_);
         }
 
+        /**
+        Rotates plaintext matrix rows cyclically. When batching is used, this function rotates
+        the encrypted plaintext matrix rows cyclically to the left (steps > 0) or to the right
+        (steps < 0). Since the size of the batched matrix is 2-by-(N/2), where N is the degree
+        of the polynomial modulus, the number of steps to rotate must have absolute value at
+        most N/2-1. All temporary memory needed in the process is taken from the given
+        workspace, and no memory pool is used unless the workspace needs to grow.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The number of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[in] workspace The workspace to take temporary memory from
+        @throws std::invalid_argument if encrypted, galois_keys, or workspace is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        */
+        void rotate_rows(Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, 
+            EvaluatorWorkspace &workspace);
+
         /**
         Rotates plaintext matrix rows cyclically. When batching is used, this function rotates
         the encrypted plaintext matrix rows cyclically to the left (steps > 0) or to the right
@@ -1000,6 +1482,60 @@ namespace seal
             rotate_rows(encrypted, steps, galois_keys, destination, pool_);
         }
 
+        /**
+        Rotates plaintext matrix rows cyclically by several step counts at once. When batching
+        is used, this function rotates the encrypted plaintext matrix rows by each of the given 
+        step counts, as rotate_rows does, and writes the i-th result to destinations[i]. The 
+        decomposition of the ciphertext and its transformation to the NTT domain are done only 
+        once and shared by all rotations whose Galois key is present, which makes this much 
+        faster than calling rotate_rows repeatedly. This comes at the cost of memory: the 
+        decomposition needs roughly as many polynomials as a Galois key. Step counts without a 
+        Galois key of their own are rotated with rotate_rows. Dynamic memory allocations in the 
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The ciphertexts to overwrite with the rotated results
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if any step count has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if a destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void rotate_rows_many(const Ciphertext &encrypted, const std::vector<int> &steps,
+            const GaloisKeys &galois_keys, std::vector<Ciphertext> &destinations, 
+            const MemoryPoolHandle &pool);
+
+        /**
+        Rotates plaintext matrix rows cyclically by several step counts at once. When batching
+        is used, this function rotates the encrypted plaintext matrix rows by each of the given 
+        step counts, as rotate_rows does, and writes the i-th result to destinations[i]. The 
+        decomposition of the ciphertext and its transformation to the NTT domain are done only 
+        once and shared by all rotations whose Galois key is present. Dynamic memory allocations 
+        in the process are allocated from the memory pool pointed to by the local 
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The ciphertexts to overwrite with the rotated results
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if any step count has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if a destination is aliased and needs to be reallocated
+        */
+        inline void rotate_rows_many(const Ciphertext &encrypted, const std::vector<int> &steps,
+            const GaloisKeys &galois_keys, std::vector<Ciphertext> &destinations)
+        {
+            rotate_rows_many(encrypted, steps, galois_keys, destinations, pool_);
+        }
+
         /**
         Rotates plaintext matrix columns cyclically. When batching is used, this function
         rotates the encrypted plaintext matrix columns cyclically. Since the size of the 
@@ -1046,6 +1582,29 @@ namespace seal
             rotate_columns(encrypted, galois_keys, pool_);
         }
 
+        /**
+        Rotates plaintext matrix columns cyclically. When batching is used, this function
+        rotates the encrypted plaintext matrix columns cyclically. Since the size of the 
+        batched matrix is 2-by-(N/2), where N is the degree of the polynomial modulus, 
+        this means simply swapping the two rows. All temporary memory needed in the process
+        is taken from the given workspace, and no memory pool is used unless the workspace
+        needs to grow.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] galois_keys The Galois keys
+        @param[in] workspace The workspace to take temporary memory from
+        @throws std::invalid_argument if encrypted, galois_keys, or workspace is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        */
+        inline void rotate_columns(Ciphertext &encrypted, const GaloisKeys &galois_keys, 
+            EvaluatorWorkspace &workspace)
+        {
+            std::uint64_t m = (parms_.poly_modulus().coeff_count() - 1) << 1;
+            apply_galois(encrypted, m - 1, galois_keys, workspace);
+        }
+
         /**
         Rotates plaintext matrix columns cyclically. When batching is used, this function 
         rotates the encrypted plaintext matrix columns cyclically, and writes the result 
@@ -1096,12 +1655,344 @@ namespace seal
             rotate_columns(encrypted, galois_keys, destination, pool_);
         }
 
+        /**
+        Sums all slots of a batched plaintext matrix. When batching is used, this function
+        replaces every slot of the encrypted 2-by-(N/2) plaintext matrix with the sum of all
+        N slots, where N is the degree of the polynomial modulus. The rows are summed in 
+        log(N/2) rounds of rotating and adding, after which the two rows are added together.
+        A round rotates by the step counts s, 2s, and 3s at once, sharing the decomposition 
+        of the ciphertext as rotate_rows_many does, whenever the Galois keys for all three 
+        are present; otherwise it rotates by s alone. The Galois keys generated by 
+        KeyGenerator::generate_sum_slots_galois_keys allow the shared rounds throughout. 
+        Dynamic memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slots to sum
+        @param[in] galois_keys The Galois keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void sum_slots(Ciphertext &encrypted, const GaloisKeys &galois_keys, 
+            const MemoryPoolHandle &pool);
+
+        /**
+        Sums all slots of a batched plaintext matrix. When batching is used, this function
+        replaces every slot of the encrypted 2-by-(N/2) plaintext matrix with the sum of all
+        N slots, where N is the degree of the polynomial modulus. Dynamic memory allocations
+        in the process are allocated from the memory pool pointed to by the local 
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slots to sum
+        @param[in] galois_keys The Galois keys
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @see sum_slots(Ciphertext&, const GaloisKeys&, const MemoryPoolHandle&) for the 
+        rotations used.
+        */
+        inline void sum_slots(Ciphertext &encrypted, const GaloisKeys &galois_keys)
+        {
+            sum_slots(encrypted, galois_keys, pool_);
+        }
+
+        /**
+        Sums all slots of a batched plaintext matrix, and writes the result to the 
+        destination parameter. When batching is used, every slot of the result holds the 
+        sum of all N slots of the encrypted 2-by-(N/2) plaintext matrix, where N is the 
+        degree of the polynomial modulus. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slots to sum
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the sum
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void sum_slots(const Ciphertext &encrypted, const GaloisKeys &galois_keys, 
+            Ciphertext &destination, const MemoryPoolHandle &pool)
+        {
+            destination = encrypted;
+            sum_slots(destination, galois_keys, pool);
+        }
+
+        /**
+        Sums all slots of a batched plaintext matrix, and writes the result to the 
+        destination parameter. When batching is used, every slot of the result holds the 
+        sum of all N slots of the encrypted 2-by-(N/2) plaintext matrix, where N is the 
+        degree of the polynomial modulus. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slots to sum
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the sum
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void sum_slots(const Ciphertext &encrypted, const GaloisKeys &galois_keys, 
+            Ciphertext &destination)
+        {
+            sum_slots(encrypted, galois_keys, destination, pool_);
+        }
+
+        /**
+        Replicates one slot of a batched plaintext matrix to all slots. When batching is 
+        used, this function replaces every slot of the encrypted 2-by-(N/2) plaintext matrix
+        with the value in the given slot, where N is the degree of the polynomial modulus. 
+        Slots are indexed as in PolyCRTBuilder: the first N/2 slots form the first row of 
+        the matrix, and the rest form the second row. The other slots are cleared by 
+        multiplying with a plaintext, after which the slots are summed as sum_slots does, so
+        the same Galois keys are needed. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slot to replicate
+        @param[in] slot The index of the slot to replicate
+        @param[in] galois_keys The Galois keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if slot is not within [0, N)
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void replicate_slot(Ciphertext &encrypted, int slot, const GaloisKeys &galois_keys,
+            const MemoryPoolHandle &pool);
+
+        /**
+        Replicates one slot of a batched plaintext matrix to all slots. When batching is 
+        used, this function replaces every slot of the encrypted 2-by-(N/2) plaintext matrix
+        with the value in the given slot, where N is the degree of the polynomial modulus. 
+        Slots are indexed as in PolyCRTBuilder. Dynamic memory allocations in the process 
+        are allocated from the memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slot to replicate
+        @param[in] slot The index of the slot to replicate
+        @param[in] galois_keys The Galois keys
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if slot is not within [0, N)
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        */
+        inline void replicate_slot(Ciphertext &encrypted, int slot, const GaloisKeys &galois_keys)
+        {
+            replicate_slot(encrypted, slot, galois_keys, pool_);
+        }
+
+        /**
+        Replicates one slot of a batched plaintext matrix to all slots, and writes the 
+        result to the destination parameter. When batching is used, every slot of the result
+        holds the value in the given slot of the encrypted 2-by-(N/2) plaintext matrix, 
+        where N is the degree of the polynomial modulus. Slots are indexed as in 
+        PolyCRTBuilder. Dynamic memory allocations in the process are allocated from the 
+        memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slot to replicate
+        @param[in] slot The index of the slot to replicate
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if slot is not within [0, N)
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void replicate_slot(const Ciphertext &encrypted, int slot, 
+            const GaloisKeys &galois_keys, Ciphertext &destination, const MemoryPoolHandle &pool)
+        {
+            destination = encrypted;
+            replicate_slot(destination, slot, galois_keys, pool);
+        }
+
+        /**
+        Replicates one slot of a batched plaintext matrix to all slots, and writes the 
+        result to the destination parameter. When batching is used, every slot of the result
+        holds the value in the given slot of the encrypted 2-by-(N/2) plaintext matrix, 
+        where N is the degree of the polynomial modulus. Slots are indexed as in 
+        PolyCRTBuilder. Dynamic memory allocations in the process are allocated from the 
+        memory pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext whose slot to replicate
+        @param[in] slot The index of the slot to replicate
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if slot is not within [0, N)
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void replicate_slot(const Ciphertext &encrypted, int slot, 
+            const GaloisKeys &galois_keys, Ciphertext &destination)
+        {
+            replicate_slot(encrypted, slot, galois_keys, destination, pool_);
+        }
+
+        /**
+        Multiplies encrypted vectors with a plaintext matrix. When batching is used, this 
+        function replaces each of the two rows of the encrypted 2-by-(N/2) plaintext matrix, 
+        where N is the degree of the polynomial modulus, with its product with the matrix of
+        the given LinearTransform. The input is rotated by the baby steps of the transform 
+        at once, as rotate_rows_many does, the products with the diagonals are summed with 
+        lazy reduction in NTT form for each giant step, and the sums are rotated by their 
+        giant steps and added together. The result is in NTT form if the input is. Dynamic 
+        memory allocations in the process are allocated from the memory pool pointed to by
+        the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The matrix to multiply with
+        @param[in] galois_keys The Galois keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @see LinearTransform for more details on the diagonal method.
+        */
+        void linear_transform(Ciphertext &encrypted, const LinearTransform &transform, 
+            const GaloisKeys &galois_keys, const MemoryPoolHandle &pool);
+
+        /**
+        Multiplies encrypted vectors with a plaintext matrix. When batching is used, this 
+        function replaces each of the two rows of the encrypted 2-by-(N/2) plaintext matrix, 
+        where N is the degree of the polynomial modulus, with its product with the matrix of
+        the given LinearTransform. The result is in NTT form if the input is. Dynamic memory 
+        allocations in the process are allocated from the memory pool pointed to by the 
+        local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The matrix to multiply with
+        @param[in] galois_keys The Galois keys
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @see LinearTransform for more details on the diagonal method.
+        */
+        inline void linear_transform(Ciphertext &encrypted, const LinearTransform &transform, 
+            const GaloisKeys &galois_keys)
+        {
+            linear_transform(encrypted, transform, galois_keys, pool_);
+        }
+
+        /**
+        Multiplies encrypted vectors with a plaintext matrix, and writes the result to the
+        destination parameter. When batching is used, each of the two rows of the result 
+        holds the product of the matrix of the given LinearTransform with the same row of 
+        the encrypted 2-by-(N/2) plaintext matrix, where N is the degree of the polynomial 
+        modulus. Dynamic memory allocations in the process are allocated from the memory 
+        pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The matrix to multiply with
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void linear_transform(const Ciphertext &encrypted, const LinearTransform &transform, 
+            const GaloisKeys &galois_keys, Ciphertext &destination, const MemoryPoolHandle &pool)
+        {
+            destination = encrypted;
+            linear_transform(destination, transform, galois_keys, pool);
+        }
+
+        /**
+        Multiplies encrypted vectors with a plaintext matrix, and writes the result to the
+        destination parameter. When batching is used, each of the two rows of the result 
+        holds the product of the matrix of the given LinearTransform with the same row of 
+        the encrypted 2-by-(N/2) plaintext matrix, where N is the degree of the polynomial 
+        modulus. Dynamic memory allocations in the process are allocated from the memory 
+        pool pointed to by the local MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] transform The matrix to multiply with
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the product
+        @throws std::invalid_argument if encrypted, transform, or galois_keys is not valid
+        for the encryption parameters
+        @throws std::invalid_argument if encrypted has size greater than two
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if destination is aliased and needs to be reallocated
+        */
+        inline void linear_transform(const Ciphertext &encrypted, const LinearTransform &transform, 
+            const GaloisKeys &galois_keys, Ciphertext &destination)
+        {
+            linear_transform(encrypted, transform, galois_keys, destination, pool_);
+        }
+
     private:
         Evaluator &operator =(const Evaluator &assign) = delete;
 
         Evaluator &operator =(Evaluator &&assign) = delete;
 
+        /*
+        Creates the Evaluator for a lower level of the modulus switching chain of the 
+        Evaluator parent. The keys, the workspaces, and the thread pool of the top level 
+        are used at every level.
+        */
+        Evaluator(const std::shared_ptr<const SEALContext> &context, const Evaluator &parent);
+
+        void initialize(const SEALContext &context);
+
+        /*
+        Returns the Evaluator for the next level of the modulus switching chain, or nullptr
+        if this is the last level. The Evaluator is created the first time it is needed.
+        */
+        Evaluator *next_evaluator();
+
+        void set_thread_pool(const std::shared_ptr<util::ThreadPool> &thread_pool);
+
+        /*
+        Returns true if the workspace was created for the top level, or for the level of 
+        the current Evaluator.
+        */
+        inline bool is_valid_workspace(const EvaluatorWorkspace &workspace) const
+        {
+            return workspace.hash_block_ == key_hash_block_ || workspace.hash_block_ == parms_.hash_block();
+        }
+
+        void relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, int destination_size, 
+            const MemoryPoolHandle &pool);
+
         void relinearize(Ciphertext &encrypted, const EvaluationKeys &evaluation_keys, int destination_size, 
+            EvaluatorWorkspace &workspace);
+
+        void multiply_plain_ntt_poly(Ciphertext &encrypted, const std::uint64_t *plain_ntt);
+
+        void dot_product_plain(const std::vector<const Ciphertext*> &encrypteds_ntt, 
+            const std::vector<const Plaintext*> &plains_ntt, Ciphertext &destination, 
             const MemoryPoolHandle &pool);
 
         inline void decompose_single_coeff(const std::uint64_t *value, std::uint64_t *destination, const MemoryPoolHandle &pool)
@@ -1204,10 +2095,63 @@ namespace seal
 
         void compose(std::uint64_t *value, const MemoryPoolHandle &pool);
 
-        void relinearize_one_step(std::uint64_t *encrypted, int encrypted_size, 
-            const EvaluationKeys &evaluation_keys, const MemoryPoolHandle &pool);
+        /*
+        Calls task(i) for every i in [0, task_count), splitting the calls across the thread 
+        pool if there is one. The calls must write to disjoint memory.
+        */
+        void parallel_for(int task_count, const std::function<void(int)> &task);
+
+        void relinearize_one_step(std::uint64_t *encrypted, int encrypted_size, bool is_ntt_form,
+            const EvaluationKeys &evaluation_keys, EvaluatorWorkspace &workspace);
 
-        void populate_Zmstar_to_generator();
+        /*
+        Computes the product of two ciphertexts given in the given forms, and writes it in 
+        coefficient form to destination, except for the last component which is written to 
+        destination_last.
+        */
+        void multiply_behz(const std::uint64_t *encrypted1, int encrypted1_size, bool encrypted1_is_ntt_form, 
+            const std::uint64_t *encrypted2, int encrypted2_size, bool encrypted2_is_ntt_form, 
+            std::uint64_t *destination, std::uint64_t *destination_last, EvaluatorWorkspace &workspace);
+
+        /*
+        Key switches encrypted_last, given in coefficient form, with the given evaluation or 
+        Galois key, and writes the two resulting polys in NTT form to destination.
+        */
+        void switch_key_ntt(const std::uint64_t *encrypted_last, const std::vector<Ciphertext> &key, 
+            int decomposition_bit_count, std::uint64_t *destination, EvaluatorWorkspace &workspace);
+
+        /*
+        Same as switch_key_ntt for keys with RNS digits. The residues of encrypted_last are 
+        extended to all primes of the keys, and below the top level the result is divided by 
+        the primes above the current level.
+        */
+        void switch_key_rns_ntt(const std::uint64_t *encrypted_last, const std::vector<Ciphertext> &key, 
+            std::uint64_t *destination, EvaluatorWorkspace &workspace);
+
+        /*
+        Divides poly, given by its residues modulo the first limb_count primes of the top 
+        level, by the last of these primes with rounding, and writes the result over the 
+        first limb_count - 1 limbs. The last limb is overwritten, and temp must have room 
+        for limb_count - 1 limbs.
+        */
+        void divide_round_by_last(std::uint64_t *poly, int limb_count, bool is_ntt_form, 
+            const std::uint64_t *inv_last_mod, std::uint64_t *temp);
+
+        /*
+        Divides poly in NTT form, given by its residues modulo all primes of the top level, 
+        by the primes above the current level with rounding. temp must have room for one 
+        limb less than there are primes at the top level.
+        */
+        void divide_round_by_special_primes(std::uint64_t *poly, std::uint64_t *temp);
+
+        /*
+        Returns a shortest sequence of Galois elements with keys present in galois_keys whose
+        product is galois_elt. The shortest path tree for the set of keys present is computed
+        once and cached.
+        */
+        std::vector<std::uint64_t> galois_key_path(std::uint64_t galois_elt, const GaloisKeys &galois_keys);
+
+        std::uint64_t row_rotation_galois_elt(int steps) const;
 
         // The apply_galois function applies a Galois automorphism to a ciphertext. 
         // It is needed for slot permutations. 
@@ -1217,6 +2161,9 @@ namespace seal
         void apply_galois(Ciphertext &encrypted, std::uint64_t galois_elt, const GaloisKeys &evaluation_keys,
             const MemoryPoolHandle &pool);
 
+        void apply_galois(Ciphertext &encrypted, std::uint64_t galois_elt, const GaloisKeys &evaluation_keys,
+            EvaluatorWorkspace &workspace);
+
         inline void apply_galois(Ciphertext &encrypted, std::uint64_t galois_elt, const GaloisKeys &evaluation_keys)
         {
             apply_galois(encrypted, galois_elt, evaluation_keys, pool_);
@@ -1241,11 +2188,16 @@ namespace seal
 
         EncryptionParameterQualifiers qualifiers_;
         
-        util::BaseConverter base_converter_;
+        std::shared_ptr<const util::BaseConverter> base_converter_;
         
-        std::vector<util::SmallNTTTables> coeff_small_ntt_tables_;
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> coeff_small_ntt_tables_;
 
-        std::vector<util::SmallNTTTables> bsk_small_ntt_tables_;
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> bsk_small_ntt_tables_;
+
+        std::shared_ptr<const util::GaloisTables> galois_tables_;
+
+        // Encodes the slot masks of replicate_slot; shared by copies of the Evaluator
+        std::shared_ptr<PolyCRTBuilder> poly_crt_builder_;
 
         util::Pointer upper_half_increment_;
 
@@ -1275,6 +2227,38 @@ namespace seal
 
         int bsk_base_mod_count_;
 
-        std::map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t> > Zmstar_to_generator_;
+        std::map<std::vector<std::uint64_t>, std::vector<std::uint64_t> > galois_key_paths_;
+
+        std::unique_ptr<util::ReaderWriterLocker> galois_key_paths_locker_;
+
+        // The hash block of the top level of the modulus switching chain, and the inverses of 
+        // the products of all but one of its primes modulo that prime; the keys are generated 
+        // for the top level and are decomposed with these factors at every level
+        EncryptionParameters::hash_block_type key_hash_block_;
+
+        std::vector<std::uint64_t> key_switch_factors_;
+
+        // The primes of the top level and their NTT tables, over which keys with RNS digits
+        // are applied, and for each prime of the top level above the current level, its 
+        // inverse modulo each of the primes below it
+        std::vector<SmallModulus> key_coeff_modulus_;
+
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> key_small_ntt_tables_;
+
+        std::vector<std::vector<std::uint64_t> > inv_special_primes_mod_coeff_;
+
+        // The inverse of the last prime modulo each of the other primes
+        std::vector<std::uint64_t> inv_last_coeff_mod_coeff_array_;
+
+        std::shared_ptr<util::ThreadPool> thread_pool_;
+
+        // The context of this level, from which the next level is created
+        std::shared_ptr<const SEALContext> context_;
+
+        std::unique_ptr<Evaluator> next_evaluator_;
+
+        std::unique_ptr<util::ReaderWriterLocker> next_evaluator_locker_;
+
+        friend class LinearTransform;
     };
 }
@@ -0,0 +1,83 @@
+#include <stdexcept>
+#include "seal/evaluatorworkspace.h"
+#include "seal/util/polycore.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    EvaluatorWorkspace::EvaluatorWorkspace(const SEALContext &context, const MemoryPoolHandle &pool) :
+        pool_(pool), hash_block_(context.parms().hash_block())
+    {
+        // Verify parameters
+        if (!context.qualifiers().parameters_set)
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        size_t coeff_count = static_cast<size_t>(context.parms().poly_modulus().coeff_count());
+        size_t coeff_mod_count = context.parms().coeff_modulus().size();
+        size_t bsk_base_mod_count = static_cast<size_t>(context.base_converter_->bsk_base_mod_count());
+
+        // The largest operation is multiply_relinearize of two size 2 ciphertexts in NTT form:
+        // the BEHZ product needs the inputs in coefficient form, base conversion scratch for
+        // each of the four input polys, their images in Bsk U {m_tilde} and Bsk, the three
+        // product polys in both bases and in fast_floor input layout, the Karatsuba sums, and 
+        // the fast_floor result; the key switching that follows needs the last product poly,
+        // its result, and the decomposition temporaries
+        size_t behz_uint64_count = coeff_count * (
+            4 * coeff_mod_count                 // Inputs in coefficient form
+            + 4 * (coeff_mod_count + 2)         // Base conversion temporaries
+            + 4 * (bsk_base_mod_count + 1)      // Inputs in Bsk U {m_tilde}
+            + 4 * bsk_base_mod_count            // Inputs in Bsk
+            + 3 * (coeff_mod_count + bsk_base_mod_count)    // Product
+            + 2 * (coeff_mod_count + bsk_base_mod_count)    // Karatsuba sums
+            + 3 * (coeff_mod_count + bsk_base_mod_count)    // Scaled product for fast_floor
+            + 3 * bsk_base_mod_count);          // Result of fast_floor
+        size_t relin_uint64_count = coeff_count * (
+            coeff_mod_count                     // Last product poly
+            + 2 * coeff_mod_count               // Key switching result
+            + 6 * coeff_mod_count);             // Decomposition temporaries
+        capacity_ = behz_uint64_count + relin_uint64_count;
+        data_ = allocate_uint(static_cast<int>(capacity_), pool_);
+    }
+
+    EvaluatorWorkspace::EvaluatorWorkspace(const EncryptionParameters::hash_block_type &hash_block,
+        const MemoryPoolHandle &pool) : pool_(pool), hash_block_(hash_block)
+    {
+    }
+
+    uint64_t *EvaluatorWorkspace::get_zero_uint(size_t uint64_count)
+    {
+        uint64_t *result = get_uint(uint64_count);
+        set_zero_uint(static_cast<int>(uint64_count), result);
+        return result;
+    }
+
+    uint64_t *EvaluatorWorkspace::get_overflow(size_t uint64_count)
+    {
+        overflow_.emplace_back(allocate_uint(static_cast<int>(uint64_count), pool_));
+        return overflow_.back().get();
+    }
+
+    void EvaluatorWorkspace::reset()
+    {
+        // Grow to the peak usage if the last operation did not fit; a workspace with no
+        // capacity stands in for a memory pool and never grows
+        if (!overflow_.empty())
+        {
+            overflow_.clear();
+            if (capacity_ > 0)
+            {
+                data_ = allocate_uint(static_cast<int>(used_), pool_);
+                capacity_ = used_;
+            }
+        }
+        used_ = 0;
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "seal/context.h"
+#include "seal/encryptionparams.h"
+#include "seal/memorypoolhandle.h"
+#include "seal/util/mempool.h"
+
+namespace seal
+{
+    /**
+    Scratch memory for the heavy operations of Evaluator. Multiplication, relinearization,
+    and rotations of ciphertexts need a few dozen temporary polynomials per call. When these
+    functions are given an EvaluatorWorkspace instead of a MemoryPoolHandle, they take all
+    their temporary polynomials from the single allocation owned by the workspace, and do
+    not interact with any memory pool at all. This avoids contention on a shared pool when
+    many threads evaluate at the same time, and keeps the temporaries in the same memory
+    from call to call.
+
+    @par Sizing
+    The workspace is sized on construction for multiplying, relinearizing, and rotating
+    ciphertexts of size 2 under the given encryption parameters, in either coefficient or
+    NTT form. An operation on larger ciphertexts that does not fit takes the missing memory
+    from the memory pool of the workspace, and the workspace then grows at the start of the
+    next operation to fit it, so that repeating the same operation again needs no further
+    allocations.
+
+    @par Thread Safety
+    A workspace can be used by only one operation at a time. Threads evaluating concurrently
+    should each use their own workspace; an Evaluator itself can be shared by all of them.
+
+    @see Evaluator for the operations that accept a workspace.
+    */
+    class EvaluatorWorkspace
+    {
+    public:
+        /**
+        Creates a workspace for the encryption parameters of the given SEALContext. The memory
+        of the workspace is allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] context The SEALContext
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encryption parameters are not valid
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        EvaluatorWorkspace(const SEALContext &context,
+            const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
+
+        /**
+        Creates a new workspace by moving a given one.
+
+        @param[in] source The workspace to move from
+        */
+        EvaluatorWorkspace(EvaluatorWorkspace &&source) = default;
+
+        /**
+        Moves a given workspace to the current one.
+
+        @param[in] assign The workspace to move from
+        */
+        EvaluatorWorkspace &operator =(EvaluatorWorkspace &&assign) = default;
+
+        /**
+        Returns the number of 64-bit words currently allocated for the workspace.
+        */
+        inline std::size_t uint64_count() const
+        {
+            return capacity_;
+        }
+
+        /**
+        Returns a reference to the hash block of the encryption parameters the workspace
+        was created for.
+
+        @see EncryptionParameters for more information about the hash block.
+        */
+        inline const EncryptionParameters::hash_block_type &hash_block() const
+        {
+            return hash_block_;
+        }
+
+    private:
+        EvaluatorWorkspace(const EncryptionParameters::hash_block_type &hash_block,
+            const MemoryPoolHandle &pool);
+
+        EvaluatorWorkspace(const EvaluatorWorkspace &copy) = delete;
+
+        EvaluatorWorkspace &operator =(const EvaluatorWorkspace &assign) = delete;
+
+        /**
+        Returns uninitialized memory for uint64_count words that stays valid until the next 
+        reset.
+        */
+        inline std::uint64_t *get_uint(std::size_t uint64_count)
+        {
+            std::size_t offset = used_;
+            used_ += uint64_count;
+            if (used_ <= capacity_)
+            {
+                return data_.get() + offset;
+            }
+            return get_overflow(uint64_count);
+        }
+
+        /**
+        Returns memory for uint64_count words set to zero that stays valid until the next 
+        reset.
+        */
+        std::uint64_t *get_zero_uint(std::size_t uint64_count);
+
+        inline std::uint64_t *get_poly(int coeff_count, int coeff_uint64_count)
+        {
+            return get_uint(static_cast<std::size_t>(coeff_count) * coeff_uint64_count);
+        }
+
+        inline std::uint64_t *get_zero_poly(int coeff_count, int coeff_uint64_count)
+        {
+            return get_zero_uint(static_cast<std::size_t>(coeff_count) * coeff_uint64_count);
+        }
+
+        std::uint64_t *get_overflow(std::size_t uint64_count);
+
+        /**
+        Releases all memory handed out since the last reset, and grows the workspace if it
+        did not fit everything.
+        */
+        void reset();
+
+        MemoryPoolHandle pool_;
+
+        EncryptionParameters::hash_block_type hash_block_;
+
+        util::Pointer data_;
+
+        std::size_t capacity_ = 0;
+
+        std::size_t used_ = 0;
+
+        std::vector<util::Pointer> overflow_;
+
+        friend class Evaluator;
+    };
+}
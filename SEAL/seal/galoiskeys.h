@@ -30,6 +30,13 @@ namespace seal
     to optimize the dbc to be as large as possible for performance. The dbc is upper-bounded 
     by the value of 60, and lower-bounded by the value of 1.
 
+    @par RNS Digits
+    Galois keys generated with KeyGenerator::generate_rns_galois_keys have a decomposition
+    bit count of 0, and decompose the ciphertexts into their residues modulo each of the
+    primes in the coefficient modulus instead of into bits. With a ciphertext at a lower 
+    level of the modulus switching chain the primes that have been switched away act as 
+    special primes, exactly as with EvaluationKeys.
+
     @par Thread Safety
     In general, reading from GaloisKeys is thread-safe as long as no other thread is 
     concurrently mutating it. This is due to the underlying data structure storing the
@@ -36,11 +36,7 @@ namespace seal
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
         int coeff_mod_count = parms_.coeff_modulus().size();
 
-        for (int i = 0; i < coeff_mod_count; i++)
-        {
-            small_ntt_tables_.emplace_back(util::SmallNTTTables(pool_));
-
-        }
+        // Share SmallNTTTables with the context
         small_ntt_tables_ = context.small_ntt_tables_;
 
         // Initialize public and secret key.
@@ -85,8 +81,7 @@ namespace seal
         int poly_coeff_uint64_count = parms_.poly_modulus().coeff_uint64_count();
         int coeff_mod_count = parms_.coeff_modulus().size();
 
-        // Set SmallNTTTables
-        small_ntt_tables_.resize(coeff_mod_count, pool_);
+        // Share SmallNTTTables with the context
         small_ntt_tables_ = context.small_ntt_tables_;
 
         // Initialize public and secret key.
@@ -131,10 +126,10 @@ namespace seal
         for (int i = 0; i < coeff_mod_count; i++)
         {
             // Transform the secret s into NTT representation. 
-            ntt_negacyclic_harvey(secret_key + (i * coeff_count), small_ntt_tables_[i]);
+            ntt_negacyclic_harvey(secret_key + (i * coeff_count), (*small_ntt_tables_)[i]);
 
             // Transform the uniform random polynomial a into NTT representation. 
-            ntt_negacyclic_harvey_lazy(public_key_1 + (i * coeff_count), small_ntt_tables_[i]);
+            ntt_negacyclic_harvey_lazy(public_key_1 + (i * coeff_count), (*small_ntt_tables_)[i]);
         }
 
         Pointer noise(allocate_poly(coeff_count, coeff_mod_count, pool_));
@@ -142,7 +137,7 @@ namespace seal
         for (int i = 0; i < coeff_mod_count; i++)
         {
             // Transform the noise e into NTT representation.
-            ntt_negacyclic_harvey(noise.get() + (i * coeff_count), small_ntt_tables_[i]);
+            ntt_negacyclic_harvey(noise.get() + (i * coeff_count), (*small_ntt_tables_)[i]);
 
             // The inputs are not reduced but that's OK. We are only at most at 122 bits
             // and barrett_reduce_128 can deal with that.
@@ -192,6 +187,30 @@ namespace seal
             throw invalid_argument("decomposition_bit_count is not in the valid range");
         }
 
+        create_evaluation_keys(decomposition_bit_count, count, evaluation_keys);
+    }
+
+    void KeyGenerator::generate_rns_evaluation_keys(int count, EvaluationKeys &evaluation_keys)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!generated_)
+        {
+            throw logic_error("cannot generate evaluation keys for unspecified secret key");
+        }
+
+        // Validate parameters
+        if (count <= 0)
+        {
+            throw invalid_argument("count must be positive");
+        }
+
+        // A decomposition bit count of 0 denotes one digit per prime
+        create_evaluation_keys(0, count, evaluation_keys);
+    }
+
+    void KeyGenerator::create_evaluation_keys(int decomposition_bit_count, int count, 
+        EvaluationKeys &evaluation_keys)
+    {
         // Clear current evaluation keys
         evaluation_keys.mutable_data().clear();
 
@@ -244,7 +263,7 @@ namespace seal
                     set_poly_coeffs_uniform(eval_keys_second, random.get());
                     for (int j = 0; j < coeff_mod_count; j++)
                     {
-                        ntt_negacyclic_harvey_lazy(eval_keys_second + (j * coeff_count), small_ntt_tables_[j]);
+                        ntt_negacyclic_harvey_lazy(eval_keys_second + (j * coeff_count), (*small_ntt_tables_)[j]);
 
                         // calculate a_i*s and store in evaluation_keys_[k].first[i]
                         dyadic_product_coeffmod(eval_keys_second + (j * coeff_count), 
@@ -256,7 +275,7 @@ namespace seal
                     set_poly_coeffs_normal(noise.get(), random.get());
                     for (int j = 0; j < coeff_mod_count; j++)
                     {
-                        ntt_negacyclic_harvey(noise.get() + (j * coeff_count), small_ntt_tables_[j]);
+                        ntt_negacyclic_harvey(noise.get() + (j * coeff_count), (*small_ntt_tables_)[j]);
 
                         // add e_i into evaluation_keys_[k].first[i]
                         add_poly_poly_coeffmod(noise.get() + (j * coeff_count), eval_keys_first + (j * coeff_count), 
@@ -304,6 +323,28 @@ namespace seal
             throw invalid_argument("decomposition_bit_count is not on the valid range");
         }
 
+        create_galois_keys(decomposition_bit_count, galois_elts, galois_keys);
+    }
+
+    void KeyGenerator::generate_rns_galois_keys(const vector<uint64_t> &galois_elts, GaloisKeys &galois_keys)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!generated_)
+        {
+            throw logic_error("cannot generate galois keys for unspecified secret key");
+        }
+        if (!qualifiers_.enable_batching)
+        {
+            throw logic_error("encryption parameters are not valid for batching");
+        }
+
+        // A decomposition bit count of 0 denotes one digit per prime
+        create_galois_keys(0, galois_elts, galois_keys);
+    }
+
+    void KeyGenerator::create_galois_keys(int decomposition_bit_count, const vector<uint64_t> &galois_elts, 
+        GaloisKeys &galois_keys)
+    {
         // Clear the current keys
         galois_keys.mutable_data().clear();
 
@@ -338,11 +379,11 @@ namespace seal
             {
                 // Permute_ntt_poly_smallmod(secret_key_.data().pointer() + i * coeff_count, coeff_count - 1, galois_elt, 
                 // rotated_secret_key.get() + i * coeff_count);
-                inverse_ntt_negacyclic_harvey(secret_key_.mutable_data().pointer() + i * coeff_count, small_ntt_tables_[i]);
+                inverse_ntt_negacyclic_harvey(secret_key_.mutable_data().pointer() + i * coeff_count, (*small_ntt_tables_)[i]);
                 apply_galois(secret_key_.mutable_data().pointer() + i * coeff_count, get_power_of_two(coeff_count - 1), galois_elt, 
                     parms_.coeff_modulus()[i], rotated_secret_key.get() + i * coeff_count);
-                ntt_negacyclic_harvey(secret_key_.mutable_data().pointer() + i * coeff_count, small_ntt_tables_[i]);
-                ntt_negacyclic_harvey(rotated_secret_key.get() + (i * coeff_count), small_ntt_tables_[i]);
+                ntt_negacyclic_harvey(secret_key_.mutable_data().pointer() + i * coeff_count, (*small_ntt_tables_)[i]);
+                ntt_negacyclic_harvey(rotated_secret_key.get() + (i * coeff_count), (*small_ntt_tables_)[i]);
             }
 
             // Initialize galois key
@@ -379,7 +420,7 @@ namespace seal
                     for (int j = 0; j < coeff_mod_count; j++)
                     {
                         // a_i in NTT form
-                        ntt_negacyclic_harvey(eval_keys_second + (j * coeff_count), small_ntt_tables_[j]);
+                        ntt_negacyclic_harvey(eval_keys_second + (j * coeff_count), (*small_ntt_tables_)[j]);
                         // calculate a_i*s and store in evaluation_keys_[k].first[i]
                         dyadic_product_coeffmod(eval_keys_second + (j * coeff_count), secret_key_.data().pointer() + (j * coeff_count), 
                             coeff_count, parms_.coeff_modulus()[j], eval_keys_first + (j * coeff_count));
@@ -389,7 +430,7 @@ namespace seal
                     set_poly_coeffs_normal(noise.get(), random.get());
                     for (int j = 0; j < coeff_mod_count; j++)
                     {
-                        ntt_negacyclic_harvey(noise.get() + (j * coeff_count), small_ntt_tables_[j]);
+                        ntt_negacyclic_harvey(noise.get() + (j * coeff_count), (*small_ntt_tables_)[j]);
 
                         //add NTT(e_i) into evaluation_keys_[k].first[i]
                         add_poly_poly_coeffmod(noise.get() + (j * coeff_count), eval_keys_first + (j * coeff_count), 
@@ -437,6 +478,97 @@ namespace seal
             throw invalid_argument("decomposition_bit_count is not in the valid range");
         }
 
+        generate_galois_keys(decomposition_bit_count, default_galois_elts(), galois_keys);
+    }
+
+    void KeyGenerator::generate_rns_galois_keys(GaloisKeys &galois_keys)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!generated_)
+        {
+            throw logic_error("cannot generate galois keys for unspecified secret key");
+        }
+        if (!qualifiers_.enable_batching)
+        {
+            throw logic_error("encryption parameters are not valid for batching");
+        }
+
+        generate_rns_galois_keys(default_galois_elts(), galois_keys);
+    }
+
+    void KeyGenerator::generate_sum_slots_galois_keys(int decomposition_bit_count, GaloisKeys &galois_keys)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!generated_)
+        {
+            throw logic_error("cannot generate galois keys for unspecified secret key");
+        }
+        if (!qualifiers_.enable_batching)
+        {
+            throw logic_error("encryption parameters are not valid for batching");
+        }
+
+        // Check that decomposition_bit_count is in correct interval
+        if (decomposition_bit_count < SEAL_DBC_MIN || decomposition_bit_count > SEAL_DBC_MAX)
+        {
+            throw invalid_argument("decomposition_bit_count is not in the valid range");
+        }
+
+        generate_galois_keys(decomposition_bit_count, sum_slots_galois_elts(), galois_keys);
+    }
+
+    void KeyGenerator::generate_rns_sum_slots_galois_keys(GaloisKeys &galois_keys)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!generated_)
+        {
+            throw logic_error("cannot generate galois keys for unspecified secret key");
+        }
+        if (!qualifiers_.enable_batching)
+        {
+            throw logic_error("encryption parameters are not valid for batching");
+        }
+
+        generate_rns_galois_keys(sum_slots_galois_elts(), galois_keys);
+    }
+
+    vector<uint64_t> KeyGenerator::sum_slots_galois_elts() const
+    {
+        uint64_t n = parms_.poly_modulus().coeff_count() - 1;
+        uint64_t m = n << 1;
+        uint64_t row_size = n >> 1;
+
+        // Row rotation by s steps to the left is X -> X^{3^s}
+        vector<uint64_t> galois_elts;
+        uint64_t step = 1;
+        uint64_t step_elt = 3;
+        while (step < row_size)
+        {
+            if ((row_size >> 2) >= step)
+            {
+                // Rotations by s, 2s, and 3s share one round
+                uint64_t step_elt_squared = (step_elt * step_elt) & (m - 1);
+                galois_elts.push_back(step_elt);
+                galois_elts.push_back(step_elt_squared);
+                galois_elts.push_back((step_elt_squared * step_elt) & (m - 1));
+                step <<= 2;
+                step_elt = (step_elt_squared * step_elt_squared) & (m - 1);
+            }
+            else
+            {
+                galois_elts.push_back(step_elt);
+                step <<= 1;
+            }
+        }
+
+        // Swap the rows (X -> X^{m-1})
+        galois_elts.push_back(m - 1);
+
+        return galois_elts;
+    }
+
+    vector<uint64_t> KeyGenerator::default_galois_elts() const
+    {
         int coeff_count = parms_.poly_modulus().coeff_count();
         int n = coeff_count - 1;
         int m = n << 1;
@@ -463,7 +595,7 @@ namespace seal
             neg_two_power_of_three &= (m - 1);
         }
 
-        generate_galois_keys(decomposition_bit_count, logn_galois_keys, galois_keys);
+        return logn_galois_keys;
     }
 
     void KeyGenerator::set_poly_coeffs_zero_one_negone(uint64_t *poly, UniformRandomGenerator *random) const
@@ -693,7 +825,8 @@ namespace seal
                 decomposition_factors[i].emplace_back(current_decomposition_factor);
                 //multiply 2^w mod q_i
                 current_decomposition_factor = multiply_uint_uint_mod(current_decomposition_factor, power_of_w, parms_.coeff_modulus()[i]);
-                current_smallmod >>= decomposition_bit_count;
+                // With RNS digits the whole residue is a single digit
+                current_smallmod = decomposition_bit_count ? current_smallmod >> decomposition_bit_count : 0;
             }
         }
 
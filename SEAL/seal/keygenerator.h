@@ -108,6 +108,94 @@ namespace seal
         */        
         void generate_galois_keys(int decomposition_bit_count, GaloisKeys &galois_keys);
 
+        /**
+        Generates Galois keys for the given Galois elements only. Rotations whose Galois
+        element has no key are composed by the Evaluator from the fewest keys present.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] galois_elts The Galois elements to generate keys for
+        @param[out] galois_keys The Galois keys instance to overwrite with the generated keys
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if a Galois element is not valid
+        @throws std::logic_error if the encryption parameters do not support batching
+        */
+        void generate_galois_keys(int decomposition_bit_count, 
+            const std::vector<std::uint64_t> &galois_elts, GaloisKeys &galois_keys);
+
+        /**
+        Generates the specified number of evaluation keys that decompose ciphertexts into 
+        their residues modulo the primes in the coefficient modulus instead of into bits. 
+        The generated keys have a decomposition bit count of 0.
+
+        @param[in] count The number of evaluation keys to generate
+        @param[out] evaluation_keys The evaluation keys instance to overwrite with the 
+        generated keys
+        @throws std::invalid_argument if count is negative
+        @see EvaluationKeys for more details on RNS digits.
+        */
+        void generate_rns_evaluation_keys(int count, EvaluationKeys &evaluation_keys);
+
+        /**
+        Generates evaluation keys containing one key that decomposes ciphertexts into their 
+        residues modulo the primes in the coefficient modulus.
+
+        @param[out] evaluation_keys The evaluation keys instance to overwrite with the
+        generated keys
+        */
+        inline void generate_rns_evaluation_keys(EvaluationKeys &evaluation_keys)
+        {
+            generate_rns_evaluation_keys(1, evaluation_keys);
+        }
+
+        /**
+        Generates Galois keys that decompose ciphertexts into their residues modulo the 
+        primes in the coefficient modulus instead of into bits. The generated keys have a 
+        decomposition bit count of 0.
+
+        @param[out] galois_keys The Galois keys instance to overwrite with the generated keys
+        @throws std::logic_error if the encryption parameters do not support batching
+        @see GaloisKeys for more details on RNS digits.
+        */
+        void generate_rns_galois_keys(GaloisKeys &galois_keys);
+
+        /**
+        Generates Galois keys for the given Galois elements only, decomposing ciphertexts
+        into their residues modulo the primes in the coefficient modulus.
+
+        @param[in] galois_elts The Galois elements to generate keys for
+        @param[out] galois_keys The Galois keys instance to overwrite with the generated keys
+        @throws std::invalid_argument if a Galois element is not valid
+        @throws std::logic_error if the encryption parameters do not support batching
+        */
+        void generate_rns_galois_keys(const std::vector<std::uint64_t> &galois_elts, 
+            GaloisKeys &galois_keys);
+
+        /**
+        Generates exactly the Galois keys needed by Evaluator::sum_slots and 
+        Evaluator::replicate_slot to share the decomposition of the ciphertext in every 
+        round of rotations: keys for the row rotations by s, 2s, and 3s for s a power of 
+        four, a key for the last round when N/2 is not a power of four, where N is the 
+        degree of the polynomial modulus, and a key for swapping the rows.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[out] galois_keys The Galois keys instance to overwrite with the generated keys
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::logic_error if the encryption parameters do not support batching
+        */
+        void generate_sum_slots_galois_keys(int decomposition_bit_count, GaloisKeys &galois_keys);
+
+        /**
+        Generates exactly the Galois keys needed by Evaluator::sum_slots and 
+        Evaluator::replicate_slot to share the decomposition of the ciphertext in every 
+        round of rotations, decomposing ciphertexts into their residues modulo the primes 
+        in the coefficient modulus.
+
+        @param[out] galois_keys The Galois keys instance to overwrite with the generated keys
+        @throws std::logic_error if the encryption parameters do not support batching
+        @see generate_sum_slots_galois_keys(int, GaloisKeys&) for the keys generated.
+        */
+        void generate_rns_sum_slots_galois_keys(GaloisKeys &galois_keys);
+
     private:
         KeyGenerator(const KeyGenerator &copy) = delete;
 
@@ -125,9 +213,30 @@ namespace seal
 
         void compute_secret_key_array(int max_power);
 
+        /**
+        Computes the decomposition factors for each prime; a decomposition bit count of 0
+        gives a single factor per prime for RNS digits.
+        */
         void populate_decomposition_factors(int decomposition_bit_count, 
             std::vector<std::vector<std::uint64_t> > &decomposition_factors);
 
+        void create_evaluation_keys(int decomposition_bit_count, int count, 
+            EvaluationKeys &evaluation_keys);
+
+        void create_galois_keys(int decomposition_bit_count, 
+            const std::vector<std::uint64_t> &galois_elts, GaloisKeys &galois_keys);
+
+        /**
+        Returns the Galois elements of the keys generated by default, which allow rotating
+        the rows by any power of two in either direction, and swapping the rows.
+        */
+        std::vector<std::uint64_t> default_galois_elts() const;
+
+        /**
+        Returns the Galois elements for the rounds of rotations of Evaluator::sum_slots.
+        */
+        std::vector<std::uint64_t> sum_slots_galois_elts() const;
+
         /**
         Generates new matching set of secret key and public key.
         */
@@ -141,9 +250,6 @@ namespace seal
             return generated_;
         }
 
-        void generate_galois_keys(int decomposition_bit_count, 
-            const std::vector<std::uint64_t> &galois_elts, GaloisKeys &galois_keys);
-
         inline GaloisKeys generate_galois_keys(int decomposition_bit_count, 
             const std::vector<std::uint64_t> &galois_elts)
         {
@@ -158,7 +264,7 @@ namespace seal
 
         EncryptionParameterQualifiers qualifiers_;
 
-        std::vector<util::SmallNTTTables> small_ntt_tables_;
+        std::shared_ptr<const std::vector<util::SmallNTTTables>> small_ntt_tables_;
 
         PublicKey public_key_;
 
@@ -0,0 +1,131 @@
+#include <stdexcept>
+#include "seal/lineartransform.h"
+#include "seal/evaluator.h"
+#include "seal/polycrt.h"
+#include "seal/util/galoistables.h"
+#include "seal/util/uintcore.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    LinearTransform::LinearTransform(Evaluator &evaluator, const vector<vector<uint64_t> > &matrix,
+        const MemoryPoolHandle &pool) :
+        hash_block_(evaluator.parms_.hash_block()),
+        coeff_count_(evaluator.parms_.poly_modulus().coeff_count())
+    {
+        int row_size = (coeff_count_ - 1) >> 1;
+        uint64_t plain_modulus = evaluator.parms_.plain_modulus().value();
+
+        // Verify parameters
+        if (!evaluator.poly_crt_builder_)
+        {
+            throw invalid_argument("encryption parameters are not valid for batching");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (matrix.size() > static_cast<size_t>(row_size))
+        {
+            throw invalid_argument("matrix has too many rows");
+        }
+        for (size_t i = 0; i < matrix.size(); i++)
+        {
+            if (matrix[i].size() > static_cast<size_t>(row_size))
+            {
+                throw invalid_argument("matrix row has too many entries");
+            }
+            for (auto entry : matrix[i])
+            {
+                if (entry >= plain_modulus)
+                {
+                    throw invalid_argument("matrix entry is larger than plain_modulus");
+                }
+            }
+        }
+
+        // About sqrt(N/2) baby steps, rounded up to a power of two
+        baby_step_count_ = 1 << ((get_power_of_two(row_size) + 1) >> 1);
+        giant_step_count_ = row_size / baby_step_count_;
+
+        // Slot t of the diagonal i holds the entry of row t in column t + i; it is rotated
+        // right by the giant step k * b so that rotating the products left by k * b lines
+        // it up again, and is the same in both rows
+        vector<uint64_t> diagonal(2 * row_size);
+        diagonals_.reserve(row_size);
+        for (int i = 0; i < row_size; i++)
+        {
+            int giant_step = i - (i % baby_step_count_);
+            bool is_zero = true;
+            for (int t = 0; t < row_size; t++)
+            {
+                size_t row = (t - giant_step + row_size) % row_size;
+                size_t column = (row + i) % row_size;
+                uint64_t entry = (row < matrix.size() && column < matrix[row].size()) ? matrix[row][column] : 0;
+                diagonal[t] = entry;
+                diagonal[t + row_size] = entry;
+                is_zero = is_zero && (entry == 0);
+            }
+
+            diagonals_.emplace_back(pool);
+            if (!is_zero || i == 0)
+            {
+                evaluator.poly_crt_builder_->compose(diagonal, diagonals_[i]);
+                evaluator.transform_to_ntt(diagonals_[i], pool);
+            }
+        }
+    }
+
+    vector<int> LinearTransform::baby_steps() const
+    {
+        // A baby step is needed if any of its diagonals is nonzero
+        vector<int> steps;
+        for (int j = 1; j < baby_step_count_; j++)
+        {
+            for (int k = 0; k < giant_step_count_; k++)
+            {
+                if (diagonals_[k * baby_step_count_ + j].coeff_count() > 0)
+                {
+                    steps.push_back(j);
+                    break;
+                }
+            }
+        }
+        return steps;
+    }
+
+    vector<int> LinearTransform::giant_steps() const
+    {
+        // A giant step is needed if any of its diagonals is nonzero
+        vector<int> steps;
+        for (int k = 1; k < giant_step_count_; k++)
+        {
+            for (int j = 0; j < baby_step_count_; j++)
+            {
+                if (diagonals_[k * baby_step_count_ + j].coeff_count() > 0)
+                {
+                    steps.push_back(k * baby_step_count_);
+                    break;
+                }
+            }
+        }
+        return steps;
+    }
+
+    vector<uint64_t> LinearTransform::galois_elts() const
+    {
+        int coeff_count_power = get_power_of_two(coeff_count_ - 1);
+        vector<uint64_t> elts;
+        for (int step : baby_steps())
+        {
+            elts.push_back(row_rotation_galois_elt(step, coeff_count_power));
+        }
+        for (int step : giant_steps())
+        {
+            elts.push_back(row_rotation_galois_elt(step, coeff_count_power));
+        }
+        return elts;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "seal/encryptionparams.h"
+#include "seal/memorypoolhandle.h"
+#include "seal/plaintext.h"
+
+namespace seal
+{
+    class Evaluator;
+
+    /**
+    A plaintext matrix prepared for multiplying encrypted vectors with Evaluator::linear_transform.
+    When batching is used, the matrix is applied to each of the two rows of the encrypted
+    2-by-(N/2) plaintext matrix, where N is the degree of the polynomial modulus: row i of the
+    result holds the product of the matrix with row i of the input, as a vector of length N/2.
+
+    @par Diagonal Method
+    The product is computed with the diagonal method of Halevi and Shoup, as the sum of the
+    generalized diagonals of the matrix multiplied slot-wise with the input vector rotated by
+    the index of the diagonal. The rotations are split into baby steps and giant steps: the
+    input is rotated by each baby step j < b, sharing one decomposition of the ciphertext as
+    Evaluator::rotate_rows_many does, and each giant step k rotates the sum of the products
+    of the diagonals k*b + j with the baby steps. This takes about 2*sqrt(N/2) rotations
+    instead of N/2. The diagonals are pre-rotated by their giant step, encoded with
+    PolyCRTBuilder, and transformed to NTT form once on construction, and diagonals that are
+    zero are skipped along with the rotations only they need.
+
+    @par Galois Keys
+    The Galois keys for the rotations used are returned by galois_elts, and can be generated
+    with KeyGenerator::generate_galois_keys. Rotations whose Galois key is not present are
+    composed from other keys, which is slower.
+
+    @see Evaluator::linear_transform for multiplying an encrypted vector with the matrix.
+    @see PolyCRTBuilder for more details on batching.
+    */
+    class LinearTransform
+    {
+    public:
+        /**
+        Creates a LinearTransform from a given matrix with entries modulo the plaintext
+        modulus, for use with the given Evaluator and its encryption parameters. The matrix
+        can have at most N/2 rows of at most N/2 entries, where N is the degree of the
+        polynomial modulus, and missing entries are zero. The diagonals are encoded and
+        transformed to NTT form with the Evaluator. Dynamically allocated member variables
+        are allocated from the memory pool pointed to by the given MemoryPoolHandle. By
+        default the global memory pool is used.
+
+        @param[in] evaluator The Evaluator to prepare the matrix for
+        @param[in] matrix The rows of the matrix
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid for batching
+        @throws std::invalid_argument if matrix has too many rows or a row has too many
+        entries
+        @throws std::invalid_argument if an entry of matrix is not less than the plaintext
+        modulus
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        LinearTransform(Evaluator &evaluator,
+            const std::vector<std::vector<std::uint64_t> > &matrix,
+            const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
+
+        /**
+        Returns the number of baby steps b. Giant steps rotate by multiples of b.
+        */
+        inline int baby_step_count() const
+        {
+            return baby_step_count_;
+        }
+
+        /**
+        Returns the number of giant steps.
+        */
+        inline int giant_step_count() const
+        {
+            return giant_step_count_;
+        }
+
+        /**
+        Returns the Galois elements of the row rotations used by Evaluator::linear_transform
+        for this matrix.
+        */
+        std::vector<std::uint64_t> galois_elts() const;
+
+        /**
+        Returns a reference to the hash block of the encryption parameters the matrix was
+        prepared for.
+
+        @see EncryptionParameters for more information about the hash block.
+        */
+        inline const EncryptionParameters::hash_block_type &hash_block() const
+        {
+            return hash_block_;
+        }
+
+    private:
+        // The baby steps j > 0 and the giant steps k * b > 0 with a nonzero diagonal; these
+        // are the rotations Evaluator::linear_transform performs
+        std::vector<int> baby_steps() const;
+
+        std::vector<int> giant_steps() const;
+
+        EncryptionParameters::hash_block_type hash_block_;
+
+        int coeff_count_ = 0;
+
+        int baby_step_count_ = 0;
+
+        int giant_step_count_ = 0;
+
+        // The diagonal k * b + j in NTT form, rotated right by k * b, at index k * b + j;
+        // diagonals that are zero are left empty, except the first
+        std::vector<Plaintext> diagonals_;
+
+        friend class Evaluator;
+    };
+}
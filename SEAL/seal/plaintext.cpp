@@ -108,6 +108,9 @@ namespace seal
             throw logic_error("cannot resize aliased Plaintext");
         }
 
+        // The coefficients no longer hold a transformed polynomial
+        is_ntt_form_ = false;
+
         // If is_alias() we will always hit this
         if (coeff_count <= capacity_)
         {
@@ -342,6 +345,8 @@ namespace seal
     {
         int32_t coeff_count32 = static_cast<int32_t>(coeff_count_);
         stream.write(reinterpret_cast<const char*>(&coeff_count32), sizeof(int32_t));
+        int32_t is_ntt_form32 = static_cast<int32_t>(is_ntt_form_);
+        stream.write(reinterpret_cast<const char*>(&is_ntt_form32), sizeof(int32_t));
         stream.write(reinterpret_cast<const char*>(plaintext_poly_.get()), coeff_count_ * bytes_per_uint64);
     }
 
@@ -349,9 +354,12 @@ namespace seal
     {
         int32_t read_coeff_count = 0;
         stream.read(reinterpret_cast<char*>(&read_coeff_count), sizeof(int32_t));
+        int32_t read_is_ntt_form32 = 0;
+        stream.read(reinterpret_cast<char*>(&read_is_ntt_form32), sizeof(int32_t));
 
         // Set new size
         resize(read_coeff_count);
+        is_ntt_form_ = (read_is_ntt_form32 != 0);
         
         // Read data
         stream.read(reinterpret_cast<char*>(plaintext_poly_.get()), read_coeff_count * bytes_per_uint64);
@@ -201,6 +201,7 @@ namespace seal
         {
             // Copy over value
             util::set_uint_uint(copy.plaintext_poly_.get(), coeff_count_, plaintext_poly_.get());
+            is_ntt_form_ = copy.is_ntt_form_;
         }
 
         /**
@@ -398,6 +399,7 @@ namespace seal
             // Size is guaranteed to be OK now so copy over
             // Note: set_uint_uint checks if the value pointers are equal and makes a copy only if they are not
             util::set_uint_uint(assign.plaintext_poly_.get(), coeff_count_, plaintext_poly_.get());
+            is_ntt_form_ = assign.is_ntt_form_;
 
             return *this;
         }
@@ -664,6 +666,19 @@ namespace seal
             return util::get_nonzero_coeff_count_poly(plaintext_poly_.get(), coeff_count_, 1);
         }
 
+        /**
+        Returns whether the plaintext is in NTT form, i.e. whether it holds the plaintext 
+        polynomial lifted to each prime in the coefficient modulus and transformed to the NTT 
+        domain, as produced by Evaluator::transform_to_ntt. Such a plaintext has coefficient 
+        count equal to the degree of the polynomial modulus times the number of primes, and 
+        can be passed to Evaluator::multiply_plain repeatedly without being transformed again. 
+        Resizing the plaintext or assigning a new value to it returns it to coefficient form.
+        */
+        inline bool is_ntt_form() const
+        {
+            return is_ntt_form_;
+        }
+
         /**
         Returns a human-readable string description of the plaintext polynomial.
 
@@ -700,6 +715,11 @@ namespace seal
         */
         void load(std::istream &stream);
 
+        /**
+        Enables access to private members of seal::Plaintext for .NET wrapper.
+        */
+        struct PlaintextPrivateHelper;
+
     private:
         MemoryPoolHandle pool_;
 
@@ -708,5 +728,9 @@ namespace seal
         int coeff_count_ = 0;
 
         util::Pointer plaintext_poly_;
+
+        bool is_ntt_form_ = false;
+
+        friend class Evaluator;
     };
 }
\ No newline at end of file
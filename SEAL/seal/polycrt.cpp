@@ -15,7 +15,7 @@ namespace seal
 {
     PolyCRTBuilder::PolyCRTBuilder(const SEALContext &context, const MemoryPoolHandle &pool) :
         pool_(pool), parms_(context.parms()),
-        ntt_tables_(pool_),
+        ntt_tables_(context.plain_ntt_tables_),
         slots_(parms_.poly_modulus().coeff_count() - 1),
         qualifiers_(context.qualifiers())
     {
@@ -43,9 +43,6 @@ namespace seal
         // Reserve space for all of the primitive roots
         roots_of_unity_ = allocate_uint(slots_, pool_);
 
-        // Copy over NTT tables (switching to local pool)
-        ntt_tables_ = context.plain_ntt_tables_;
-
         // Fill the vector of roots of unity with all distinct odd powers of generator.
         // These are all the primitive (2*slots_)-th roots of unity in integers modulo parms_.plain_modulus().
         populate_roots_of_unity_vector();
@@ -74,8 +71,8 @@ namespace seal
 
     void PolyCRTBuilder::populate_roots_of_unity_vector()
     {
-        uint64_t generator_sq = multiply_uint_uint_mod(ntt_tables_.get_root(), ntt_tables_.get_root(), mod_);
-        roots_of_unity_[0] = ntt_tables_.get_root();
+        uint64_t generator_sq = multiply_uint_uint_mod(ntt_tables_->get_root(), ntt_tables_->get_root(), mod_);
+        roots_of_unity_[0] = ntt_tables_->get_root();
 
         for (int i = 0; i < slots_ - 1; i++)
         {
@@ -144,7 +141,7 @@ namespace seal
 
         // Transform destination using inverse of negacyclic NTT
         // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.pointer(), ntt_tables_);
+        inverse_ntt_negacyclic_harvey(destination.pointer(), *ntt_tables_);
     }
 
     void PolyCRTBuilder::compose(const vector<int64_t> &values_matrix, Plaintext &destination)
@@ -185,7 +182,7 @@ namespace seal
 
         // Transform destination using inverse of negacyclic NTT
         // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.pointer(), ntt_tables_);
+        inverse_ntt_negacyclic_harvey(destination.pointer(), *ntt_tables_);
     }
 
     void PolyCRTBuilder::compose(Plaintext &plain, const MemoryPoolHandle &pool)
@@ -232,7 +229,7 @@ namespace seal
 
         // Transform destination using inverse of negacyclic NTT
         // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(plain.pointer(), ntt_tables_);
+        inverse_ntt_negacyclic_harvey(plain.pointer(), *ntt_tables_);
     }
 
     void PolyCRTBuilder::decompose(const Plaintext &plain, vector<uint64_t> &destination,
@@ -271,7 +268,7 @@ namespace seal
         set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
 
         // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), ntt_tables_);
+        ntt_negacyclic_harvey(temp_dest.get(), *ntt_tables_);
 
         // Read top row
         for (int i = 0; i < slots_; i++)
@@ -316,7 +313,7 @@ namespace seal
         set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
 
         // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), ntt_tables_);
+        ntt_negacyclic_harvey(temp_dest.get(), *ntt_tables_);
 
         // Read top row, then bottom row
         uint64_t plain_modulus_div_two = mod_.value() >> 1;
@@ -361,7 +358,7 @@ namespace seal
         set_zero_uint(slots_ - plain_coeff_count, temp.get() + plain_coeff_count);
 
         // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp.get(), ntt_tables_);
+        ntt_negacyclic_harvey(temp.get(), *ntt_tables_);
 
         // Set plain to full slot count size (note that all new coefficients are 
         // set to zero).
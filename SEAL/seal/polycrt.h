@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <vector>
+#include <memory>
 #include "seal/util/common.h"
 #include "seal/util/uintcore.h"
 #include "seal/encryptionparams.h"
@@ -298,7 +299,7 @@ namespace seal
 
         EncryptionParameters parms_;
 
-        util::SmallNTTTables ntt_tables_;
+        std::shared_ptr<const util::SmallNTTTables> ntt_tables_;
 
         SmallModulus mod_;
 
@@ -6,13 +6,16 @@
 #include "seal/chooser.h"
 #include "seal/ciphertext.h"
 #include "seal/context.h"
+#include "seal/contextcache.h"
 #include "seal/decryptor.h"
 #include "seal/encoder.h"
 #include "seal/encryptionparams.h"
 #include "seal/encryptor.h"
 #include "seal/evaluationkeys.h"
 #include "seal/evaluator.h"
+#include "seal/evaluatorworkspace.h"
 #include "seal/keygenerator.h"
+#include "seal/lineartransform.h"
 #include "seal/memorypoolhandle.h"
 #include "seal/plaintext.h"
 #include "seal/polycrt.h"
@@ -371,16 +371,29 @@ namespace seal
             return simulation;
         }
 
-        vector<Simulation> exp_vector(exponent, simulation);
-        return multiply_many(exp_vector, decomposition_bit_count);
-
-        // Binary exponentiation
-        /*
-        if (exponent % 2 == 0)
+        // Same order of operations as in Evaluator::exponentiate
+        vector<Simulation> squares(1, simulation);
+        vector<Simulation> results;
+        if (exponent & 1)
+        {
+            results.push_back(simulation);
+        }
+        for (exponent >>= 1; exponent > 0; exponent >>= 1)
         {
-        return exponentiate(multiply(simulation, simulation), exponent >> 1);
+            squares.emplace_back(relinearize(square(squares.back()), decomposition_bit_count));
+            if (!(exponent & 1))
+            {
+                continue;
+            }
+            if (results.empty())
+            {
+                results.push_back(squares.back());
+            }
+            else
+            {
+                results.emplace_back(relinearize(multiply(results.back(), squares.back()), decomposition_bit_count));
+            }
         }
-        return multiply(exponentiate(multiply(simulation, simulation), (exponent - 1) >> 1), simulation);
-        */
+        return results.back();
     }
 }
\ No newline at end of file
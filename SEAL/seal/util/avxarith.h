@@ -0,0 +1,130 @@
+#pragma once
+
+#include "seal/util/defines.h"
+
+#ifdef SEAL_ENABLE_AVX_NTT
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Helpers for the vectorized kernels in util/smallntt.cpp and util/baseconverter.cpp.
+        Neither AVX2 nor AVX-512F has a 64x64-bit multiplication, so both the low and the 
+        high words are assembled from 32x32-bit partial products. This keeps the vectorized 
+        kernels bit-exact with the scalar code. (The 52-bit IFMA instructions cannot be used 
+        with 64-bit Shoup or Barrett constants.)
+        */
+        SEAL_TARGET_AVX2 inline __m256i mullo_epi64_avx2(__m256i a, __m256i b)
+        {
+            __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+            return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+        }
+
+        SEAL_TARGET_AVX2 inline __m256i mulhi_epu64_avx2(__m256i a, __m256i b)
+        {
+            const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+            __m256i a_hi = _mm256_srli_epi64(a, 32);
+            __m256i b_hi = _mm256_srli_epi64(b, 32);
+            __m256i lolo = _mm256_mul_epu32(a, b);
+            __m256i lohi = _mm256_mul_epu32(a, b_hi);
+            __m256i hilo = _mm256_mul_epu32(a_hi, b);
+            __m256i hihi = _mm256_mul_epu32(a_hi, b_hi);
+            __m256i cross = _mm256_add_epi64(_mm256_srli_epi64(lolo, 32), _mm256_and_si256(lohi, low_mask));
+            cross = _mm256_add_epi64(cross, _mm256_and_si256(hilo, low_mask));
+            __m256i result = _mm256_add_epi64(hihi, _mm256_srli_epi64(lohi, 32));
+            result = _mm256_add_epi64(result, _mm256_srli_epi64(hilo, 32));
+            return _mm256_add_epi64(result, _mm256_srli_epi64(cross, 32));
+        }
+
+        // AVX2 only has signed 64-bit comparisons. Values can exceed 2^63, so flip the 
+        // sign bits to compare as unsigned.
+        SEAL_TARGET_AVX2 inline __m256i cmpgt_epu64_avx2(__m256i a, __m256i b)
+        {
+            const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign_bit), _mm256_xor_si256(b, sign_bit));
+        }
+
+        // Same arithmetic as barrett_reduce_128 on four 128-bit values given by their low 
+        // and high words; const_ratio0 and const_ratio1 are the first two words of 
+        // modulus.const_ratio().
+        SEAL_TARGET_AVX2 inline __m256i barrett_reduce_128_avx2(__m256i input0, __m256i input1, 
+            __m256i const_ratio0, __m256i const_ratio1, __m256i modulus)
+        {
+            // Multiply input and const_ratio
+            // Round 1
+            __m256i carry = mulhi_epu64_avx2(input0, const_ratio0);
+            __m256i tmp1 = _mm256_add_epi64(mullo_epi64_avx2(input0, const_ratio1), carry);
+            __m256i tmp3 = _mm256_sub_epi64(mulhi_epu64_avx2(input0, const_ratio1), cmpgt_epu64_avx2(carry, tmp1));
+
+            // Round 2
+            __m256i tmp2 = mullo_epi64_avx2(input1, const_ratio0);
+            tmp1 = _mm256_add_epi64(tmp1, tmp2);
+            carry = _mm256_sub_epi64(mulhi_epu64_avx2(input1, const_ratio0), cmpgt_epu64_avx2(tmp2, tmp1));
+
+            // This is all we care about
+            tmp1 = _mm256_add_epi64(_mm256_add_epi64(mullo_epi64_avx2(input1, const_ratio1), tmp3), carry);
+
+            // Barrett subtraction
+            tmp3 = _mm256_sub_epi64(input0, mullo_epi64_avx2(tmp1, modulus));
+            return _mm256_sub_epi64(tmp3, _mm256_andnot_si256(cmpgt_epu64_avx2(modulus, tmp3), modulus));
+        }
+
+        SEAL_AVX512_DIAGNOSTIC_PUSH
+
+        SEAL_TARGET_AVX512 inline __m512i mullo_epi64_avx512(__m512i a, __m512i b)
+        {
+            __m512i cross = _mm512_add_epi64(_mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)),
+                _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b));
+            return _mm512_add_epi64(_mm512_mul_epu32(a, b), _mm512_slli_epi64(cross, 32));
+        }
+
+        SEAL_TARGET_AVX512 inline __m512i mulhi_epu64_avx512(__m512i a, __m512i b)
+        {
+            const __m512i low_mask = _mm512_set1_epi64(0xFFFFFFFF);
+            __m512i a_hi = _mm512_srli_epi64(a, 32);
+            __m512i b_hi = _mm512_srli_epi64(b, 32);
+            __m512i lolo = _mm512_mul_epu32(a, b);
+            __m512i lohi = _mm512_mul_epu32(a, b_hi);
+            __m512i hilo = _mm512_mul_epu32(a_hi, b);
+            __m512i hihi = _mm512_mul_epu32(a_hi, b_hi);
+            __m512i cross = _mm512_add_epi64(_mm512_srli_epi64(lolo, 32), _mm512_and_si512(lohi, low_mask));
+            cross = _mm512_add_epi64(cross, _mm512_and_si512(hilo, low_mask));
+            __m512i result = _mm512_add_epi64(hihi, _mm512_srli_epi64(lohi, 32));
+            result = _mm512_add_epi64(result, _mm512_srli_epi64(hilo, 32));
+            return _mm512_add_epi64(result, _mm512_srli_epi64(cross, 32));
+        }
+
+        // Same arithmetic as barrett_reduce_128 on eight 128-bit values given by their low 
+        // and high words; const_ratio0 and const_ratio1 are the first two words of 
+        // modulus.const_ratio().
+        SEAL_TARGET_AVX512 inline __m512i barrett_reduce_128_avx512(__m512i input0, __m512i input1, 
+            __m512i const_ratio0, __m512i const_ratio1, __m512i modulus)
+        {
+            const __m512i one = _mm512_set1_epi64(1);
+
+            // Multiply input and const_ratio
+            // Round 1
+            __m512i carry = mulhi_epu64_avx512(input0, const_ratio0);
+            __m512i tmp1 = _mm512_add_epi64(mullo_epi64_avx512(input0, const_ratio1), carry);
+            __m512i tmp3 = mulhi_epu64_avx512(input0, const_ratio1);
+            tmp3 = _mm512_mask_add_epi64(tmp3, _mm512_cmplt_epu64_mask(tmp1, carry), tmp3, one);
+
+            // Round 2
+            __m512i tmp2 = mullo_epi64_avx512(input1, const_ratio0);
+            tmp1 = _mm512_add_epi64(tmp1, tmp2);
+            carry = mulhi_epu64_avx512(input1, const_ratio0);
+            carry = _mm512_mask_add_epi64(carry, _mm512_cmplt_epu64_mask(tmp1, tmp2), carry, one);
+
+            // This is all we care about
+            tmp1 = _mm512_add_epi64(_mm512_add_epi64(mullo_epi64_avx512(input1, const_ratio1), tmp3), carry);
+
+            // Barrett subtraction
+            tmp3 = _mm512_sub_epi64(input0, mullo_epi64_avx512(tmp1, modulus));
+            return _mm512_mask_sub_epi64(tmp3, _mm512_cmpge_epu64_mask(tmp3, modulus), tmp3, modulus);
+        }
+
+        SEAL_AVX512_DIAGNOSTIC_POP
+    }
+}
+#endif //SEAL_ENABLE_AVX_NTT
@@ -10,6 +10,8 @@
 #include "seal/defaultparams.h"
 #include "seal/util/smallntt.h"
 #include "seal/util/globals.h"
+#include "seal/util/mappedfile.h"
+#include "seal/util/avxarith.h"
 
 using namespace std;
 
@@ -20,6 +22,24 @@ namespace seal
         BaseConverter::BaseConverter(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
             const SmallModulus &small_plain_mod, const MemoryPoolHandle &pool) : pool_(pool)
         {
+            generate(coeff_base, coeff_count, coeff_power, small_plain_mod, nullptr);
+        }
+
+        BaseConverter::BaseConverter(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
+            const SmallModulus &small_plain_mod, const BaseConverter &bsk_tables_source, 
+            const MemoryPoolHandle &pool) : pool_(pool)
+        {
+            if (!bsk_tables_source.generated_ || 
+                bsk_tables_source.bsk_small_ntt_table_[0].coeff_count_power() != coeff_power)
+            {
+                throw invalid_argument("bsk_tables_source does not match coeff_power");
+            }
+            generate(coeff_base, coeff_count, coeff_power, small_plain_mod, &bsk_tables_source);
+        }
+
+        void BaseConverter::generate(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
+            const SmallModulus &small_plain_mod, const BaseConverter *bsk_tables_source)
+        {
 #ifdef SEAL_DEBUG
             if (coeff_base.size() == 0)
             {
@@ -100,12 +120,25 @@ namespace seal
             bsk_base_array_ = aux_base_array_;
             bsk_base_array_.emplace_back(m_sk_);
 
+            // The auxiliary base of a smaller coefficient base is a prefix of that of a larger
+            // one, so its NTT tables can be shared
+            if (bsk_tables_source && bsk_tables_source->aux_base_mod_count_ < aux_base_mod_count_)
+            {
+                throw invalid_argument("bsk_tables_source has too few auxiliary moduli");
+            }
+
             // Generate Bsk U {mtilde} small ntt tables which is used in Evaluator
             int coeff_power_count = coeff_power;
             for (int i = 0; i < bsk_base_mod_count_; i++)
             {
                 bsk_small_ntt_table_.emplace_back(pool_);
-                if (!bsk_small_ntt_table_[i].generate(coeff_power_count, bsk_base_array_[i]))
+                if (bsk_tables_source)
+                {
+                    // m_sk is the last modulus of every Bsk base
+                    int source_index = (i < aux_base_mod_count_) ? i : bsk_tables_source->aux_base_mod_count_;
+                    bsk_small_ntt_table_[i].alias(bsk_tables_source->bsk_small_ntt_table_[source_index]);
+                }
+                else if (!bsk_small_ntt_table_[i].generate(coeff_power_count, bsk_base_array_[i]))
                 {
                     reset();
                     return;
@@ -120,7 +153,7 @@ namespace seal
             int aux_products_uint64_count = aux_base_mod_count_;
             
             Pointer coeff_products_array(allocate_zero_uint(coeff_products_uint64_count * coeff_base_mod_count_, pool_));
-            Pointer tmp_coeff(allocate_uint(coeff_products_uint64_count, pool));
+            Pointer tmp_coeff(allocate_uint(coeff_products_uint64_count, pool_));
             
             for (int i = 0; i < coeff_base_mod_count_; i++)
             {
@@ -137,7 +170,7 @@ namespace seal
             }
 
             Pointer aux_products_array(allocate_zero_uint(aux_products_uint64_count * aux_base_mod_count_, pool_));
-            Pointer tmp_aux(allocate_uint(aux_products_uint64_count, pool));
+            Pointer tmp_aux(allocate_uint(aux_products_uint64_count, pool_));
 
             for (int i = 0; i < aux_base_mod_count_; i++)
             {
@@ -351,6 +384,149 @@ namespace seal
             generated_ = true;
         }
 
+        namespace
+        {
+            // mont_rq works on blocks of this many coefficients at a time
+            const int mont_rq_block_coeff_count = 256;
+
+            void save_moduli(ostream &stream, const vector<SmallModulus> &moduli)
+            {
+                for (const auto &modulus : moduli)
+                {
+                    uint64_t value = modulus.value();
+                    write_words(stream, &value, 1);
+                }
+            }
+
+            void load_moduli(const uint64_t *&data, const uint64_t *data_end, int count, vector<SmallModulus> &moduli)
+            {
+                const uint64_t *values = read_words(data, data_end, count);
+                moduli.assign(values, values + count);
+            }
+
+            void load_array(const uint64_t *&data, const uint64_t *data_end, int count, vector<uint64_t> &array)
+            {
+                const uint64_t *values = read_words(data, data_end, count);
+                array.assign(values, values + count);
+            }
+
+            void save_matrix(ostream &stream, const vector<vector<uint64_t> > &matrix)
+            {
+                for (const auto &row : matrix)
+                {
+                    write_words(stream, row.data(), row.size());
+                }
+            }
+
+            void load_matrix(const uint64_t *&data, const uint64_t *data_end, int row_count, int column_count,
+                vector<vector<uint64_t> > &matrix)
+            {
+                matrix.resize(row_count);
+                for (auto &row : matrix)
+                {
+                    load_array(data, data_end, column_count, row);
+                }
+            }
+        }
+
+        void BaseConverter::save(ostream &stream) const
+        {
+            uint64_t header[13]{ static_cast<uint64_t>(generated_), static_cast<uint64_t>(coeff_base_mod_count_),
+                static_cast<uint64_t>(aux_base_mod_count_), static_cast<uint64_t>(bsk_base_mod_count_),
+                static_cast<uint64_t>(coeff_count_), static_cast<uint64_t>(plain_gamma_count_),
+                m_tilde_.value(), m_sk_.value(), small_plain_mod_.value(), gamma_.value(),
+                inv_coeff_products_mod_mtilde_, inv_aux_products_mod_msk_, inv_gamma_mod_plain_ };
+            write_words(stream, header, 13);
+            if (!generated_)
+            {
+                return;
+            }
+
+            save_moduli(stream, coeff_base_array_);
+            save_moduli(stream, aux_base_array_);
+            save_moduli(stream, bsk_base_array_);
+            save_moduli(stream, plain_gamma_array_);
+            save_matrix(stream, coeff_base_products_mod_aux_bsk_array_);
+            write_words(stream, inv_coeff_base_products_mod_coeff_array_.data(), coeff_base_mod_count_);
+            write_words(stream, coeff_base_products_mod_mtilde_array_.data(), coeff_base_mod_count_);
+            write_words(stream, mtilde_inv_coeff_base_products_mod_coeff_array_.data(), coeff_base_mod_count_);
+            write_words(stream, inv_coeff_products_all_mod_aux_bsk_array_.data(), bsk_base_mod_count_);
+            save_matrix(stream, aux_base_products_mod_coeff_array_);
+            write_words(stream, inv_aux_base_products_mod_aux_array_.data(), aux_base_mod_count_);
+            write_words(stream, aux_base_products_mod_msk_array_.data(), aux_base_mod_count_);
+            write_words(stream, aux_products_all_mod_coeff_array_.data(), coeff_base_mod_count_);
+            write_words(stream, inv_mtilde_mod_bsk_array_.data(), bsk_base_mod_count_);
+            write_words(stream, coeff_products_all_mod_bsk_array_.data(), bsk_base_mod_count_);
+            save_matrix(stream, coeff_products_mod_plain_gamma_array_);
+            write_words(stream, neg_inv_coeff_products_all_mod_plain_gamma_array_.data(), plain_gamma_count_);
+            write_words(stream, plain_gamma_product_mod_coeff_array_.data(), coeff_base_mod_count_);
+            for (const auto &table : bsk_small_ntt_table_)
+            {
+                table.save(stream);
+            }
+        }
+
+        void BaseConverter::load_aliasing(const uint64_t *&data, const uint64_t *data_end)
+        {
+            reset();
+
+            const uint64_t *header = read_words(data, data_end, 13);
+            if (!header[0])
+            {
+                return;
+            }
+            if (header[1] == 0 || header[1] > SEAL_COEFF_MOD_COUNT_BOUND || 
+                header[2] < header[1] || header[2] > header[1] + 1 || 
+                header[3] != header[2] + 1 || header[5] != 2)
+            {
+                throw invalid_argument("inconsistent base sizes");
+            }
+            coeff_base_mod_count_ = static_cast<int>(header[1]);
+            aux_base_mod_count_ = static_cast<int>(header[2]);
+            bsk_base_mod_count_ = static_cast<int>(header[3]);
+            coeff_count_ = static_cast<int>(header[4]);
+            plain_gamma_count_ = static_cast<int>(header[5]);
+            m_tilde_ = header[6];
+            m_sk_ = header[7];
+            small_plain_mod_ = header[8];
+            gamma_ = header[9];
+            inv_coeff_products_mod_mtilde_ = header[10];
+            inv_aux_products_mod_msk_ = header[11];
+            inv_gamma_mod_plain_ = header[12];
+
+            load_moduli(data, data_end, coeff_base_mod_count_, coeff_base_array_);
+            load_moduli(data, data_end, aux_base_mod_count_, aux_base_array_);
+            load_moduli(data, data_end, bsk_base_mod_count_, bsk_base_array_);
+            load_moduli(data, data_end, plain_gamma_count_, plain_gamma_array_);
+            load_matrix(data, data_end, bsk_base_mod_count_, coeff_base_mod_count_, coeff_base_products_mod_aux_bsk_array_);
+            load_array(data, data_end, coeff_base_mod_count_, inv_coeff_base_products_mod_coeff_array_);
+            load_array(data, data_end, coeff_base_mod_count_, coeff_base_products_mod_mtilde_array_);
+            load_array(data, data_end, coeff_base_mod_count_, mtilde_inv_coeff_base_products_mod_coeff_array_);
+            load_array(data, data_end, bsk_base_mod_count_, inv_coeff_products_all_mod_aux_bsk_array_);
+            load_matrix(data, data_end, coeff_base_mod_count_, aux_base_mod_count_, aux_base_products_mod_coeff_array_);
+            load_array(data, data_end, aux_base_mod_count_, inv_aux_base_products_mod_aux_array_);
+            load_array(data, data_end, aux_base_mod_count_, aux_base_products_mod_msk_array_);
+            load_array(data, data_end, coeff_base_mod_count_, aux_products_all_mod_coeff_array_);
+            load_array(data, data_end, bsk_base_mod_count_, inv_mtilde_mod_bsk_array_);
+            load_array(data, data_end, bsk_base_mod_count_, coeff_products_all_mod_bsk_array_);
+            load_matrix(data, data_end, plain_gamma_count_, coeff_base_mod_count_, coeff_products_mod_plain_gamma_array_);
+            load_array(data, data_end, plain_gamma_count_, neg_inv_coeff_products_all_mod_plain_gamma_array_);
+            load_array(data, data_end, coeff_base_mod_count_, plain_gamma_product_mod_coeff_array_);
+            for (int i = 0; i < bsk_base_mod_count_; i++)
+            {
+                bsk_small_ntt_table_.emplace_back(pool_);
+                bsk_small_ntt_table_[i].load_aliasing(data, data_end);
+                if (!bsk_small_ntt_table_[i].is_generated() || 
+                    bsk_small_ntt_table_[i].modulus().value() != bsk_base_array_[i].value() ||
+                    (bsk_small_ntt_table_[i].coeff_count() + 1) != coeff_count_)
+                {
+                    reset();
+                    throw invalid_argument("inconsistent Bsk NTT tables");
+                }
+            }
+            generated_ = true;
+        }
+
         void BaseConverter::reset()
         {
             generated_ = false;
@@ -386,6 +562,18 @@ namespace seal
 
         void BaseConverter::fastbconv(const uint64_t *input, uint64_t *destination, const MemoryPoolHandle &pool) const
         {
+#ifdef SEAL_DEBUG
+            if (!pool)
+            {
+                throw invalid_argument("pool is not initialied");
+            }
+#endif
+            Pointer temp(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
+            fastbconv(input, destination, temp.get());
+        }
+
+        void BaseConverter::fastbconv(const uint64_t *input, uint64_t *destination, uint64_t *temp) const
+        {
 #ifdef SEAL_DEBUG
             if (input == nullptr)
             {
@@ -395,9 +583,9 @@ namespace seal
             {
                 throw invalid_argument("destination cannot be null");
             }
-            if (!pool)
+            if (temp == nullptr)
             {
-                throw invalid_argument("pool is not initialied");
+                throw invalid_argument("temp cannot be null");
             }
             if (!generated_)
             {
@@ -408,44 +596,36 @@ namespace seal
              Require: Input in q
              Ensure: Output in Bsk = {m1,...,ml} U {msk}
             */
-            Pointer temp_coeff_transition(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
+            uint64_t *temp_coeff_transition = temp;
             for (int i = 0; i < coeff_base_mod_count_; i++)
             {
-                uint64_t inv_coeff_base_products_mod_coeff_elt = inv_coeff_base_products_mod_coeff_array_[i];
-                SmallModulus coeff_base_array_elt = coeff_base_array_[i];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = multiply_uint_uint_mod(*input++,
-                        inv_coeff_base_products_mod_coeff_elt, coeff_base_array_elt);
-                }
+                base_convert_multiply(input + (i * coeff_count_), coeff_count_, inv_coeff_base_products_mod_coeff_array_[i],
+                    coeff_base_array_[i], temp_coeff_transition + (i * coeff_count_));
             }
 
+            // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
+            // Thus need coeff_base_mod_count_ <= 127 to guarantee success
             for (int j = 0; j < bsk_base_mod_count_; j++)
             {
-                uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-                SmallModulus bsk_base_array_elt = bsk_base_array_[j];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    const uint64_t *coeff_base_products_mod_aux_bsk_array_ptr = coeff_base_products_mod_aux_bsk_array_[j].data();
-                    uint64_t aux_transition[2]{ 0 };
-                    for (int i = 0; i < coeff_base_mod_count_; i++)
-                    {
-                        // Lazy reduction
-                        uint64_t temp[2];
-
-                        // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need coeff_base_mod_count_ <= 127 to guarantee success
-                        multiply_uint64(*temp_coeff_transition_ptr++, *coeff_base_products_mod_aux_bsk_array_ptr++, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], temp[0], 0, aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination++ = barrett_reduce_128(aux_transition, bsk_base_array_elt);
-                }
+                base_convert_dot_product(temp_coeff_transition, coeff_base_mod_count_, coeff_count_,
+                    coeff_base_products_mod_aux_bsk_array_[j].data(), bsk_base_array_[j], destination + (j * coeff_count_));
             }
         }
 
         void BaseConverter::fastbconv_sk(const uint64_t *input, uint64_t *destination, const MemoryPoolHandle &pool) const
         {
+#ifdef SEAL_DEBUG
+            if (!pool)
+            {
+                throw invalid_argument("pool is not initialied");
+            }
+#endif
+            Pointer temp(allocate_uint(coeff_count_ * (coeff_base_mod_count_ + 2), pool));
+            fastbconv_sk(input, destination, temp.get());
+        }
+
+        void BaseConverter::fastbconv_sk(const uint64_t *input, uint64_t *destination, uint64_t *temp) const
+        {
 #ifdef SEAL_DEBUG
             if (input == nullptr)
             {
@@ -455,9 +635,9 @@ namespace seal
             {
                 throw invalid_argument("destination cannot be null");
             }
-            if (!pool)
+            if (temp == nullptr)
             {
-                throw invalid_argument("pool is not initialied");
+                throw invalid_argument("temp cannot be null");
             }
 #endif
             /**
@@ -466,83 +646,42 @@ namespace seal
             */
 
             // Fast convert B -> q
-            Pointer temp_coeff_transition(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
-            const uint64_t *input_ptr = input;
-            for (int i = 0; i < coeff_base_mod_count_; i++)
+            uint64_t *temp_coeff_transition = temp;
+            for (int i = 0; i < aux_base_mod_count_; i++)
             {
-                uint64_t inv_aux_base_products_mod_aux_array_elt = inv_aux_base_products_mod_aux_array_[i];
-                SmallModulus aux_base_array_elt = aux_base_array_[i];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = multiply_uint_uint_mod(*input_ptr++, 
-                        inv_aux_base_products_mod_aux_array_elt, aux_base_array_elt);
-                }
+                base_convert_multiply(input + (i * coeff_count_), coeff_count_, inv_aux_base_products_mod_aux_array_[i],
+                    aux_base_array_[i], temp_coeff_transition + (i * coeff_count_));
             }
 
-            uint64_t *destination_ptr = destination;
-            uint64_t *temp_ptr;
+            // Product is 61 bit + 60 bit = 121 bit, so can sum up to 127 of them with no reduction
+            // Thus need aux_base_mod_count_ <= 127, so coeff_base_mod_count_ <= 126 to guarantee success
             for (int j = 0; j < coeff_base_mod_count_; j++)
             {
-                temp_ptr = temp_coeff_transition.get();
-                SmallModulus coeff_base_array_elt = coeff_base_array_[j];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    const uint64_t *aux_base_products_mod_coeff_array_ptr = aux_base_products_mod_coeff_array_[j].data();
-                    uint64_t aux_transition[2]{ 0 };
-                    for (int i = 0; i < aux_base_mod_count_; i++)
-                    {
-                        // Lazy reduction
-                        uint64_t temp[2];
-
-                        // Product is 61 bit + 60 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need aux_base_mod_count_ <= 127, so coeff_base_mod_count_ <= 126 to guarantee success
-                        multiply_uint64(*temp_ptr++, *aux_base_products_mod_coeff_array_ptr++, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], temp[0], 0, aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination_ptr++ = barrett_reduce_128(aux_transition, coeff_base_array_elt);
-                }
+                base_convert_dot_product(temp_coeff_transition, aux_base_mod_count_, coeff_count_,
+                    aux_base_products_mod_coeff_array_[j].data(), coeff_base_array_[j], destination + (j * coeff_count_));
             }
             
             // Compute alpha_sk
             // Require: Input is in Bsk 
             // we only use coefficient in B 
             // Fast convert B -> m_sk
-            Pointer tmp(allocate_uint(coeff_count_, pool));
-            destination_ptr = tmp.get();
-            temp_ptr = temp_coeff_transition.get();
-            for (int k = 0; k < coeff_count_; k++)
-            {
-                uint64_t msk_transition[2]{ 0 };
-                const uint64_t *aux_base_products_mod_msk_array_ptr = aux_base_products_mod_msk_array_.data();
-                for (int i = 0; i < aux_base_mod_count_; i++)
-                {
-                    //multiply_uint64_mod(&coeff_transition, &aux_base_products_mod_msk_array_[i], m_sk_, &msk_transition);
-                    //add_uint_uint_smallmod(&msk_transition, tmp.get() + k, m_sk_, tmp.get() + k);
-
-                    // Lazy reduction
-                    uint64_t temp[2];
-
-                    // Product is 61 bit + 61 bit = 122 bit, so can sum up to 63 of them with no reduction
-                    // Thus need aux_base_mod_count_ <= 63, so coeff_base_mod_count_ <= 62 to guarantee success
-                    // This gives the strongest restriction on the number of coeff modulus primes
-                    multiply_uint64(*temp_ptr++, *aux_base_products_mod_msk_array_ptr++, temp);
-                    unsigned char carry = add_uint64(msk_transition[0], temp[0], 0, msk_transition);
-                    msk_transition[1] += temp[1] + carry;
-                }
-                *destination_ptr++ = barrett_reduce_128(msk_transition, m_sk_);
-            }
+            // Product is 61 bit + 61 bit = 122 bit, so can sum up to 63 of them with no reduction
+            // Thus need aux_base_mod_count_ <= 63, so coeff_base_mod_count_ <= 62 to guarantee success
+            // This gives the strongest restriction on the number of coeff modulus primes
+            uint64_t *tmp = temp + (coeff_count_ * coeff_base_mod_count_);
+            base_convert_dot_product(temp_coeff_transition, aux_base_mod_count_, coeff_count_,
+                aux_base_products_mod_msk_array_.data(), m_sk_, tmp);
 
-            Pointer alpha_sk(allocate_uint(coeff_count_, pool));
-            input_ptr = input + (aux_base_mod_count_ * coeff_count_);
-            destination_ptr = alpha_sk.get();
-            temp_ptr = tmp.get();
+            uint64_t *alpha_sk = tmp + coeff_count_;
+            const uint64_t *input_ptr = input + (aux_base_mod_count_ * coeff_count_);
+            uint64_t *destination_ptr = alpha_sk;
+            uint64_t *temp_ptr = tmp;
             const uint64_t m_sk_value = m_sk_.value();
             // x_sk is allocated in input[aux_base_mod_count_]
             for (int i = 0; i < coeff_count_; i++)
             {
-                //sub_uint_uint_smallmod(tmp.get() + i, input + i + (aux_base_mod_count_ * coeff_count_), m_sk_, tmp.get() + i);
-                //multiply_uint64_mod(tmp.get() + i, &inv_aux_products_mod_msk_, m_sk_, alpha_sk.get() + i);
+                //sub_uint_uint_smallmod(tmp + i, input + i + (aux_base_mod_count_ * coeff_count_), m_sk_, tmp + i);
+                //multiply_uint64_mod(tmp + i, &inv_aux_products_mod_msk_, m_sk_, alpha_sk + i);
 
                 // It is not necessary for the negation to be reduced modulo the small prime
                 //negate_uint_smallmod(input + i + (aux_base_mod_count_ * coeff_count_), m_sk_, &negated_input);
@@ -555,7 +694,7 @@ namespace seal
             for (int i = 0; i < coeff_base_mod_count_; i++)
             {
                 uint64_t aux_products_all_mod_coeff_array_elt = aux_products_all_mod_coeff_array_[i];
-                temp_ptr = alpha_sk.get();
+                temp_ptr = alpha_sk;
                 SmallModulus coeff_base_array_elt = coeff_base_array_[i];
                 uint64_t coeff_base_array_elt_value = coeff_base_array_elt.value();
                 for (int k = 0; k < coeff_count_; k++, temp_ptr++, destination++)
@@ -600,32 +739,46 @@ namespace seal
              Require: Input should in Bsk U {m_tilde}
              Ensure: Destination array in Bsk = m U {msk}
             */
-            const uint64_t *input_m_tilde_ptr = input + (coeff_count_ * bsk_base_mod_count_);
-            for (int k = 0; k < bsk_base_mod_count_; k++)
+            // Work on blocks of coefficients so that r_mtilde is computed only once, and
+            // stays in L1 while it is used for every prime in Bsk
+            const uint64_t *input_m_tilde = input + (coeff_count_ * bsk_base_mod_count_);
+            uint64_t r_mtilde[mont_rq_block_coeff_count];
+            for (int block_start = 0; block_start < coeff_count_; block_start += mont_rq_block_coeff_count)
             {
-                uint64_t coeff_products_all_mod_bsk_array_elt = coeff_products_all_mod_bsk_array_[k];
-                uint64_t inv_mtilde_mod_bsk_array_elt = inv_mtilde_mod_bsk_array_[k];
-                SmallModulus bsk_base_array_elt = bsk_base_array_[k];
-                const uint64_t *input_m_tilde_ptr_copy = input_m_tilde_ptr;
+                int block_coeff_count = min(mont_rq_block_coeff_count, coeff_count_ - block_start);
+
+                // Compute r_mtilde
+                base_convert_multiply(input_m_tilde + block_start, block_coeff_count, inv_coeff_products_mod_mtilde_,
+                    m_tilde_, r_mtilde);
+                for (int i = 0; i < block_coeff_count; i++)
+                {
+                    r_mtilde[i] = negate_uint_mod(r_mtilde[i], m_tilde_);
+                }
+
                 // Compute result for aux base
-                for (int i = 0; i < coeff_count_; i++)
+                for (int k = 0; k < bsk_base_mod_count_; k++)
                 {
-                    // Compute r_mtilde
-                    uint64_t r_mtilde = multiply_uint_uint_mod(*input_m_tilde_ptr_copy++, inv_coeff_products_mod_mtilde_, m_tilde_);
-                    r_mtilde = negate_uint_mod(r_mtilde, m_tilde_);
-
-                    // Lazy reduction
-                    uint64_t tmp[2];
-                    multiply_uint64(coeff_products_all_mod_bsk_array_elt, r_mtilde, tmp);
-                    tmp[1] += add_uint64(tmp[0], *input++, 0, tmp);
-                    r_mtilde = barrett_reduce_128(tmp, bsk_base_array_elt);
-                    *destination++ = multiply_uint_uint_mod(r_mtilde, inv_mtilde_mod_bsk_array_elt, bsk_base_array_elt);
+                    int offset = (k * coeff_count_) + block_start;
+                    base_convert_mont_reduce(input + offset, r_mtilde, block_coeff_count, coeff_products_all_mod_bsk_array_[k],
+                        inv_mtilde_mod_bsk_array_[k], bsk_base_array_[k], destination + offset);
                 }
             }
         }
 
         void BaseConverter::fast_floor(const uint64_t *input, uint64_t *destination, const MemoryPoolHandle &pool) const
         {
+#ifdef SEAL_DEBUG
+            if (!pool)
+            {
+                throw invalid_argument("pool is not initialied");
+            }
+#endif
+            Pointer temp(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
+            fast_floor(input, destination, temp.get());
+        }
+
+        void BaseConverter::fast_floor(const uint64_t *input, uint64_t *destination, uint64_t *temp) const
+        {
 #ifdef SEAL_DEBUG
             if (input == nullptr)
             {
@@ -635,36 +788,41 @@ namespace seal
             {
                 throw invalid_argument("destination cannot be null");
             }
-            if (!pool)
+            if (temp == nullptr)
             {
-                throw invalid_argument("pool is not initialied");
+                throw invalid_argument("temp cannot be null");
             }
 #endif
             /** 
              Require: Input in q U m U {msk}
              Ensure: Destination array in Bsk
             */
-            fastbconv(input, destination, pool); //q -> Bsk
+            fastbconv(input, destination, temp); //q -> Bsk
             
             int index_msk = coeff_base_mod_count_ * coeff_count_;
             input += index_msk;
             for (int i = 0; i < bsk_base_mod_count_; i++)
             {
-                SmallModulus bsk_base_array_elt = bsk_base_array_[i];
-                uint64_t bsk_base_array_value = bsk_base_array_elt.value();
-                uint64_t inv_coeff_products_all_mod_aux_bsk_array_elt = inv_coeff_products_all_mod_aux_bsk_array_[i];
-                for (int k = 0; k < coeff_count_; k++, destination++)
-                {
-                    // It is not necessary for the negation to be reduced modulo the small prime
-                    //negate_uint_smallmod(base_convert_Bsk.get() + k + (i * coeff_count_), bsk_base_array_[i], &negated_base_convert_Bsk);
-                    *destination = multiply_uint_uint_mod(*input++ + bsk_base_array_value - *destination, 
-                        inv_coeff_products_all_mod_aux_bsk_array_elt, bsk_base_array_elt);
-                }
+                // It is not necessary for the negation to be reduced modulo the small prime
+                base_convert_floor(input + (i * coeff_count_), coeff_count_, inv_coeff_products_all_mod_aux_bsk_array_[i],
+                    bsk_base_array_[i], destination + (i * coeff_count_));
             }
         }
 
         void BaseConverter::fastbconv_mtilde(const uint64_t *input, uint64_t *destination, const MemoryPoolHandle &pool) const
         {
+#ifdef SEAL_DEBUG
+            if (!pool)
+            {
+                throw invalid_argument("pool is not initialied");
+            }
+#endif
+            Pointer temp(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
+            fastbconv_mtilde(input, destination, temp.get());
+        }
+
+        void BaseConverter::fastbconv_mtilde(const uint64_t *input, uint64_t *destination, uint64_t *temp) const
+        {
 #ifdef SEAL_DEBUG
             if (input == nullptr)
             {
@@ -674,9 +832,9 @@ namespace seal
             {
                 throw invalid_argument("destination cannot be null");
             }
-            if (!pool)
+            if (temp == nullptr)
             {
-                throw invalid_argument("pool is not initialied");
+                throw invalid_argument("temp cannot be null");
             }
 #endif
             /**
@@ -685,63 +843,25 @@ namespace seal
             */
             
             // Compute in Bsk first; we compute |m_tilde*q^-1i| mod qi
-            Pointer temp_coeff_transition(allocate_uint(coeff_count_ * coeff_base_mod_count_, pool));
+            uint64_t *temp_coeff_transition = temp;
             for (int i = 0; i < coeff_base_mod_count_; i++)
             {
-                SmallModulus coeff_base_array_elt = coeff_base_array_[i];
-                uint64_t mtilde_inv_coeff_base_products_mod_coeff_elt = mtilde_inv_coeff_base_products_mod_coeff_array_[i];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = multiply_uint_uint_mod(*input++,
-                        mtilde_inv_coeff_base_products_mod_coeff_elt, coeff_base_array_elt);
-                }
+                base_convert_multiply(input + (i * coeff_count_), coeff_count_, mtilde_inv_coeff_base_products_mod_coeff_array_[i],
+                    coeff_base_array_[i], temp_coeff_transition + (i * coeff_count_));
             }
 
-            uint64_t *destination_ptr = destination;
+            // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
+            // Thus need coeff_base_mod_count_ <= 127
             for (int j = 0; j < bsk_base_mod_count_; j++)
             {
-                const uint64_t *coeff_base_products_mod_aux_bsk_array_ptr = coeff_base_products_mod_aux_bsk_array_[j].data();
-                uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-                SmallModulus bsk_base_array_elt = bsk_base_array_[j];
-                for (int k = 0; k < coeff_count_; k++)
-                {
-                    uint64_t aux_transition[2]{ 0 };
-                    const uint64_t *temp_ptr = coeff_base_products_mod_aux_bsk_array_ptr;
-                    for (int i = 0; i < coeff_base_mod_count_; i++)
-                    {
-                        // Lazy reduction
-                        uint64_t temp[2];
-
-                        // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need coeff_base_mod_count_ <= 127
-                        multiply_uint64(*temp_coeff_transition_ptr++, *temp_ptr++, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], temp[0], 0, aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination_ptr++ = barrett_reduce_128(aux_transition, bsk_base_array_elt);
-                }
+                base_convert_dot_product(temp_coeff_transition, coeff_base_mod_count_, coeff_count_,
+                    coeff_base_products_mod_aux_bsk_array_[j].data(), bsk_base_array_[j], destination + (j * coeff_count_));
             }
             
             // Computing the last element (mod m_tilde) and add it at the end of destination array
-            uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-            destination += bsk_base_mod_count_ * coeff_count_;
-            for (int k = 0; k < coeff_count_; k++)
-            {
-                uint64_t wide_result[2]{ 0 };
-                const uint64_t *coeff_base_products_mod_mtilde_array_ptr = coeff_base_products_mod_mtilde_array_.data();
-                for (int i = 0; i < coeff_base_mod_count_; i++)
-                {
-                    // Lazy reduction
-                    uint64_t aux_transition[2];
-
-                    // Product is 60 bit + 33 bit = 93 bit
-                    multiply_uint64(*temp_coeff_transition_ptr++,
-                        *coeff_base_products_mod_mtilde_array_ptr++, aux_transition);
-                    unsigned char carry = add_uint64(aux_transition[0], wide_result[0], 0, wide_result);
-                    wide_result[1] += aux_transition[1] + carry;
-                }
-                *destination++ = barrett_reduce_128(wide_result, m_tilde_);
-            }
+            // Product is 60 bit + 33 bit = 93 bit
+            base_convert_dot_product(temp_coeff_transition, coeff_base_mod_count_, coeff_count_,
+                coeff_base_products_mod_mtilde_array_.data(), m_tilde_, destination + (bsk_base_mod_count_ * coeff_count_));
         }
 
         void BaseConverter::fastbconv_plain_gamma(const uint64_t *input, uint64_t *destination, const MemoryPoolHandle &pool) const
@@ -823,5 +943,375 @@ namespace seal
                 }
             }
         }
+
+        namespace
+        {
+            // Products are summed in 128 bits for this many coefficients at a time
+            const int dot_product_block_coeff_count = 8;
+
+            void dot_product_range_generic(const uint64_t *input, int input_count, int coeff_count,
+                const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination, int coeff_begin, int coeff_end)
+            {
+                for (int block_start = coeff_begin; block_start < coeff_end; block_start += dot_product_block_coeff_count)
+                {
+                    int block_coeff_count = min(dot_product_block_coeff_count, coeff_end - block_start);
+                    uint64_t accumulator[dot_product_block_coeff_count][2]{};
+                    const uint64_t *input_ptr = input + block_start;
+                    for (int i = 0; i < input_count; i++, input_ptr += coeff_count)
+                    {
+                        uint64_t factor = factors[i];
+                        for (int k = 0; k < block_coeff_count; k++)
+                        {
+                            // Lazy reduction
+                            uint64_t product[2];
+                            multiply_uint64(input_ptr[k], factor, product);
+                            unsigned char carry = add_uint64(accumulator[k][0], product[0], 0, accumulator[k]);
+                            accumulator[k][1] += product[1] + carry;
+                        }
+                    }
+                    for (int k = 0; k < block_coeff_count; k++)
+                    {
+                        destination[block_start + k] = barrett_reduce_128(accumulator[k], modulus);
+                    }
+                }
+            }
+        }
+
+        void base_convert_dot_product_generic(const uint64_t *input, int input_count, int coeff_count,
+            const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination)
+        {
+            dot_product_range_generic(input, input_count, coeff_count, factors, modulus, destination, 0, coeff_count);
+        }
+
+        void base_convert_multiply_generic(const uint64_t *input, int coeff_count, uint64_t operand,
+            const SmallModulus &modulus, uint64_t *destination)
+        {
+            for (int k = 0; k < coeff_count; k++)
+            {
+                destination[k] = multiply_uint_uint_mod(input[k], operand, modulus);
+            }
+        }
+
+        void base_convert_mont_reduce_generic(const uint64_t *input, const uint64_t *r, int coeff_count,
+            uint64_t operand1, uint64_t operand2, const SmallModulus &modulus, uint64_t *destination)
+        {
+            for (int k = 0; k < coeff_count; k++)
+            {
+                // Lazy reduction
+                uint64_t tmp[2];
+                multiply_uint64(operand1, r[k], tmp);
+                tmp[1] += add_uint64(tmp[0], input[k], 0, tmp);
+                destination[k] = multiply_uint_uint_mod(barrett_reduce_128(tmp, modulus), operand2, modulus);
+            }
+        }
+
+        void base_convert_floor_generic(const uint64_t *input, int coeff_count, uint64_t operand,
+            const SmallModulus &modulus, uint64_t *destination)
+        {
+            uint64_t modulus_value = modulus.value();
+            for (int k = 0; k < coeff_count; k++)
+            {
+                destination[k] = multiply_uint_uint_mod(input[k] + modulus_value - destination[k], operand, modulus);
+            }
+        }
+
+#ifdef SEAL_ENABLE_AVX_NTT
+        namespace
+        {
+            // The 128-bit sums of 64x64-bit products are kept in three 64-bit accumulators 
+            // of 32x32-bit partial products (bits 0-31, 32-95, and 64-127 of each product), 
+            // which cannot overflow for fewer than 2^30 terms. The 128-bit sum is assembled 
+            // only once before the Barrett reduction, so the result is exactly that of the 
+            // scalar code.
+            SEAL_TARGET_AVX2 void dot_product_avx2(const uint64_t *input, int input_count, int coeff_count,
+                const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus.value()));
+                const __m256i const_ratio0 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m256i const_ratio1 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~3;
+                for (int k = 0; k < vector_coeff_count; k += 4)
+                {
+                    __m256i low = _mm256_setzero_si256();
+                    __m256i middle = _mm256_setzero_si256();
+                    __m256i high = _mm256_setzero_si256();
+                    const uint64_t *input_ptr = input + k;
+                    for (int i = 0; i < input_count; i++, input_ptr += coeff_count)
+                    {
+                        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input_ptr));
+                        __m256i x_hi = _mm256_srli_epi64(x, 32);
+                        __m256i factor = _mm256_set1_epi64x(static_cast<long long>(factors[i]));
+                        __m256i factor_hi = _mm256_srli_epi64(factor, 32);
+                        __m256i lolo = _mm256_mul_epu32(x, factor);
+                        __m256i lohi = _mm256_mul_epu32(x, factor_hi);
+                        __m256i hilo = _mm256_mul_epu32(x_hi, factor);
+                        __m256i hihi = _mm256_mul_epu32(x_hi, factor_hi);
+                        low = _mm256_add_epi64(low, _mm256_and_si256(lolo, low_mask));
+                        middle = _mm256_add_epi64(middle, _mm256_add_epi64(_mm256_srli_epi64(lolo, 32),
+                            _mm256_add_epi64(_mm256_and_si256(lohi, low_mask), _mm256_and_si256(hilo, low_mask))));
+                        high = _mm256_add_epi64(high, _mm256_add_epi64(hihi,
+                            _mm256_add_epi64(_mm256_srli_epi64(lohi, 32), _mm256_srli_epi64(hilo, 32))));
+                    }
+                    __m256i sum0 = _mm256_add_epi64(low, _mm256_slli_epi64(middle, 32));
+                    __m256i sum1 = _mm256_add_epi64(high, _mm256_srli_epi64(middle, 32));
+                    sum1 = _mm256_sub_epi64(sum1, cmpgt_epu64_avx2(low, sum0));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + k),
+                        barrett_reduce_128_avx2(sum0, sum1, const_ratio0, const_ratio1, vec_modulus));
+                }
+                dot_product_range_generic(input, input_count, coeff_count, factors, modulus, destination,
+                    vector_coeff_count, coeff_count);
+            }
+
+            SEAL_TARGET_AVX2 void multiply_avx2(const uint64_t *input, int coeff_count, uint64_t operand,
+                const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m256i vec_operand = _mm256_set1_epi64x(static_cast<long long>(operand));
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus.value()));
+                const __m256i const_ratio0 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m256i const_ratio1 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~3;
+                for (int k = 0; k < vector_coeff_count; k += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + k));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + k), 
+                        barrett_reduce_128_avx2(mullo_epi64_avx2(x, vec_operand), mulhi_epu64_avx2(x, vec_operand), 
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_multiply_generic(input + vector_coeff_count, coeff_count - vector_coeff_count, 
+                    operand, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_TARGET_AVX2 void mont_reduce_avx2(const uint64_t *input, const uint64_t *r, int coeff_count,
+                uint64_t operand1, uint64_t operand2, const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m256i vec_operand1 = _mm256_set1_epi64x(static_cast<long long>(operand1));
+                const __m256i vec_operand2 = _mm256_set1_epi64x(static_cast<long long>(operand2));
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus.value()));
+                const __m256i const_ratio0 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m256i const_ratio1 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~3;
+                for (int k = 0; k < vector_coeff_count; k += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + k));
+                    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + k));
+                    __m256i tmp0 = _mm256_add_epi64(mullo_epi64_avx2(y, vec_operand1), x);
+                    __m256i tmp1 = _mm256_sub_epi64(mulhi_epu64_avx2(y, vec_operand1), cmpgt_epu64_avx2(x, tmp0));
+                    y = barrett_reduce_128_avx2(tmp0, tmp1, const_ratio0, const_ratio1, vec_modulus);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + k),
+                        barrett_reduce_128_avx2(mullo_epi64_avx2(y, vec_operand2), mulhi_epu64_avx2(y, vec_operand2),
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_mont_reduce_generic(input + vector_coeff_count, r + vector_coeff_count, 
+                    coeff_count - vector_coeff_count, operand1, operand2, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_TARGET_AVX2 void floor_avx2(const uint64_t *input, int coeff_count, uint64_t operand,
+                const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m256i vec_operand = _mm256_set1_epi64x(static_cast<long long>(operand));
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus.value()));
+                const __m256i const_ratio0 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m256i const_ratio1 = _mm256_set1_epi64x(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~3;
+                for (int k = 0; k < vector_coeff_count; k += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + k));
+                    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + k));
+                    x = _mm256_sub_epi64(_mm256_add_epi64(x, vec_modulus), y);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + k),
+                        barrett_reduce_128_avx2(mullo_epi64_avx2(x, vec_operand), mulhi_epu64_avx2(x, vec_operand),
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_floor_generic(input + vector_coeff_count, coeff_count - vector_coeff_count,
+                    operand, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_PUSH
+
+            // Same as dot_product_avx2 on eight coefficients at a time
+            SEAL_TARGET_AVX512 void dot_product_avx512(const uint64_t *input, int input_count, int coeff_count,
+                const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m512i low_mask = _mm512_set1_epi64(0xFFFFFFFF);
+                const __m512i one = _mm512_set1_epi64(1);
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus.value()));
+                const __m512i const_ratio0 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m512i const_ratio1 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~7;
+                for (int k = 0; k < vector_coeff_count; k += 8)
+                {
+                    __m512i low = _mm512_setzero_si512();
+                    __m512i middle = _mm512_setzero_si512();
+                    __m512i high = _mm512_setzero_si512();
+                    const uint64_t *input_ptr = input + k;
+                    for (int i = 0; i < input_count; i++, input_ptr += coeff_count)
+                    {
+                        __m512i x = _mm512_loadu_si512(input_ptr);
+                        __m512i x_hi = _mm512_srli_epi64(x, 32);
+                        __m512i factor = _mm512_set1_epi64(static_cast<long long>(factors[i]));
+                        __m512i factor_hi = _mm512_srli_epi64(factor, 32);
+                        __m512i lolo = _mm512_mul_epu32(x, factor);
+                        __m512i lohi = _mm512_mul_epu32(x, factor_hi);
+                        __m512i hilo = _mm512_mul_epu32(x_hi, factor);
+                        __m512i hihi = _mm512_mul_epu32(x_hi, factor_hi);
+                        low = _mm512_add_epi64(low, _mm512_and_si512(lolo, low_mask));
+                        middle = _mm512_add_epi64(middle, _mm512_add_epi64(_mm512_srli_epi64(lolo, 32),
+                            _mm512_add_epi64(_mm512_and_si512(lohi, low_mask), _mm512_and_si512(hilo, low_mask))));
+                        high = _mm512_add_epi64(high, _mm512_add_epi64(hihi,
+                            _mm512_add_epi64(_mm512_srli_epi64(lohi, 32), _mm512_srli_epi64(hilo, 32))));
+                    }
+                    __m512i sum0 = _mm512_add_epi64(low, _mm512_slli_epi64(middle, 32));
+                    __m512i sum1 = _mm512_add_epi64(high, _mm512_srli_epi64(middle, 32));
+                    sum1 = _mm512_mask_add_epi64(sum1, _mm512_cmplt_epu64_mask(sum0, low), sum1, one);
+                    _mm512_storeu_si512(destination + k,
+                        barrett_reduce_128_avx512(sum0, sum1, const_ratio0, const_ratio1, vec_modulus));
+                }
+                dot_product_range_generic(input, input_count, coeff_count, factors, modulus, destination,
+                    vector_coeff_count, coeff_count);
+            }
+
+            SEAL_TARGET_AVX512 void multiply_avx512(const uint64_t *input, int coeff_count, uint64_t operand,
+                const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m512i vec_operand = _mm512_set1_epi64(static_cast<long long>(operand));
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus.value()));
+                const __m512i const_ratio0 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m512i const_ratio1 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~7;
+                for (int k = 0; k < vector_coeff_count; k += 8)
+                {
+                    __m512i x = _mm512_loadu_si512(input + k);
+                    _mm512_storeu_si512(destination + k,
+                        barrett_reduce_128_avx512(mullo_epi64_avx512(x, vec_operand), mulhi_epu64_avx512(x, vec_operand),
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_multiply_generic(input + vector_coeff_count, coeff_count - vector_coeff_count,
+                    operand, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_TARGET_AVX512 void mont_reduce_avx512(const uint64_t *input, const uint64_t *r, int coeff_count,
+                uint64_t operand1, uint64_t operand2, const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m512i one = _mm512_set1_epi64(1);
+                const __m512i vec_operand1 = _mm512_set1_epi64(static_cast<long long>(operand1));
+                const __m512i vec_operand2 = _mm512_set1_epi64(static_cast<long long>(operand2));
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus.value()));
+                const __m512i const_ratio0 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m512i const_ratio1 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~7;
+                for (int k = 0; k < vector_coeff_count; k += 8)
+                {
+                    __m512i x = _mm512_loadu_si512(input + k);
+                    __m512i y = _mm512_loadu_si512(r + k);
+                    __m512i tmp0 = _mm512_add_epi64(mullo_epi64_avx512(y, vec_operand1), x);
+                    __m512i tmp1 = mulhi_epu64_avx512(y, vec_operand1);
+                    tmp1 = _mm512_mask_add_epi64(tmp1, _mm512_cmplt_epu64_mask(tmp0, x), tmp1, one);
+                    y = barrett_reduce_128_avx512(tmp0, tmp1, const_ratio0, const_ratio1, vec_modulus);
+                    _mm512_storeu_si512(destination + k,
+                        barrett_reduce_128_avx512(mullo_epi64_avx512(y, vec_operand2), mulhi_epu64_avx512(y, vec_operand2),
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_mont_reduce_generic(input + vector_coeff_count, r + vector_coeff_count,
+                    coeff_count - vector_coeff_count, operand1, operand2, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_TARGET_AVX512 void floor_avx512(const uint64_t *input, int coeff_count, uint64_t operand,
+                const SmallModulus &modulus, uint64_t *destination)
+            {
+                const __m512i vec_operand = _mm512_set1_epi64(static_cast<long long>(operand));
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus.value()));
+                const __m512i const_ratio0 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[0]));
+                const __m512i const_ratio1 = _mm512_set1_epi64(static_cast<long long>(modulus.const_ratio()[1]));
+                int vector_coeff_count = coeff_count & ~7;
+                for (int k = 0; k < vector_coeff_count; k += 8)
+                {
+                    __m512i x = _mm512_loadu_si512(input + k);
+                    __m512i y = _mm512_loadu_si512(destination + k);
+                    x = _mm512_sub_epi64(_mm512_add_epi64(x, vec_modulus), y);
+                    _mm512_storeu_si512(destination + k,
+                        barrett_reduce_128_avx512(mullo_epi64_avx512(x, vec_operand), mulhi_epu64_avx512(x, vec_operand),
+                            const_ratio0, const_ratio1, vec_modulus));
+                }
+                base_convert_floor_generic(input + vector_coeff_count, coeff_count - vector_coeff_count,
+                    operand, modulus, destination + vector_coeff_count);
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_POP
+        }
+#endif
+        namespace
+        {
+            typedef void(*dot_product_type)(const uint64_t *input, int input_count, int coeff_count,
+                const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination);
+
+            typedef void(*multiply_type)(const uint64_t *input, int coeff_count, uint64_t operand,
+                const SmallModulus &modulus, uint64_t *destination);
+
+            typedef void(*mont_reduce_type)(const uint64_t *input, const uint64_t *r, int coeff_count,
+                uint64_t operand1, uint64_t operand2, const SmallModulus &modulus, uint64_t *destination);
+
+            struct BaseConvKernels
+            {
+#ifdef SEAL_ENABLE_AVX_NTT
+                BaseConvKernels()
+                {
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx512f"))
+                    {
+                        dot_product = dot_product_avx512;
+                        multiply = multiply_avx512;
+                        mont_reduce = mont_reduce_avx512;
+                        floor = floor_avx512;
+                    }
+                    else if (__builtin_cpu_supports("avx2"))
+                    {
+                        dot_product = dot_product_avx2;
+                        multiply = multiply_avx2;
+                        mont_reduce = mont_reduce_avx2;
+                        floor = floor_avx2;
+                    }
+                }
+#endif
+                dot_product_type dot_product = base_convert_dot_product_generic;
+
+                multiply_type multiply = base_convert_multiply_generic;
+
+                mont_reduce_type mont_reduce = base_convert_mont_reduce_generic;
+
+                multiply_type floor = base_convert_floor_generic;
+            };
+
+            // The CPU is queried only once; initialization of the local static is thread-safe.
+            inline const BaseConvKernels &base_conv_kernels()
+            {
+                static const BaseConvKernels kernels;
+                return kernels;
+            }
+        }
+
+        void base_convert_dot_product(const uint64_t *input, int input_count, int coeff_count,
+            const uint64_t *factors, const SmallModulus &modulus, uint64_t *destination)
+        {
+            base_conv_kernels().dot_product(input, input_count, coeff_count, factors, modulus, destination);
+        }
+
+        void base_convert_multiply(const uint64_t *input, int coeff_count, uint64_t operand,
+            const SmallModulus &modulus, uint64_t *destination)
+        {
+            base_conv_kernels().multiply(input, coeff_count, operand, modulus, destination);
+        }
+
+        void base_convert_mont_reduce(const uint64_t *input, const uint64_t *r, int coeff_count,
+            uint64_t operand1, uint64_t operand2, const SmallModulus &modulus, uint64_t *destination)
+        {
+            base_conv_kernels().mont_reduce(input, r, coeff_count, operand1, operand2, modulus, destination);
+        }
+
+        void base_convert_floor(const uint64_t *input, int coeff_count, uint64_t operand,
+            const SmallModulus &modulus, uint64_t *destination)
+        {
+            base_conv_kernels().floor(input, coeff_count, operand, modulus, destination);
+        }
     }
 }
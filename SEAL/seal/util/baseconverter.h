@@ -1,6 +1,8 @@
 #pragma once
 
 #include <stdexcept>
+#include <iostream>
+#include <vector>
 #include "seal/util/mempool.h"
 #include "seal/memorypoolhandle.h"
 #include "seal/smallmodulus.h"
@@ -28,6 +30,21 @@ namespace seal
             BaseConverter(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
                 const SmallModulus &small_plain_mod, const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
 
+            /**
+            Same as the main constructor, but the NTT tables for the Bsk base alias those of 
+            bsk_tables_source instead of being generated. The auxiliary base only depends on 
+            the number of coeff moduli, so this works when bsk_tables_source was created for 
+            the same coeff_power and a coeff base at least as large, e.g. for the levels of 
+            the modulus switching chain. The tables of bsk_tables_source must remain valid 
+            for the lifetime of this object.
+
+            @throws std::invalid_argument if bsk_tables_source is not generated, was created
+            for a different coeff_power, or has too few auxiliary moduli
+            */
+            BaseConverter(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
+                const SmallModulus &small_plain_mod, const BaseConverter &bsk_tables_source, 
+                const MemoryPoolHandle &pool = MemoryPoolHandle::Global());
+
             BaseConverter(const BaseConverter &copy) = default;
 
             BaseConverter(BaseConverter &&source) = default;
@@ -39,11 +56,23 @@ namespace seal
             */
             void fastbconv(const std::uint64_t *input, std::uint64_t *destination, const MemoryPoolHandle &pool) const;
 
+            /**
+            Fast base converter from q to Bsk using caller-provided scratch space temp of 
+            coeff_count * coeff_base_mod_count words
+            */
+            void fastbconv(const std::uint64_t *input, std::uint64_t *destination, std::uint64_t *temp) const;
+
             /**
             Fast base converter from Bsk to q
             */
             void fastbconv_sk(const std::uint64_t *input, std::uint64_t *destination, const MemoryPoolHandle &pool) const;
 
+            /**
+            Fast base converter from Bsk to q using caller-provided scratch space temp of 
+            coeff_count * (coeff_base_mod_count + 2) words
+            */
+            void fastbconv_sk(const std::uint64_t *input, std::uint64_t *destination, std::uint64_t *temp) const;
+
             /**
             Reduction from Bsk U {m_tilde} to Bsk
             */
@@ -54,11 +83,23 @@ namespace seal
             */
             void fast_floor(const std::uint64_t *input, std::uint64_t *destination, const MemoryPoolHandle &pool) const;
 
+            /**
+            Fast base converter from q U Bsk to Bsk using caller-provided scratch space temp of 
+            coeff_count * coeff_base_mod_count words
+            */
+            void fast_floor(const std::uint64_t *input, std::uint64_t *destination, std::uint64_t *temp) const;
+
             /**
             Fast base converter from q to Bsk U {m_tilde}
             */
             void fastbconv_mtilde(const std::uint64_t *input, std::uint64_t *destination, const MemoryPoolHandle &pool) const;
 
+            /**
+            Fast base converter from q to Bsk U {m_tilde} using caller-provided scratch space 
+            temp of coeff_count * coeff_base_mod_count words
+            */
+            void fastbconv_mtilde(const std::uint64_t *input, std::uint64_t *destination, std::uint64_t *temp) const;
+
             /**
             Fast base converter from q to plain_modulus U {gamma}
             */
@@ -66,6 +107,21 @@ namespace seal
 
             void reset();
 
+            /**
+            Writes the pre-computed tables to a stream as a sequence of 64-bit words that 
+            can be read back by load_aliasing().
+            */
+            void save(std::ostream &stream) const;
+
+            /**
+            Loads tables written by save() from memory, advancing data past them. The small 
+            tables are copied, while the NTT tables for the Bsk base alias the given memory, 
+            which must remain valid and unchanged for the lifetime of this object.
+
+            @throws std::invalid_argument if the data is truncated or inconsistent
+            */
+            void load_aliasing(const std::uint64_t *&data, const std::uint64_t *data_end);
+
             inline bool is_generated() const
             {
                 return generated_;
@@ -122,6 +178,10 @@ namespace seal
             }
 
         private:
+            // Aliases the Bsk NTT tables of bsk_tables_source if it is not null
+            void generate(const std::vector<SmallModulus> &coeff_base, int coeff_count, int coeff_power, 
+                const SmallModulus &small_plain_mod, const BaseConverter *bsk_tables_source);
+
             MemoryPoolHandle pool_;
             
             bool generated_ = false;
@@ -210,5 +270,58 @@ namespace seal
 
             SmallModulus gamma_;
         };
+
+        /**
+        Computes destination[k] = sum of input[i * coeff_count + k] * factors[i] modulo 
+        modulus for k < coeff_count, i.e. one output prime of a fast base conversion from 
+        input_count primes stored one after the other. The products are summed lazily in 
+        128 bits, so the sum must fit in 128 bits. Vectorized AVX2 or AVX-512 kernels are 
+        used when the CPU supports them; the output is identical to that of 
+        base_convert_dot_product_generic.
+        */
+        void base_convert_dot_product(const std::uint64_t *input, int input_count, int coeff_count,
+            const std::uint64_t *factors, const SmallModulus &modulus, std::uint64_t *destination);
+
+        // Portable scalar implementation of base_convert_dot_product
+        void base_convert_dot_product_generic(const std::uint64_t *input, int input_count, int coeff_count,
+            const std::uint64_t *factors, const SmallModulus &modulus, std::uint64_t *destination);
+
+        /**
+        Computes destination[k] = input[k] * operand modulo modulus for k < coeff_count. 
+        Vectorized kernels are used when the CPU supports them; the output is identical to 
+        that of base_convert_multiply_generic.
+        */
+        void base_convert_multiply(const std::uint64_t *input, int coeff_count, std::uint64_t operand,
+            const SmallModulus &modulus, std::uint64_t *destination);
+
+        // Portable scalar implementation of base_convert_multiply
+        void base_convert_multiply_generic(const std::uint64_t *input, int coeff_count, std::uint64_t operand,
+            const SmallModulus &modulus, std::uint64_t *destination);
+
+        /**
+        Computes destination[k] = ((input[k] + r[k] * operand1) mod modulus) * operand2 
+        modulo modulus for k < coeff_count, which is the Montgomery step of 
+        BaseConverter::mont_rq. Vectorized kernels are used when the CPU supports them; 
+        the output is identical to that of base_convert_mont_reduce_generic.
+        */
+        void base_convert_mont_reduce(const std::uint64_t *input, const std::uint64_t *r, int coeff_count,
+            std::uint64_t operand1, std::uint64_t operand2, const SmallModulus &modulus, std::uint64_t *destination);
+
+        // Portable scalar implementation of base_convert_mont_reduce
+        void base_convert_mont_reduce_generic(const std::uint64_t *input, const std::uint64_t *r, int coeff_count,
+            std::uint64_t operand1, std::uint64_t operand2, const SmallModulus &modulus, std::uint64_t *destination);
+
+        /**
+        Computes destination[k] = (input[k] + modulus - destination[k]) * operand modulo 
+        modulus for k < coeff_count, which is the last step of BaseConverter::fast_floor. 
+        Vectorized kernels are used when the CPU supports them; the output is identical 
+        to that of base_convert_floor_generic.
+        */
+        void base_convert_floor(const std::uint64_t *input, int coeff_count, std::uint64_t operand,
+            const SmallModulus &modulus, std::uint64_t *destination);
+
+        // Portable scalar implementation of base_convert_floor
+        void base_convert_floor_generic(const std::uint64_t *input, int coeff_count, std::uint64_t operand,
+            const SmallModulus &modulus, std::uint64_t *destination);
     }
 }
@@ -177,6 +177,24 @@
 #endif //(__GNUC__ == 7) && (__GNUC_MINOR__ >= 2)
 #endif //SEAL_ENABLE__SUBBORROW_U64
 
+#if defined(__x86_64__)
+// Vectorized NTT and base conversion kernels are compiled for AVX2 and AVX-512F through
+// function target attributes, and selected at runtime according to
+// what the CPU supports (see util/smallntt.cpp and util/baseconverter.cpp).
+#define SEAL_ENABLE_AVX_NTT
+#define SEAL_TARGET_AVX2 __attribute__((target("avx2")))
+#define SEAL_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// GCC fills the unused lanes of many AVX-512F intrinsics with deliberately uninitialized
+// values (_mm512_undefined_epi32), which triggers -Wuninitialized and -Wmaybe-uninitialized
+// wherever they are inlined. The AVX-512 kernels are enclosed in these to keep such builds
+// warning-free.
+#define SEAL_AVX512_DIAGNOSTIC_PUSH _Pragma("GCC diagnostic push") \
+    _Pragma("GCC diagnostic ignored \"-Wuninitialized\"") \
+    _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define SEAL_AVX512_DIAGNOSTIC_POP _Pragma("GCC diagnostic pop")
+#endif //defined(__x86_64__)
+
 #endif //SEAL_ENABLE_INTRIN
 #endif //defined(__GNUC__ >= 5) && defined(__cplusplus)
 
@@ -0,0 +1,114 @@
+#include <stdexcept>
+#include "seal/util/galoistables.h"
+#include "seal/util/common.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        GaloisTables::GaloisTables(int coeff_count_power) : coeff_count_power_(coeff_count_power)
+        {
+            if (coeff_count_power < 0)
+            {
+                throw invalid_argument("coeff_count_power cannot be negative");
+            }
+            ntt_index_tables_.resize(static_cast<size_t>(1) << coeff_count_power);
+            coeff_index_tables_.resize(static_cast<size_t>(1) << coeff_count_power);
+        }
+
+        const uint32_t *GaloisTables::ntt_index(uint64_t galois_elt) const
+        {
+            return get_table(ntt_index_tables_, galois_elt, true);
+        }
+
+        const uint32_t *GaloisTables::coeff_index(uint64_t galois_elt) const
+        {
+            return get_table(coeff_index_tables_, galois_elt, false);
+        }
+
+        const uint32_t *GaloisTables::get_table(vector<vector<uint32_t> > &tables, uint64_t galois_elt, 
+            bool is_ntt_form) const
+        {
+            uint32_t coeff_count = 1U << coeff_count_power_;
+            uint32_t m_minus_one = 2 * coeff_count - 1;
+            if (!(galois_elt & 1) || galois_elt > m_minus_one)
+            {
+                throw invalid_argument("galois element is not valid");
+            }
+
+            // A table never changes once it has been set, so it can be used after the lock
+            // is released
+            vector<uint32_t> &table = tables[galois_elt >> 1];
+            ReaderLock reader_lock(locker_.acquire_read());
+            if (!table.empty())
+            {
+                return table.data();
+            }
+            reader_lock.release();
+
+            vector<uint32_t> new_table(coeff_count);
+            if (is_ntt_form)
+            {
+                // Same mapping as apply_galois_ntt
+                for (uint32_t i = 0; i < coeff_count; i++)
+                {
+                    uint32_t reversed = reverse_bits(i, coeff_count_power_);
+                    uint64_t index_raw = galois_elt * (2 * reversed + 1);
+                    index_raw &= m_minus_one;
+                    new_table[i] = reverse_bits((static_cast<uint32_t>(index_raw) - 1) >> 1, coeff_count_power_);
+                }
+            }
+            else
+            {
+                // apply_galois moves coefficient i to i * galois_elt modulo 2N, where an index 
+                // of N or more wraps around with a negation. Conversely, coefficient j comes 
+                // from i * inverse(galois_elt) modulo 2N. The inverse of an odd number modulo 
+                // a power of two is found with Newton's iteration, each step of which doubles
+                // the number of correct low bits.
+                uint64_t inv_galois_elt = galois_elt;
+                for (int i = 0; i < 5; i++)
+                {
+                    inv_galois_elt *= 2 - galois_elt * inv_galois_elt;
+                }
+                for (uint32_t j = 0; j < coeff_count; j++)
+                {
+                    new_table[j] = static_cast<uint32_t>((j * inv_galois_elt) & m_minus_one);
+                }
+            }
+
+            WriterLock writer_lock(locker_.acquire_write());
+            if (table.empty())
+            {
+                table = move(new_table);
+            }
+            return table.data();
+        }
+
+        uint64_t row_rotation_galois_elt(int steps, int coeff_count_power)
+        {
+            uint64_t row_size = static_cast<uint64_t>(1) << (coeff_count_power - 1);
+            uint64_t m_minus_one = (static_cast<uint64_t>(1) << (coeff_count_power + 1)) - 1;
+            uint64_t pos_steps = static_cast<uint64_t>(steps < 0 ? -static_cast<int64_t>(steps) : steps);
+            if (pos_steps >= row_size)
+            {
+                throw invalid_argument("step count too large");
+            }
+
+            // A rotation to the right by s steps is a rotation to the left by N/2 - s steps
+            uint64_t exponent = (steps < 0) ? row_size - pos_steps : pos_steps;
+            uint64_t galois_elt = 1;
+            uint64_t power = 3;
+            for (; exponent > 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                {
+                    galois_elt = (galois_elt * power) & m_minus_one;
+                }
+                power = (power * power) & m_minus_one;
+            }
+            return galois_elt;
+        }
+    }
+}
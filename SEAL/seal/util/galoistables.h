@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "seal/util/locks.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Tables for applying Galois automorphisms to polynomials as gathers. In the NTT domain
+        an automorphism only permutes the values, and in coefficient form it permutes the 
+        coefficients and negates some of them. The table of a Galois element is computed the
+        first time it is needed, and is then kept for the lifetime of the object. Getting a
+        table is thread-safe.
+        */
+        class GaloisTables
+        {
+        public:
+            /**
+            Creates an empty set of tables for polynomials with 2^coeff_count_power 
+            coefficients.
+
+            @param[in] coeff_count_power The base-2 logarithm of the number of coefficients
+            @throws std::invalid_argument if coeff_count_power is negative
+            */
+            GaloisTables(int coeff_count_power);
+
+            /**
+            Returns the table of the given Galois element in the NTT domain: applying the
+            automorphism moves the value at index table[i] to index i. The table has one 
+            entry for each of the 2^coeff_count_power coefficients, and stays valid for the
+            lifetime of the GaloisTables.
+
+            @param[in] galois_elt The Galois element
+            @throws std::invalid_argument if galois_elt is not valid
+            */
+            const std::uint32_t *ntt_index(std::uint64_t galois_elt) const;
+
+            /**
+            Returns the table of the given Galois element in coefficient form. With N being
+            2^coeff_count_power, applying the automorphism moves the coefficient at index
+            table[j] modulo N to index j, and negates it if table[j] is at least N. The table 
+            has one entry for each of the N coefficients, and stays valid for the lifetime of
+            the GaloisTables.
+
+            @param[in] galois_elt The Galois element
+            @throws std::invalid_argument if galois_elt is not valid
+            */
+            const std::uint32_t *coeff_index(std::uint64_t galois_elt) const;
+
+            inline int coeff_count_power() const
+            {
+                return coeff_count_power_;
+            }
+
+        private:
+            GaloisTables(const GaloisTables &copy) = delete;
+
+            GaloisTables &operator =(const GaloisTables &assign) = delete;
+
+            const std::uint32_t *get_table(std::vector<std::vector<std::uint32_t> > &tables, 
+                std::uint64_t galois_elt, bool is_ntt_form) const;
+
+            int coeff_count_power_;
+
+            // Indexed by (galois_elt - 1) / 2; empty until first needed
+            mutable std::vector<std::vector<std::uint32_t> > ntt_index_tables_;
+
+            mutable std::vector<std::vector<std::uint32_t> > coeff_index_tables_;
+
+            mutable ReaderWriterLocker locker_;
+        };
+
+        /**
+        Returns the Galois element 3^steps modulo 2N that rotates the rows of a batched 
+        plaintext by steps to the left, or by -steps to the right if steps is negative, where
+        N is 2^coeff_count_power.
+
+        @param[in] steps The number of steps to rotate
+        @param[in] coeff_count_power The base-2 logarithm of N
+        @throws std::invalid_argument if the absolute value of steps is not less than N/2
+        */
+        std::uint64_t row_rotation_galois_elt(int steps, int coeff_count_power);
+    }
+}
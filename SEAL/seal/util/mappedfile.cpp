@@ -0,0 +1,113 @@
+#include "seal/util/mappedfile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+#ifdef _WIN32
+        MappedFile::MappedFile(const string &path)
+        {
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                throw runtime_error("failed to open file");
+            }
+            file_handle_ = file;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size))
+            {
+                CloseHandle(file);
+                throw runtime_error("failed to read file size");
+            }
+            byte_count_ = static_cast<size_t>(size.QuadPart);
+            if (byte_count_ == 0)
+            {
+                // Empty files cannot be mapped
+                return;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr)
+            {
+                CloseHandle(file);
+                throw runtime_error("failed to map file");
+            }
+            mapping_handle_ = mapping;
+
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view == nullptr)
+            {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                throw runtime_error("failed to map file");
+            }
+            data_ = static_cast<const uint64_t*>(view);
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (data_ != nullptr)
+            {
+                UnmapViewOfFile(data_);
+            }
+            if (mapping_handle_ != nullptr)
+            {
+                CloseHandle(mapping_handle_);
+            }
+            CloseHandle(file_handle_);
+        }
+#else
+        MappedFile::MappedFile(const string &path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw runtime_error("failed to open file");
+            }
+
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0)
+            {
+                close(fd);
+                throw runtime_error("failed to read file size");
+            }
+            byte_count_ = static_cast<size_t>(file_stat.st_size);
+            if (byte_count_ == 0)
+            {
+                // Empty files cannot be mapped
+                close(fd);
+                return;
+            }
+
+            // The mapping stays valid after the file descriptor is closed
+            void *view = mmap(nullptr, byte_count_, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (view == MAP_FAILED)
+            {
+                throw runtime_error("failed to map file");
+            }
+            data_ = static_cast<const uint64_t*>(view);
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (data_ != nullptr)
+            {
+                munmap(const_cast<uint64_t*>(data_), byte_count_);
+            }
+        }
+#endif
+    }
+}
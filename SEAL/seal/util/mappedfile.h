@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        A read-only memory mapping of an entire file, viewed as an array of 64-bit words.
+        Pages of the mapping are shared by all processes mapping the same file, and are
+        loaded from disk only when first touched.
+        */
+        class MappedFile
+        {
+        public:
+            /**
+            Maps the file at the given path into memory.
+
+            @param[in] path The path of the file to map
+            @throws std::runtime_error if the file could not be opened or mapped
+            */
+            MappedFile(const std::string &path);
+
+            ~MappedFile();
+
+            inline const std::uint64_t *data() const
+            {
+                return data_;
+            }
+
+            inline std::size_t uint64_count() const
+            {
+                return byte_count_ / sizeof(std::uint64_t);
+            }
+
+        private:
+            MappedFile(const MappedFile &copy) = delete;
+
+            MappedFile &operator =(const MappedFile &assign) = delete;
+
+            const std::uint64_t *data_ = nullptr;
+
+            std::size_t byte_count_ = 0;
+
+#ifdef _WIN32
+            void *file_handle_ = nullptr;
+
+            void *mapping_handle_ = nullptr;
+#endif
+        };
+
+        /**
+        Writes uint64_count words to the stream.
+        */
+        inline void write_words(std::ostream &stream, const std::uint64_t *words, std::size_t uint64_count)
+        {
+            stream.write(reinterpret_cast<const char*>(words), uint64_count * sizeof(std::uint64_t));
+        }
+
+        /**
+        Returns a pointer to the next uint64_count words between data and data_end, and
+        advances data past them.
+
+        @throws std::invalid_argument if fewer than uint64_count words are left
+        */
+        inline const std::uint64_t *read_words(const std::uint64_t *&data, const std::uint64_t *data_end,
+            std::size_t uint64_count)
+        {
+            if (static_cast<std::size_t>(data_end - data) < uint64_count)
+            {
+                throw std::invalid_argument("data is truncated");
+            }
+            const std::uint64_t *words = data;
+            data += uint64_count;
+            return words;
+        }
+    }
+}
@@ -6,6 +6,7 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polyfftmultsmallmod.h"
 #include "seal/util/defines.h"
+#include "seal/util/avxarith.h"
 
 using namespace std;
 
@@ -693,5 +694,122 @@ namespace seal
             }
             set_uint_uint(intermediateptr, poly_modulus_coeff_count, result);
         }
+
+        void apply_galois_generic(const uint64_t *input, int coeff_count_power, const uint32_t *coeff_index,
+            const SmallModulus &modulus, uint64_t *result)
+        {
+            const uint64_t modulus_value = modulus.value();
+            uint32_t coeff_count = 1U << coeff_count_power;
+            uint32_t coeff_count_minus_one = coeff_count - 1;
+            for (uint32_t j = 0; j < coeff_count; j++)
+            {
+                uint32_t index_raw = coeff_index[j];
+                uint64_t result_value = input[index_raw & coeff_count_minus_one];
+                if (index_raw >> coeff_count_power)
+                {
+                    int64_t non_zero = (result_value != 0);
+                    result_value = (modulus_value - result_value) & static_cast<uint64_t>(-non_zero);
+                }
+                result[j] = result_value;
+            }
+        }
+
+#ifdef SEAL_ENABLE_AVX_NTT
+        namespace
+        {
+            // The coefficients are gathered by their indices, and negated where both the 
+            // negation bit of the index is set and the coefficient is non-zero
+            SEAL_TARGET_AVX2 void apply_galois_avx2(const uint64_t *input, int coeff_count_power, 
+                const uint32_t *coeff_index, const SmallModulus &modulus, uint64_t *result)
+            {
+                int coeff_count = 1 << coeff_count_power;
+                int vector_coeff_count = coeff_count & ~3;
+                const __m128i index_mask = _mm_set1_epi32(coeff_count - 1);
+                const __m128i negate_shift = _mm_cvtsi32_si128(coeff_count_power);
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus.value()));
+                const __m256i zero = _mm256_setzero_si256();
+                for (int j = 0; j < vector_coeff_count; j += 4)
+                {
+                    __m128i index_raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeff_index + j));
+                    __m256i x = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(input), 
+                        _mm_and_si128(index_raw, index_mask), 8);
+                    __m256i negate = _mm256_sub_epi64(zero, 
+                        _mm256_cvtepu32_epi64(_mm_srl_epi32(index_raw, negate_shift)));
+                    negate = _mm256_andnot_si256(_mm256_cmpeq_epi64(x, zero), negate);
+                    x = _mm256_blendv_epi8(x, _mm256_sub_epi64(vec_modulus, x), negate);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + j), x);
+                }
+                if (vector_coeff_count < coeff_count)
+                {
+                    apply_galois_generic(input, coeff_count_power, coeff_index, modulus, result);
+                }
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_PUSH
+
+            SEAL_TARGET_AVX512 void apply_galois_avx512(const uint64_t *input, int coeff_count_power, 
+                const uint32_t *coeff_index, const SmallModulus &modulus, uint64_t *result)
+            {
+                int coeff_count = 1 << coeff_count_power;
+                int vector_coeff_count = coeff_count & ~7;
+                const __m256i index_mask = _mm256_set1_epi32(coeff_count - 1);
+                const __m512i negate_bit = _mm512_set1_epi64(static_cast<long long>(coeff_count));
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus.value()));
+                for (int j = 0; j < vector_coeff_count; j += 8)
+                {
+                    __m256i index_raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coeff_index + j));
+                    __m512i x = _mm512_i32gather_epi64(_mm256_and_si256(index_raw, index_mask), 
+                        reinterpret_cast<const long long*>(input), 8);
+                    __mmask8 negate = _mm512_test_epi64_mask(_mm512_cvtepu32_epi64(index_raw), negate_bit);
+                    negate &= _mm512_test_epi64_mask(x, x);
+                    x = _mm512_mask_sub_epi64(x, negate, vec_modulus, x);
+                    _mm512_storeu_si512(reinterpret_cast<void*>(result + j), x);
+                }
+                if (vector_coeff_count < coeff_count)
+                {
+                    apply_galois_generic(input, coeff_count_power, coeff_index, modulus, result);
+                }
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_POP
+        }
+#endif
+        namespace
+        {
+            typedef void(*apply_galois_type)(const uint64_t *input, int coeff_count_power, 
+                const uint32_t *coeff_index, const SmallModulus &modulus, uint64_t *result);
+
+            struct GaloisKernels
+            {
+#ifdef SEAL_ENABLE_AVX_NTT
+                GaloisKernels()
+                {
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx512f"))
+                    {
+                        apply_galois = apply_galois_avx512;
+                    }
+                    else if (__builtin_cpu_supports("avx2"))
+                    {
+                        apply_galois = apply_galois_avx2;
+                    }
+                }
+#endif
+                apply_galois_type apply_galois = apply_galois_generic;
+            };
+
+            // The CPU is queried only once; initialization of the local static is thread-safe.
+            inline const GaloisKernels &galois_kernels()
+            {
+                static const GaloisKernels kernels;
+                return kernels;
+            }
+        }
+
+        void apply_galois(const uint64_t *input, int coeff_count_power, const uint32_t *coeff_index,
+            const SmallModulus &modulus, uint64_t *result)
+        {
+            galois_kernels().apply_galois(input, coeff_count_power, coeff_index, modulus, result);
+        }
     }
 }
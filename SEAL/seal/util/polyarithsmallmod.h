@@ -432,7 +432,7 @@ namespace seal
             }
 #endif
             std::uint32_t coeff_count = 1U << coeff_count_power;
-            std::uint32_t m_minus_one = 2 * coeff_count;
+            std::uint32_t m_minus_one = 2 * coeff_count - 1;
             for (std::uint32_t i = 0; i < coeff_count; i++)
             {
                 std::uint32_t reversed = reverse_bits(i, coeff_count_power);
@@ -443,6 +443,44 @@ namespace seal
             }
         }
 
+        // Same as apply_galois_ntt, with the index table of the Galois element from GaloisTables
+        inline void apply_galois_ntt(const std::uint64_t *input, int coeff_count, const std::uint32_t *ntt_index,
+            std::uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (input == nullptr)
+            {
+                throw std::invalid_argument("input");
+            }
+            if (ntt_index == nullptr)
+            {
+                throw std::invalid_argument("ntt_index");
+            }
+            if (result == nullptr)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (input == result)
+            {
+                throw std::invalid_argument("result cannot point to the same value as input");
+            }
+#endif
+            for (int i = 0; i < coeff_count; i++)
+            {
+                result[i] = input[ntt_index[i]];
+            }
+        }
+
+        // Same as apply_galois, with the index table of the Galois element from GaloisTables. 
+        // Vectorized AVX2 or AVX-512 kernels are used when the CPU supports them; the output is
+        // identical to that of apply_galois_generic.
+        void apply_galois(const std::uint64_t *input, int coeff_count_power, const std::uint32_t *coeff_index,
+            const SmallModulus &modulus, std::uint64_t *result);
+
+        // Portable scalar implementation of apply_galois with an index table
+        void apply_galois_generic(const std::uint64_t *input, int coeff_count_power, const std::uint32_t *coeff_index,
+            const SmallModulus &modulus, std::uint64_t *result);
+
         inline void dyadic_product_coeffmod(const std::uint64_t *operand1, const std::uint64_t *operand2, 
             int coeff_count, const SmallModulus &modulus, std::uint64_t *result)
         {
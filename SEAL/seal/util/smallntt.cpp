@@ -5,6 +5,8 @@
 #include "seal/smallmodulus.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/defines.h"
+#include "seal/util/mappedfile.h"
+#include "seal/util/avxarith.h"
 #include <algorithm>
 
 using namespace std;
@@ -164,6 +166,80 @@ namespace seal
             return *this;
         }
 
+        void SmallNTTTables::save(ostream &stream) const
+        {
+            uint64_t header[5]{ static_cast<uint64_t>(generated_), static_cast<uint64_t>(coeff_count_power_),
+                modulus_.value(), root_, inv_degree_modulo_ };
+            write_words(stream, header, 5);
+            if (generated_)
+            {
+                write_words(stream, root_powers_.get(), coeff_count_);
+                write_words(stream, scaled_root_powers_.get(), coeff_count_);
+                write_words(stream, inv_root_powers_.get(), coeff_count_);
+                write_words(stream, scaled_inv_root_powers_.get(), coeff_count_);
+                write_words(stream, inv_root_powers_div_two_.get(), coeff_count_);
+                write_words(stream, scaled_inv_root_powers_div_two_.get(), coeff_count_);
+            }
+        }
+
+        void SmallNTTTables::load_aliasing(const uint64_t *&data, const uint64_t *data_end)
+        {
+            reset();
+
+            const uint64_t *header = read_words(data, data_end, 5);
+            if (header[1] >= bits_per_uint64 / 2 - 1)
+            {
+                throw invalid_argument("invalid coeff_count_power");
+            }
+            if (!header[0])
+            {
+                return;
+            }
+            coeff_count_power_ = static_cast<int>(header[1]);
+            coeff_count_ = 1 << coeff_count_power_;
+            modulus_ = header[2];
+            root_ = header[3];
+            inv_degree_modulo_ = header[4];
+
+            // The tables are only ever read, so aliasing read-only memory is safe
+            auto alias_next = [&]() {
+                return Pointer::Aliasing(const_cast<uint64_t*>(read_words(data, data_end, coeff_count_)));
+            };
+            root_powers_ = alias_next();
+            scaled_root_powers_ = alias_next();
+            inv_root_powers_ = alias_next();
+            scaled_inv_root_powers_ = alias_next();
+            inv_root_powers_div_two_ = alias_next();
+            scaled_inv_root_powers_div_two_ = alias_next();
+            generated_ = true;
+        }
+
+        void SmallNTTTables::alias(const SmallNTTTables &source)
+        {
+            reset();
+            if (!source.generated_)
+            {
+                return;
+            }
+            coeff_count_power_ = source.coeff_count_power_;
+            coeff_count_ = source.coeff_count_;
+            modulus_ = source.modulus_;
+            root_ = source.root_;
+            inv_degree_modulo_ = source.inv_degree_modulo_;
+
+            // The tables are only ever read, so aliasing the tables of source is safe
+            auto alias_table = [](const Pointer &table) {
+                return Pointer::Aliasing(const_cast<uint64_t*>(table.get()));
+            };
+            root_powers_ = alias_table(source.root_powers_);
+            scaled_root_powers_ = alias_table(source.scaled_root_powers_);
+            inv_root_powers_ = alias_table(source.inv_root_powers_);
+            scaled_inv_root_powers_ = alias_table(source.scaled_inv_root_powers_);
+            inv_root_powers_div_two_ = alias_table(source.inv_root_powers_div_two_);
+            scaled_inv_root_powers_div_two_ = alias_table(source.scaled_inv_root_powers_div_two_);
+            generated_ = true;
+        }
+
         void SmallNTTTables::ntt_powers_of_primitive_root(uint64_t root, uint64_t *destination) const
         {
             uint64_t *destination_start = destination;
@@ -188,6 +264,247 @@ namespace seal
             }
         }
 
+        namespace
+        {
+            // Signature of a pass applying one or two NTT stages to the butterfly groups
+            // [i_begin, i_end) of the stage whose first twiddle index is m (forward) or 
+            // h (inverse), and whose butterflies have span t.
+            typedef void(*ntt_pass_type)(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end);
+
+            // Late forward stages and early inverse stages are run depth-first on blocks 
+            // of this many coefficients so that several stages are done while the block 
+            // is in L1.
+            const int ntt_block_coeff_count = 2048;
+
+            // The Harvey butterfly: assume X, Y in [0, 4q), and return X', Y' in [0, 4q).
+            // X', Y' = X + WY, X - WY (mod q).
+            inline void ntt_butterfly(uint64_t *X, uint64_t *Y, uint64_t W, uint64_t Wprime, 
+                uint64_t modulus, uint64_t two_times_modulus)
+            {
+                uint64_t currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
+                uint64_t Q;
+                multiply_uint64_hw64(Wprime, *Y, &Q);
+                Q = W * *Y - Q * modulus;
+                *X = currX + Q;
+                *Y = currX + (two_times_modulus - Q);
+            }
+
+            // The inverse Harvey butterfly: assume U, V in [0, 2q), and return U', V' in [0, 2q).
+            // U', V' = (U + V) / 2, W(U - V) (mod q), where W already includes the factor 1/2.
+            inline void inverse_ntt_butterfly(uint64_t *U, uint64_t *V, uint64_t W, uint64_t Wprime,
+                uint64_t modulus, uint64_t two_times_modulus)
+            {
+                // Compute U - V + 2q
+                uint64_t T = two_times_modulus - *V + *U;
+
+                // Cleverly check whether U + V >= two_times_modulus
+                uint64_t currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
+
+                // We use also the fact that parity of currU is same as parity of T.
+                // Since our modulus is always so small that currU + masked_modulus < 2^64,
+                // we never need to worry about wrapping around when adding masked_modulus.
+                *U = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
+
+                uint64_t H;
+                multiply_uint64_hw64(Wprime, T, &H);
+                // effectively, the next two multiply perform multiply modulo beta = 2**wordsize. 
+                *V = W * T - H * modulus;
+            }
+
+            void ntt_radix2_pass_generic(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                uint64_t modulus = tables.modulus().value();
+                uint64_t two_times_modulus = modulus * 2;
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const uint64_t W = tables.get_from_root_powers(m + i);
+                    const uint64_t Wprime = tables.get_from_scaled_root_powers(m + i);
+
+                    uint64_t *X = operand + 2 * i * t;
+                    uint64_t *Y = X + t;
+                    for (int j = 0; j < t; j++)
+                    {
+                        ntt_butterfly(X++, Y++, W, Wprime, modulus, two_times_modulus);
+                    }
+                }
+            }
+
+            // Fuses the stages (m, t) and (2m, t/2) into radix-4 butterflies, so that each
+            // coefficient is loaded and stored once for the two stages. Requires t >= 2.
+            void ntt_radix4_pass_generic(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                uint64_t modulus = tables.modulus().value();
+                uint64_t two_times_modulus = modulus * 2;
+                int half_t = t >> 1;
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const uint64_t W1 = tables.get_from_root_powers(m + i);
+                    const uint64_t W1prime = tables.get_from_scaled_root_powers(m + i);
+                    const uint64_t W2 = tables.get_from_root_powers(2 * (m + i));
+                    const uint64_t W2prime = tables.get_from_scaled_root_powers(2 * (m + i));
+                    const uint64_t W3 = tables.get_from_root_powers(2 * (m + i) + 1);
+                    const uint64_t W3prime = tables.get_from_scaled_root_powers(2 * (m + i) + 1);
+
+                    uint64_t *X0 = operand + 2 * i * t;
+                    uint64_t *X1 = X0 + half_t;
+                    uint64_t *X2 = X0 + t;
+                    uint64_t *X3 = X2 + half_t;
+                    for (int j = 0; j < half_t; j++, X0++, X1++, X2++, X3++)
+                    {
+                        ntt_butterfly(X0, X2, W1, W1prime, modulus, two_times_modulus);
+                        ntt_butterfly(X1, X3, W1, W1prime, modulus, two_times_modulus);
+                        ntt_butterfly(X0, X1, W2, W2prime, modulus, two_times_modulus);
+                        ntt_butterfly(X2, X3, W3, W3prime, modulus, two_times_modulus);
+                    }
+                }
+            }
+
+            void inverse_ntt_radix2_pass_generic(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                uint64_t modulus = tables.modulus().value();
+                uint64_t two_times_modulus = modulus * 2;
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    // Need the powers of phi^{-1} in bit-reversed order
+                    const uint64_t W = tables.get_from_inv_root_powers_div_two(h + i);
+                    const uint64_t Wprime = tables.get_from_scaled_inv_root_powers_div_two(h + i);
+
+                    uint64_t *U = operand + 2 * i * t;
+                    uint64_t *V = U + t;
+                    for (int j = 0; j < t; j++)
+                    {
+                        inverse_ntt_butterfly(U++, V++, W, Wprime, modulus, two_times_modulus);
+                    }
+                }
+            }
+
+            // Fuses the stages (h, t) and (h/2, 2t) into radix-4 butterflies. Requires h >= 2 
+            // and an even i_begin.
+            void inverse_ntt_radix4_pass_generic(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                uint64_t modulus = tables.modulus().value();
+                uint64_t two_times_modulus = modulus * 2;
+                for (int i = i_begin; i < i_end; i += 2)
+                {
+                    const uint64_t W1 = tables.get_from_inv_root_powers_div_two(h + i);
+                    const uint64_t W1prime = tables.get_from_scaled_inv_root_powers_div_two(h + i);
+                    const uint64_t W2 = tables.get_from_inv_root_powers_div_two(h + i + 1);
+                    const uint64_t W2prime = tables.get_from_scaled_inv_root_powers_div_two(h + i + 1);
+                    const uint64_t W3 = tables.get_from_inv_root_powers_div_two((h + i) >> 1);
+                    const uint64_t W3prime = tables.get_from_scaled_inv_root_powers_div_two((h + i) >> 1);
+
+                    uint64_t *U0 = operand + 2 * i * t;
+                    uint64_t *U1 = U0 + t;
+                    uint64_t *U2 = U1 + t;
+                    uint64_t *U3 = U2 + t;
+                    for (int j = 0; j < t; j++, U0++, U1++, U2++, U3++)
+                    {
+                        inverse_ntt_butterfly(U0, U1, W1, W1prime, modulus, two_times_modulus);
+                        inverse_ntt_butterfly(U2, U3, W2, W2prime, modulus, two_times_modulus);
+                        inverse_ntt_butterfly(U0, U2, W3, W3prime, modulus, two_times_modulus);
+                        inverse_ntt_butterfly(U1, U3, W3, W3prime, modulus, two_times_modulus);
+                    }
+                }
+            }
+
+            // Runs the forward stages breadth-first with radix-4 passes while a butterfly
+            // group is larger than a block, and then depth-first block by block. Every 
+            // coefficient goes through exactly the same butterflies as in the textbook 
+            // stage-by-stage order, so the result does not depend on the schedule.
+            void ntt_negacyclic_harvey_lazy_scheduled(uint64_t *operand, const SmallNTTTables &tables,
+                ntt_pass_type radix2_pass, ntt_pass_type radix4_pass)
+            {
+                int n = 1 << tables.coeff_count_power();
+                int block = min(n, ntt_block_coeff_count);
+                int m = 1;
+                int t = n >> 1;
+                while ((t << 1) > block)
+                {
+                    radix4_pass(operand, tables, m, t, 0, m);
+                    m <<= 2;
+                    t >>= 2;
+                }
+
+                for (int block_start = 0; block_start < n; block_start += block)
+                {
+                    int block_m = m;
+                    int block_t = t;
+                    while (block_m < n)
+                    {
+                        int i_begin = block_start / (block_t << 1);
+                        int i_end = i_begin + block / (block_t << 1);
+                        if (block_t >= 2)
+                        {
+                            radix4_pass(operand, tables, block_m, block_t, i_begin, i_end);
+                            block_m <<= 2;
+                            block_t >>= 2;
+                        }
+                        else
+                        {
+                            radix2_pass(operand, tables, block_m, block_t, i_begin, i_end);
+                            block_m <<= 1;
+                            block_t >>= 1;
+                        }
+                    }
+                }
+            }
+
+            // Runs the inverse stages depth-first block by block while the butterflies fit 
+            // in a block, and then breadth-first with radix-4 passes.
+            void inverse_ntt_negacyclic_harvey_lazy_scheduled(uint64_t *operand, const SmallNTTTables &tables,
+                ntt_pass_type radix2_pass, ntt_pass_type radix4_pass)
+            {
+                int n = 1 << tables.coeff_count_power();
+                int block = min(n, ntt_block_coeff_count);
+                int h = n >> 1;
+                int t = 1;
+                for (int block_start = 0; block_start < n; block_start += block)
+                {
+                    int block_h = n >> 1;
+                    int block_t = 1;
+                    while (block_h > 0)
+                    {
+                        int i_begin = block_start / (block_t << 1);
+                        int i_end = i_begin + block / (block_t << 1);
+                        if (block_h >= 2 && (block_t << 2) <= block)
+                        {
+                            radix4_pass(operand, tables, block_h, block_t, i_begin, i_end);
+                            block_h >>= 2;
+                            block_t <<= 2;
+                        }
+                        else if ((block_t << 1) <= block)
+                        {
+                            radix2_pass(operand, tables, block_h, block_t, i_begin, i_end);
+                            block_h >>= 1;
+                            block_t <<= 1;
+                        }
+                        else
+                        {
+                            break;
+                        }
+                    }
+                    h = block_h;
+                    t = block_t;
+                }
+
+                while (h > 0)
+                {
+                    if (h >= 2)
+                    {
+                        radix4_pass(operand, tables, h, t, 0, h);
+                        h >>= 2;
+                        t <<= 2;
+                    }
+                    else
+                    {
+                        radix2_pass(operand, tables, h, t, 0, h);
+                        h >>= 1;
+                        t <<= 1;
+                    }
+                }
+            }
+        }
+
         /**
         This function computes in-place the negacyclic NTT. The input is a polynomial a of degree n in R_q,
         where n is assumed to be a power of 2 and q is a prime such that q = 1 (mod 2n).
@@ -197,186 +514,471 @@ namespace seal
 
         For details, see Michael Naehrig and Patrick Longa.
         */
-        void ntt_negacyclic_harvey_lazy(uint64_t *operand, const SmallNTTTables &tables)
+        void ntt_negacyclic_harvey_lazy_generic(uint64_t *operand, const SmallNTTTables &tables)
+        {
+            ntt_negacyclic_harvey_lazy_scheduled(operand, tables, ntt_radix2_pass_generic, ntt_radix4_pass_generic);
+        }
+
+        // Inverse negacyclic NTT using Harvey's butterfly. (See Patrick Longa and Michael Naehrig). 
+        void inverse_ntt_negacyclic_harvey_lazy_generic(uint64_t *operand, const SmallNTTTables &tables)
+        {
+            inverse_ntt_negacyclic_harvey_lazy_scheduled(operand, tables, inverse_ntt_radix2_pass_generic, inverse_ntt_radix4_pass_generic);
+        }
+
+#ifdef SEAL_ENABLE_AVX_NTT
+        namespace
         {
-            uint64_t modulus = tables.modulus().value();
-            uint64_t two_times_modulus = modulus * 2;
-            
-            // Return the NTT in scrambled order
-            int n = 1 << tables.coeff_count_power();
-            int t = n >> 1;
-            for (int m = 1; m < n; m <<= 1)
-            {
-                if (t >= 4)
+            // Four forward butterflies at once; same arithmetic as ntt_butterfly
+            SEAL_TARGET_AVX2 inline void ntt_butterfly_avx2(uint64_t *X, uint64_t *Y, __m256i W, __m256i Wprime,
+                __m256i modulus, __m256i two_times_modulus)
+            {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(X));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Y));
+                __m256i below = cmpgt_epu64_avx2(two_times_modulus, x);
+                __m256i currX = _mm256_sub_epi64(x, _mm256_andnot_si256(below, two_times_modulus));
+                __m256i Q = mulhi_epu64_avx2(Wprime, y);
+                Q = _mm256_sub_epi64(mullo_epi64_avx2(W, y), mullo_epi64_avx2(Q, modulus));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(X), _mm256_add_epi64(currX, Q));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(Y),
+                    _mm256_add_epi64(currX, _mm256_sub_epi64(two_times_modulus, Q)));
+            }
+
+            // Four inverse butterflies at once; same arithmetic as inverse_ntt_butterfly
+            SEAL_TARGET_AVX2 inline void inverse_ntt_butterfly_avx2(uint64_t *U, uint64_t *V, __m256i W, __m256i Wprime,
+                __m256i modulus, __m256i two_times_modulus)
+            {
+                __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(U));
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(V));
+                __m256i T = _mm256_add_epi64(_mm256_sub_epi64(two_times_modulus, v), u);
+                __m256i below = cmpgt_epu64_avx2(T, _mm256_slli_epi64(u, 1));
+                __m256i currU = _mm256_sub_epi64(_mm256_add_epi64(u, v), _mm256_andnot_si256(below, two_times_modulus));
+                __m256i odd = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(T, _mm256_set1_epi64x(1)));
+                currU = _mm256_add_epi64(currU, _mm256_and_si256(odd, modulus));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(U), _mm256_srli_epi64(currU, 1));
+                __m256i H = mulhi_epu64_avx2(Wprime, T);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(V),
+                    _mm256_sub_epi64(mullo_epi64_avx2(W, T), mullo_epi64_avx2(H, modulus)));
+            }
+
+            SEAL_TARGET_AVX2 void ntt_radix2_pass_avx2(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                if (t < 4)
+                {
+                    ntt_radix2_pass_generic(operand, tables, m, t, i_begin, i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i vec_two_times_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
                 {
-                    for (int i = 0; i < m; i++)
+                    const __m256i W = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_root_powers(m + i)));
+                    const __m256i Wprime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_root_powers(m + i)));
+
+                    uint64_t *X = operand + 2 * i * t;
+                    uint64_t *Y = X + t;
+                    for (int j = 0; j < t; j += 4, X += 4, Y += 4)
                     {
-                        int j1 = 2 * i * t;
-                        int j2 = j1 + t;
-                        const uint64_t W = tables.get_from_root_powers(m + i);
-                        const uint64_t Wprime = tables.get_from_scaled_root_powers(m + i);
-
-                        uint64_t *X = operand + j1;
-                        uint64_t *Y = X + t;
-                        uint64_t currX;
-                        uint64_t Q;
-                        for (int j = j1; j < j2; j += 4)
-                        {
-                            currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
-                            multiply_uint64_hw64(Wprime, *Y, &Q);
-                            Q = *Y * W - Q * modulus;
-                            *X++ = currX + Q;
-                            *Y++ = currX + (two_times_modulus - Q);
-
-                            currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
-                            multiply_uint64_hw64(Wprime, *Y, &Q);
-                            Q = *Y * W - Q * modulus;
-                            *X++ = currX + Q;
-                            *Y++ = currX + (two_times_modulus - Q);
-
-                            currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
-                            multiply_uint64_hw64(Wprime, *Y, &Q);
-                            Q = *Y * W - Q * modulus;
-                            *X++ = currX + Q;
-                            *Y++ = currX + (two_times_modulus - Q);
-
-                            currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
-                            multiply_uint64_hw64(Wprime, *Y, &Q);
-                            Q = *Y * W - Q * modulus;
-                            *X++ = currX + Q;
-                            *Y++ = currX + (two_times_modulus - Q);
-                        }
+                        ntt_butterfly_avx2(X, Y, W, Wprime, vec_modulus, vec_two_times_modulus);
                     }
                 }
-                else
+            }
+
+            SEAL_TARGET_AVX2 void ntt_radix4_pass_avx2(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                int half_t = t >> 1;
+                if (half_t < 4)
+                {
+                    ntt_radix2_pass_avx2(operand, tables, m, t, i_begin, i_end);
+                    ntt_radix2_pass_avx2(operand, tables, 2 * m, half_t, 2 * i_begin, 2 * i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i vec_two_times_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
                 {
-                    for (int i = 0; i < m; i++)
+                    const __m256i W1 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_root_powers(m + i)));
+                    const __m256i W1prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_root_powers(m + i)));
+                    const __m256i W2 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_root_powers(2 * (m + i))));
+                    const __m256i W2prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_root_powers(2 * (m + i))));
+                    const __m256i W3 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_root_powers(2 * (m + i) + 1)));
+                    const __m256i W3prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_root_powers(2 * (m + i) + 1)));
+
+                    uint64_t *X0 = operand + 2 * i * t;
+                    uint64_t *X1 = X0 + half_t;
+                    uint64_t *X2 = X0 + t;
+                    uint64_t *X3 = X2 + half_t;
+                    for (int j = 0; j < half_t; j += 4, X0 += 4, X1 += 4, X2 += 4, X3 += 4)
                     {
-                        int j1 = 2 * i * t;
-                        int j2 = j1 + t;
-                        const uint64_t W = tables.get_from_root_powers(m + i);
-                        const uint64_t Wprime = tables.get_from_scaled_root_powers(m + i);
-
-                        uint64_t *X = operand + j1;
-                        uint64_t *Y = X + t;
-                        uint64_t currX;
-                        uint64_t Q;
-                        for (int j = j1; j < j2; j++)
-                        {
-                            // The Harvey butterfly: assume X, Y in [0, 2p), and return X', Y' in [0, 2p).
-                            // X', Y' = X + WY, X - WY (mod p).
-                            currX = *X - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(*X >= two_times_modulus)));
-                            multiply_uint64_hw64(Wprime, *Y, &Q);
-                            Q = W * *Y - Q * modulus;
-                            *X++ = currX + Q;
-                            *Y++ = currX + (two_times_modulus - Q);
-                        }
+                        ntt_butterfly_avx2(X0, X2, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx2(X1, X3, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx2(X0, X1, W2, W2prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx2(X2, X3, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_TARGET_AVX2 void inverse_ntt_radix2_pass_avx2(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                if (t < 4)
+                {
+                    inverse_ntt_radix2_pass_generic(operand, tables, h, t, i_begin, i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i vec_two_times_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const __m256i W = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i)));
+                    const __m256i Wprime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i)));
+
+                    uint64_t *U = operand + 2 * i * t;
+                    uint64_t *V = U + t;
+                    for (int j = 0; j < t; j += 4, U += 4, V += 4)
+                    {
+                        inverse_ntt_butterfly_avx2(U, V, W, Wprime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_TARGET_AVX2 void inverse_ntt_radix4_pass_avx2(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                if (t < 4)
+                {
+                    inverse_ntt_radix2_pass_avx2(operand, tables, h, t, i_begin, i_end);
+                    inverse_ntt_radix2_pass_avx2(operand, tables, h >> 1, t << 1, i_begin >> 1, i_end >> 1);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m256i vec_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i vec_two_times_modulus = _mm256_set1_epi64x(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i += 2)
+                {
+                    const __m256i W1 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i)));
+                    const __m256i W1prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i)));
+                    const __m256i W2 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i + 1)));
+                    const __m256i W2prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i + 1)));
+                    const __m256i W3 = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_inv_root_powers_div_two((h + i) >> 1)));
+                    const __m256i W3prime = _mm256_set1_epi64x(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two((h + i) >> 1)));
+
+                    uint64_t *U0 = operand + 2 * i * t;
+                    uint64_t *U1 = U0 + t;
+                    uint64_t *U2 = U1 + t;
+                    uint64_t *U3 = U2 + t;
+                    for (int j = 0; j < t; j += 4, U0 += 4, U1 += 4, U2 += 4, U3 += 4)
+                    {
+                        inverse_ntt_butterfly_avx2(U0, U1, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx2(U2, U3, W2, W2prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx2(U0, U2, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx2(U1, U3, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_PUSH
+
+            // Eight forward butterflies at once; same arithmetic as ntt_butterfly
+            SEAL_TARGET_AVX512 inline void ntt_butterfly_avx512(uint64_t *X, uint64_t *Y, __m512i W, __m512i Wprime,
+                __m512i modulus, __m512i two_times_modulus)
+            {
+                __m512i x = _mm512_loadu_si512(X);
+                __m512i y = _mm512_loadu_si512(Y);
+                __mmask8 reduce = _mm512_cmpge_epu64_mask(x, two_times_modulus);
+                __m512i currX = _mm512_mask_sub_epi64(x, reduce, x, two_times_modulus);
+                __m512i Q = mulhi_epu64_avx512(Wprime, y);
+                Q = _mm512_sub_epi64(mullo_epi64_avx512(W, y), mullo_epi64_avx512(Q, modulus));
+                _mm512_storeu_si512(X, _mm512_add_epi64(currX, Q));
+                _mm512_storeu_si512(Y, _mm512_add_epi64(currX, _mm512_sub_epi64(two_times_modulus, Q)));
+            }
+
+            // Eight inverse butterflies at once; same arithmetic as inverse_ntt_butterfly
+            SEAL_TARGET_AVX512 inline void inverse_ntt_butterfly_avx512(uint64_t *U, uint64_t *V, __m512i W, __m512i Wprime,
+                __m512i modulus, __m512i two_times_modulus)
+            {
+                __m512i u = _mm512_loadu_si512(U);
+                __m512i v = _mm512_loadu_si512(V);
+                __m512i T = _mm512_add_epi64(_mm512_sub_epi64(two_times_modulus, v), u);
+                __m512i sum = _mm512_add_epi64(u, v);
+                __mmask8 reduce = _mm512_cmpge_epu64_mask(_mm512_slli_epi64(u, 1), T);
+                __m512i currU = _mm512_mask_sub_epi64(sum, reduce, sum, two_times_modulus);
+                __mmask8 odd = _mm512_test_epi64_mask(T, _mm512_set1_epi64(1));
+                currU = _mm512_mask_add_epi64(currU, odd, currU, modulus);
+                _mm512_storeu_si512(U, _mm512_srli_epi64(currU, 1));
+                __m512i H = mulhi_epu64_avx512(Wprime, T);
+                _mm512_storeu_si512(V, _mm512_sub_epi64(mullo_epi64_avx512(W, T), mullo_epi64_avx512(H, modulus)));
+            }
+
+            SEAL_TARGET_AVX512 void ntt_radix2_pass_avx512(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                if (t < 8)
+                {
+                    ntt_radix2_pass_avx2(operand, tables, m, t, i_begin, i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus));
+                const __m512i vec_two_times_modulus = _mm512_set1_epi64(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const __m512i W = _mm512_set1_epi64(static_cast<long long>(tables.get_from_root_powers(m + i)));
+                    const __m512i Wprime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_root_powers(m + i)));
+
+                    uint64_t *X = operand + 2 * i * t;
+                    uint64_t *Y = X + t;
+                    for (int j = 0; j < t; j += 8, X += 8, Y += 8)
+                    {
+                        ntt_butterfly_avx512(X, Y, W, Wprime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_TARGET_AVX512 void ntt_radix4_pass_avx512(uint64_t *operand, const SmallNTTTables &tables, int m, int t, int i_begin, int i_end)
+            {
+                int half_t = t >> 1;
+                if (half_t < 8)
+                {
+                    ntt_radix2_pass_avx512(operand, tables, m, t, i_begin, i_end);
+                    ntt_radix2_pass_avx512(operand, tables, 2 * m, half_t, 2 * i_begin, 2 * i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus));
+                const __m512i vec_two_times_modulus = _mm512_set1_epi64(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const __m512i W1 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_root_powers(m + i)));
+                    const __m512i W1prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_root_powers(m + i)));
+                    const __m512i W2 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_root_powers(2 * (m + i))));
+                    const __m512i W2prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_root_powers(2 * (m + i))));
+                    const __m512i W3 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_root_powers(2 * (m + i) + 1)));
+                    const __m512i W3prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_root_powers(2 * (m + i) + 1)));
+
+                    uint64_t *X0 = operand + 2 * i * t;
+                    uint64_t *X1 = X0 + half_t;
+                    uint64_t *X2 = X0 + t;
+                    uint64_t *X3 = X2 + half_t;
+                    for (int j = 0; j < half_t; j += 8, X0 += 8, X1 += 8, X2 += 8, X3 += 8)
+                    {
+                        ntt_butterfly_avx512(X0, X2, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx512(X1, X3, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx512(X0, X1, W2, W2prime, vec_modulus, vec_two_times_modulus);
+                        ntt_butterfly_avx512(X2, X3, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_TARGET_AVX512 void inverse_ntt_radix2_pass_avx512(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                if (t < 8)
+                {
+                    inverse_ntt_radix2_pass_avx2(operand, tables, h, t, i_begin, i_end);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus));
+                const __m512i vec_two_times_modulus = _mm512_set1_epi64(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i++)
+                {
+                    const __m512i W = _mm512_set1_epi64(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i)));
+                    const __m512i Wprime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i)));
+
+                    uint64_t *U = operand + 2 * i * t;
+                    uint64_t *V = U + t;
+                    for (int j = 0; j < t; j += 8, U += 8, V += 8)
+                    {
+                        inverse_ntt_butterfly_avx512(U, V, W, Wprime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_TARGET_AVX512 void inverse_ntt_radix4_pass_avx512(uint64_t *operand, const SmallNTTTables &tables, int h, int t, int i_begin, int i_end)
+            {
+                if (t < 8)
+                {
+                    inverse_ntt_radix2_pass_avx512(operand, tables, h, t, i_begin, i_end);
+                    inverse_ntt_radix2_pass_avx512(operand, tables, h >> 1, t << 1, i_begin >> 1, i_end >> 1);
+                    return;
+                }
+                uint64_t modulus = tables.modulus().value();
+                const __m512i vec_modulus = _mm512_set1_epi64(static_cast<long long>(modulus));
+                const __m512i vec_two_times_modulus = _mm512_set1_epi64(static_cast<long long>(modulus * 2));
+                for (int i = i_begin; i < i_end; i += 2)
+                {
+                    const __m512i W1 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i)));
+                    const __m512i W1prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i)));
+                    const __m512i W2 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_inv_root_powers_div_two(h + i + 1)));
+                    const __m512i W2prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two(h + i + 1)));
+                    const __m512i W3 = _mm512_set1_epi64(static_cast<long long>(tables.get_from_inv_root_powers_div_two((h + i) >> 1)));
+                    const __m512i W3prime = _mm512_set1_epi64(static_cast<long long>(tables.get_from_scaled_inv_root_powers_div_two((h + i) >> 1)));
+
+                    uint64_t *U0 = operand + 2 * i * t;
+                    uint64_t *U1 = U0 + t;
+                    uint64_t *U2 = U1 + t;
+                    uint64_t *U3 = U2 + t;
+                    for (int j = 0; j < t; j += 8, U0 += 8, U1 += 8, U2 += 8, U3 += 8)
+                    {
+                        inverse_ntt_butterfly_avx512(U0, U1, W1, W1prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx512(U2, U3, W2, W2prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx512(U0, U2, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                        inverse_ntt_butterfly_avx512(U1, U3, W3, W3prime, vec_modulus, vec_two_times_modulus);
+                    }
+                }
+            }
+
+            SEAL_AVX512_DIAGNOSTIC_POP
+
+            struct NTTKernels
+            {
+                NTTKernels()
+                {
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx512f"))
+                    {
+                        forward_radix2 = ntt_radix2_pass_avx512;
+                        forward_radix4 = ntt_radix4_pass_avx512;
+                        inverse_radix2 = inverse_ntt_radix2_pass_avx512;
+                        inverse_radix4 = inverse_ntt_radix4_pass_avx512;
+                    }
+                    else if (__builtin_cpu_supports("avx2"))
+                    {
+                        forward_radix2 = ntt_radix2_pass_avx2;
+                        forward_radix4 = ntt_radix4_pass_avx2;
+                        inverse_radix2 = inverse_ntt_radix2_pass_avx2;
+                        inverse_radix4 = inverse_ntt_radix4_pass_avx2;
                     }
                 }
-                t >>= 1;
+
+                ntt_pass_type forward_radix2 = ntt_radix2_pass_generic;
+
+                ntt_pass_type forward_radix4 = ntt_radix4_pass_generic;
+
+                ntt_pass_type inverse_radix2 = inverse_ntt_radix2_pass_generic;
+
+                ntt_pass_type inverse_radix4 = inverse_ntt_radix4_pass_generic;
+            };
+
+            // The CPU is queried only once; initialization of the local static is thread-safe.
+            inline const NTTKernels &ntt_kernels()
+            {
+                static const NTTKernels kernels;
+                return kernels;
             }
         }
 
-        // Inverse negacyclic NTT using Harvey's butterfly. (See Patrick Longa and Michael Naehrig). 
+        void ntt_negacyclic_harvey_lazy(uint64_t *operand, const SmallNTTTables &tables)
+        {
+            const NTTKernels &kernels = ntt_kernels();
+            ntt_negacyclic_harvey_lazy_scheduled(operand, tables, kernels.forward_radix2, kernels.forward_radix4);
+        }
+
         void inverse_ntt_negacyclic_harvey_lazy(uint64_t *operand, const SmallNTTTables &tables)
         {
-            uint64_t modulus = tables.modulus().value();
-            uint64_t two_times_modulus = modulus * 2;
+            const NTTKernels &kernels = ntt_kernels();
+            inverse_ntt_negacyclic_harvey_lazy_scheduled(operand, tables, kernels.inverse_radix2, kernels.inverse_radix4);
+        }
+#else
+        namespace
+        {
+            struct NTTKernels
+            {
+                ntt_pass_type forward_radix2 = ntt_radix2_pass_generic;
+
+                ntt_pass_type forward_radix4 = ntt_radix4_pass_generic;
 
-            // return the bit-reversed order of NTT. 
-            int n = 1 << tables.coeff_count_power();
-            int t = 1;
+                ntt_pass_type inverse_radix2 = inverse_ntt_radix2_pass_generic;
 
-            for (int m = n; m > 1; m >>= 1)
+                ntt_pass_type inverse_radix4 = inverse_ntt_radix4_pass_generic;
+            };
+
+            inline const NTTKernels &ntt_kernels()
             {
-                int j1 = 0;
-                int h = m >> 1;
-                if (t >= 4)
+                static NTTKernels kernels;
+                return kernels;
+            }
+        }
+
+        void ntt_negacyclic_harvey_lazy(uint64_t *operand, const SmallNTTTables &tables)
+        {
+            ntt_negacyclic_harvey_lazy_generic(operand, tables);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy(uint64_t *operand, const SmallNTTTables &tables)
+        {
+            inverse_ntt_negacyclic_harvey_lazy_generic(operand, tables);
+        }
+#endif //SEAL_ENABLE_AVX_NTT
+
+        void ntt_negacyclic_harvey_lazy(uint64_t *operand, int coeff_count, int coeff_mod_count, 
+            const SmallNTTTables *tables, int poly_count)
+        {
+            const NTTKernels &kernels = ntt_kernels();
+            for (int i = 0; i < poly_count; i++)
+            {
+                for (int j = 0; j < coeff_mod_count; j++, operand += coeff_count)
+                {
+                    ntt_negacyclic_harvey_lazy_scheduled(operand, tables[j], kernels.forward_radix2, kernels.forward_radix4);
+                }
+            }
+        }
+
+        void ntt_negacyclic_harvey(uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count)
+        {
+            const NTTKernels &kernels = ntt_kernels();
+            for (int i = 0; i < poly_count; i++)
+            {
+                for (int j = 0; j < coeff_mod_count; j++, operand += coeff_count)
                 {
-                    for (int i = 0; i < h; i++)
+                    ntt_negacyclic_harvey_lazy_scheduled(operand, tables[j], kernels.forward_radix2, kernels.forward_radix4);
+
+                    // Reduce from [0, 4q) while the limb is still in cache
+                    int n = 1 << tables[j].coeff_count_power();
+                    uint64_t modulus = tables[j].modulus().value();
+                    uint64_t two_times_modulus = modulus * 2;
+                    for (int k = 0; k < n; k++)
                     {
-                        int j2 = j1 + t;
-                        // Need the powers of phi^{-1} in bit-reversed order
-                        const uint64_t W = tables.get_from_inv_root_powers_div_two(h + i);
-                        const uint64_t Wprime = tables.get_from_scaled_inv_root_powers_div_two(h + i);
-
-                        uint64_t *U = operand + j1;
-                        uint64_t *V = U + t;
-                        uint64_t currU;
-                        uint64_t T;
-                        uint64_t H;
-                        for (int j = j1; j < j2; j += 4)
-                        {
-                            T = two_times_modulus - *V + *U;
-                            currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
-                            *U++ = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
-                            multiply_uint64_hw64(Wprime, T, &H);
-                            *V++ = T * W - H * modulus;
-
-                            T = two_times_modulus - *V + *U;
-                            currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
-                            *U++ = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
-                            multiply_uint64_hw64(Wprime, T, &H);
-                            *V++ = T * W - H * modulus;
-
-                            T = two_times_modulus - *V + *U;
-                            currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
-                            *U++ = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
-                            multiply_uint64_hw64(Wprime, T, &H);
-                            *V++ = T * W - H * modulus;
-
-                            T = two_times_modulus - *V + *U;
-                            currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
-                            *U++ = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
-                            multiply_uint64_hw64(Wprime, T, &H);
-                            *V++ = T * W - H * modulus;
-                        }
-                        j1 += (t << 1);
+                        uint64_t value = operand[k];
+                        value -= two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>(value >= two_times_modulus));
+                        operand[k] = value - (modulus & static_cast<uint64_t>(-static_cast<int64_t>(value >= modulus)));
                     }
                 }
-                else
+            }
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy(uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count)
+        {
+            const NTTKernels &kernels = ntt_kernels();
+            for (int i = 0; i < poly_count; i++)
+            {
+                for (int j = 0; j < coeff_mod_count; j++, operand += coeff_count)
                 {
-                    for (int i = 0; i < h; i++)
+                    inverse_ntt_negacyclic_harvey_lazy_scheduled(operand, tables[j], kernels.inverse_radix2, kernels.inverse_radix4);
+                }
+            }
+        }
+
+        void inverse_ntt_negacyclic_harvey(uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count)
+        {
+            const NTTKernels &kernels = ntt_kernels();
+            for (int i = 0; i < poly_count; i++)
+            {
+                for (int j = 0; j < coeff_mod_count; j++, operand += coeff_count)
+                {
+                    inverse_ntt_negacyclic_harvey_lazy_scheduled(operand, tables[j], kernels.inverse_radix2, kernels.inverse_radix4);
+
+                    // Reduce from [0, 2q) while the limb is still in cache
+                    int n = 1 << tables[j].coeff_count_power();
+                    uint64_t modulus = tables[j].modulus().value();
+                    for (int k = 0; k < n; k++)
                     {
-                        int j2 = j1 + t;
-                        // Need the powers of  phi^{-1} in bit-reversed order
-                        const uint64_t W = tables.get_from_inv_root_powers_div_two(h + i);
-                        const uint64_t Wprime = tables.get_from_scaled_inv_root_powers_div_two(h + i);
-
-                        uint64_t *U = operand + j1;
-                        uint64_t *V = U + t;
-                        uint64_t currU;
-                        uint64_t T;
-                        uint64_t H;
-                        for (int j = j1; j < j2; j++)
-                        {
-                            currU = *U;
-                            // U = x[i], V = x[i+m]
-
-                            // Compute U - V + 2q
-                            T = two_times_modulus - *V + *U;
-
-                            // Cleverly check whether currU + currV >= two_times_modulus
-                            currU = *U + *V - (two_times_modulus & static_cast<uint64_t>(-static_cast<int64_t>((*U << 1) >= T)));
-
-                            // Need to make it so that div2_uint_mod takes values that are > q. 
-                            //div2_uint_mod(U, modulusptr, coeff_uint64_count, U); 
-                            // We use also the fact that parity of currU is same as parity of T.
-                            // Since our modulus is always so small that currU + masked_modulus < 2^64,
-                            // we never need to worry about wrapping around when adding masked_modulus.
-                            //uint64_t masked_modulus = modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1));
-                            //uint64_t carry = add_uint64(currU, masked_modulus, 0, &currU);
-                            //currU += modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1));
-                            *U++ = (currU + (modulus & static_cast<uint64_t>(-static_cast<int64_t>(T & 1)))) >> 1;
-
-                            multiply_uint64_hw64(Wprime, T, &H);
-                            // effectively, the next two multiply perform multiply modulo beta = 2**wordsize. 
-                            *V++ = W * T - H * modulus;
-                        }
-                        j1 += (t << 1);
+                        uint64_t value = operand[k];
+                        operand[k] = value - (modulus & static_cast<uint64_t>(-static_cast<int64_t>(value >= modulus)));
                     }
                 }
-                t <<= 1;
             }
         }
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <iostream>
 #include "seal/memorypoolhandle.h"
 #include "seal/smallmodulus.h"
 
@@ -32,6 +33,27 @@ namespace seal
 
             void reset();
 
+            /**
+            Writes the tables to a stream as a sequence of 64-bit words that can be read 
+            back in place by load_aliasing().
+            */
+            void save(std::ostream &stream) const;
+
+            /**
+            Loads tables written by save() from memory, advancing data past them. The 
+            tables are not copied: they alias the given memory, which must remain valid 
+            and unchanged for the lifetime of this object.
+
+            @throws std::invalid_argument if data_end is reached before the tables end
+            */
+            void load_aliasing(const std::uint64_t *&data, const std::uint64_t *data_end);
+
+            /**
+            Makes these tables alias the tables of source instead of copying them. The 
+            tables of source must remain valid and unchanged for the lifetime of this object.
+            */
+            void alias(const SmallNTTTables &source);
+
             inline std::uint64_t get_root() const
             {
 #ifdef SEAL_DEBUG
@@ -200,8 +222,16 @@ namespace seal
 
         };
 
+        /**
+        Computes the negacyclic NTT in-place with outputs in [0, 4q). Vectorized AVX2 or
+        AVX-512 kernels are used when the CPU supports them; the output is identical to 
+        that of ntt_negacyclic_harvey_lazy_generic.
+        */
         void ntt_negacyclic_harvey_lazy(std::uint64_t *operand, const SmallNTTTables &tables);
 
+        // Portable scalar implementation of ntt_negacyclic_harvey_lazy
+        void ntt_negacyclic_harvey_lazy_generic(std::uint64_t *operand, const SmallNTTTables &tables);
+
         inline void ntt_negacyclic_harvey(std::uint64_t *operand, const SmallNTTTables &tables)
         {
             ntt_negacyclic_harvey_lazy(operand, tables);
@@ -226,8 +256,16 @@ namespace seal
             }
         }
 
+        /**
+        Computes the inverse negacyclic NTT in-place with outputs in [0, 2q). Vectorized 
+        AVX2 or AVX-512 kernels are used when the CPU supports them; the output is identical 
+        to that of inverse_ntt_negacyclic_harvey_lazy_generic.
+        */
         void inverse_ntt_negacyclic_harvey_lazy(std::uint64_t *operand, const SmallNTTTables &tables);
 
+        // Portable scalar implementation of inverse_ntt_negacyclic_harvey_lazy
+        void inverse_ntt_negacyclic_harvey_lazy_generic(std::uint64_t *operand, const SmallNTTTables &tables);
+
         inline void inverse_ntt_negacyclic_harvey(std::uint64_t *operand, const SmallNTTTables &tables)
         {
             inverse_ntt_negacyclic_harvey_lazy(operand, tables);
@@ -246,5 +284,27 @@ namespace seal
                 operand++;
             }
         }
+
+        /**
+        Computes in-place the lazy negacyclic NTT of poly_count consecutive RNS polynomials. Each
+        polynomial consists of coeff_mod_count limbs of coeff_count words, and limb j is transformed 
+        with tables[j]. Only the first 1 << tables[j].coeff_count_power() words of each limb are 
+        touched. Equivalent to calling ntt_negacyclic_harvey_lazy on every limb, but the kernel 
+        dispatch and loop setup are done only once.
+        */
+        void ntt_negacyclic_harvey_lazy(std::uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count = 1);
+
+        // Batched version of ntt_negacyclic_harvey; see the batched ntt_negacyclic_harvey_lazy
+        void ntt_negacyclic_harvey(std::uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count = 1);
+
+        // Batched version of inverse_ntt_negacyclic_harvey_lazy; see the batched ntt_negacyclic_harvey_lazy
+        void inverse_ntt_negacyclic_harvey_lazy(std::uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count = 1);
+
+        // Batched version of inverse_ntt_negacyclic_harvey; see the batched ntt_negacyclic_harvey_lazy
+        void inverse_ntt_negacyclic_harvey(std::uint64_t *operand, int coeff_count, int coeff_mod_count,
+            const SmallNTTTables *tables, int poly_count = 1);
     }
 }
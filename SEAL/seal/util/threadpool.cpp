@@ -0,0 +1,125 @@
+#include <stdexcept>
+#include "seal/util/threadpool.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        ThreadPool::ThreadPool(int thread_count) : busy_(false), next_task_(0)
+        {
+            if (thread_count < 1)
+            {
+                throw invalid_argument("thread_count must be positive");
+            }
+            for (int i = 1; i < thread_count; i++)
+            {
+                workers_.emplace_back(&ThreadPool::worker_loop, this);
+            }
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                lock_guard<mutex> lock(mutex_);
+                stop_ = true;
+            }
+            work_cv_.notify_all();
+            for (thread &worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        void ThreadPool::parallel_for(int task_count, const function<void(int)> &task)
+        {
+            // Run in this thread if there is nothing to split or the pool is already in use
+            bool expected = false;
+            if (task_count <= 1 || workers_.empty() || !busy_.compare_exchange_strong(expected, true))
+            {
+                for (int i = 0; i < task_count; i++)
+                {
+                    task(i);
+                }
+                return;
+            }
+
+            {
+                lock_guard<mutex> lock(mutex_);
+                task_ = &task;
+                task_count_ = task_count;
+                next_task_.store(0);
+                exception_ = nullptr;
+                active_worker_count_ = static_cast<int>(workers_.size());
+                generation_++;
+            }
+            work_cv_.notify_all();
+            run_tasks();
+
+            exception_ptr exception;
+            {
+                unique_lock<mutex> lock(mutex_);
+                done_cv_.wait(lock, [this]() { return active_worker_count_ == 0; });
+                task_ = nullptr;
+                exception = exception_;
+                exception_ = nullptr;
+            }
+            busy_.store(false);
+            if (exception)
+            {
+                rethrow_exception(exception);
+            }
+        }
+
+        void ThreadPool::worker_loop()
+        {
+            uint64_t seen_generation = 0;
+            while (true)
+            {
+                {
+                    unique_lock<mutex> lock(mutex_);
+                    work_cv_.wait(lock, [&]() { return stop_ || generation_ != seen_generation; });
+                    if (stop_)
+                    {
+                        return;
+                    }
+                    seen_generation = generation_;
+                }
+                run_tasks();
+                {
+                    lock_guard<mutex> lock(mutex_);
+                    if (--active_worker_count_ == 0)
+                    {
+                        done_cv_.notify_one();
+                    }
+                }
+            }
+        }
+
+        void ThreadPool::run_tasks()
+        {
+            // Tasks are handed out one at a time in order of index
+            while (true)
+            {
+                int index = next_task_.fetch_add(1);
+                if (index >= task_count_)
+                {
+                    return;
+                }
+                try
+                {
+                    (*task_)(index);
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> lock(mutex_);
+                    if (!exception_)
+                    {
+                        exception_ = current_exception();
+                    }
+                }
+            }
+        }
+    }
+}
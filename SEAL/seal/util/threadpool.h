@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        A fixed set of worker threads for splitting one operation into independent tasks.
+        The thread calling parallel_for takes part in running the tasks, so a pool with a
+        thread count of T starts T-1 worker threads.
+
+        Only one parallel_for runs on the pool at a time. A parallel_for called while the pool
+        is busy, e.g. from another thread or from inside a task, runs its tasks one after the
+        other in the calling thread instead of waiting for the pool.
+        */
+        class ThreadPool
+        {
+        public:
+            /**
+            Creates a pool running tasks on thread_count threads in total.
+
+            @param[in] thread_count The number of threads, including the calling thread
+            @throws std::invalid_argument if thread_count is not positive
+            */
+            ThreadPool(int thread_count);
+
+            ~ThreadPool();
+
+            inline int thread_count() const
+            {
+                return static_cast<int>(workers_.size()) + 1;
+            }
+
+            /**
+            Calls task(i) for every i in [0, task_count), and returns when all calls have
+            returned. The calls are distributed over the threads of the pool and must be
+            independent of each other. If any of them throws, one of the exceptions is
+            rethrown after all calls have finished.
+            */
+            void parallel_for(int task_count, const std::function<void(int)> &task);
+
+        private:
+            ThreadPool(const ThreadPool &copy) = delete;
+
+            ThreadPool &operator =(const ThreadPool &assign) = delete;
+
+            void worker_loop();
+
+            void run_tasks();
+
+            std::vector<std::thread> workers_;
+
+            std::atomic<bool> busy_;
+
+            std::mutex mutex_;
+
+            std::condition_variable work_cv_;
+
+            std::condition_variable done_cv_;
+
+            bool stop_ = false;
+
+            std::uint64_t generation_ = 0;
+
+            int active_worker_count_ = 0;
+
+            const std::function<void(int)> *task_ = nullptr;
+
+            int task_count_ = 0;
+
+            std::atomic<int> next_task_;
+
+            std::exception_ptr exception_;
+        };
+    }
+}
@@ -31,6 +31,11 @@ namespace seal
         {
             return ciphertext->mutable_hash_block();
         }
+
+        static bool &is_ntt_form(seal::Ciphertext *ciphertext)
+        {
+            return ciphertext->is_ntt_form_;
+        }
     };
 }
 
@@ -432,6 +437,8 @@ namespace Microsoft
                     Write(stream, reinterpret_cast<const char*>(&size32), sizeof(int32_t));
                     Write(stream, reinterpret_cast<const char*>(&poly_coeff_count32), sizeof(int32_t));
                     Write(stream, reinterpret_cast<const char*>(&coeff_mod_count32), sizeof(int32_t));
+                    int32_t is_ntt_form32 = static_cast<int32_t>(ciphertext_->is_ntt_form());
+                    Write(stream, reinterpret_cast<const char*>(&is_ntt_form32), sizeof(int32_t));
                     Write(stream, reinterpret_cast<const char*>(seal::Ciphertext::CiphertextPrivateHelper::pointer(ciphertext_)),
                         ciphertext_->size() * ciphertext_->poly_coeff_count() * ciphertext_->coeff_mod_count() * seal::util::bytes_per_uint64);
                 }
@@ -465,7 +472,10 @@ namespace Microsoft
                     Read(stream, reinterpret_cast<char*>(&size32), sizeof(int32_t));
                     Read(stream, reinterpret_cast<char*>(&poly_coeff_count32), sizeof(int32_t));
                     Read(stream, reinterpret_cast<char*>(&coeff_mod_count32), sizeof(int32_t));
+                    int32_t is_ntt_form32 = 0;
+                    Read(stream, reinterpret_cast<char*>(&is_ntt_form32), sizeof(int32_t));
                     seal::Ciphertext::CiphertextPrivateHelper::resize(ciphertext_, size32, poly_coeff_count32, coeff_mod_count32);
+                    seal::Ciphertext::CiphertextPrivateHelper::is_ntt_form(ciphertext_) = (is_ntt_form32 != 0);
                     Read(stream, reinterpret_cast<char*>(seal::Ciphertext::CiphertextPrivateHelper::pointer(ciphertext_)),
                         ciphertext_->size() * ciphertext_->poly_coeff_count() * ciphertext_->coeff_mod_count() * seal::util::bytes_per_uint64);
                 }
@@ -8,6 +8,20 @@ using namespace System::IO;
 using namespace std;
 using namespace msclr::interop;
 
+namespace seal
+{
+    /**
+    <summary>Enables access to private members of seal::Plaintext.</summary>
+    */
+    struct Plaintext::PlaintextPrivateHelper
+    {
+        static bool &is_ntt_form(seal::Plaintext *plaintext)
+        {
+            return plaintext->is_ntt_form_;
+        }
+    };
+}
+
 namespace Microsoft
 {
     namespace Research
@@ -688,6 +702,8 @@ namespace Microsoft
                 {
                     int32_t coeff_count32 = static_cast<int32_t>(plaintext_->coeff_count());
                     Write(stream, reinterpret_cast<const char*>(&coeff_count32), sizeof(int32_t));
+                    int32_t is_ntt_form32 = static_cast<int32_t>(plaintext_->is_ntt_form());
+                    Write(stream, reinterpret_cast<const char*>(&is_ntt_form32), sizeof(int32_t));
                     Write(stream, reinterpret_cast<const char*>(plaintext_->pointer()), 
                         plaintext_->coeff_count() * seal::util::bytes_per_uint64);
                 }
@@ -715,7 +731,10 @@ namespace Microsoft
                 {
                     int32_t coeff_count32 = 0;
                     Read(stream, reinterpret_cast<char*>(&coeff_count32), sizeof(int32_t));
+                    int32_t is_ntt_form32 = 0;
+                    Read(stream, reinterpret_cast<char*>(&is_ntt_form32), sizeof(int32_t));
                     plaintext_->resize(coeff_count32);
+                    seal::Plaintext::PlaintextPrivateHelper::is_ntt_form(plaintext_) = (is_ntt_form32 != 0);
                     Read(stream, reinterpret_cast<char*>(plaintext_->pointer()), 
                         plaintext_->coeff_count() * seal::util::bytes_per_uint64);
                 }
@@ -1,549 +1,469 @@
 #include "CppUnitTest.h"
-#include <stdexcept>
-#include "util/mempool.h"
-#include "util/uintcore.h"
-#include "memorypoolhandle.h"
-#include "smallmodulus.h"
-#include "util/BaseConverter.h"
-#include "util/uintarith.h"
-#include "util/uintarithsmallmod.h"
-#include "util/uintarithmod.h"
-#include "primes.h"
+#include "seal/util/mempool.h"
+#include "seal/util/uintcore.h"
+#include "seal/util/baseconverter.h"
+#include "seal/memorypoolhandle.h"
+#include "seal/defaultparams.h"
+#include "seal/smallmodulus.h"
+#include <random>
+#include <cstdint>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
-using namespace seal::util;
 using namespace seal;
+using namespace seal::util;
 using namespace std;
 
 namespace SEALTest
 {
-	namespace util
-	{
-		TEST_CLASS(BaseConverterClass)
-		{
-		public:
-			TEST_METHOD(BaseConverterConstructor)
-			{
-				MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-				vector<SmallModulus> coeff_base;
-				vector<SmallModulus> aux_base;
-				SmallModulus mtilda = small_mods[10];
-				SmallModulus msk = small_mods[11];
-				SmallModulus plain_t = small_mods[9];
-				int coeff_base_count = 4;
-				int aux_base_count = 4;
-
-				for (int i = 0; i < coeff_base_count; ++i)
-				{
-					coeff_base.push_back(small_mods[i]);
-					aux_base.push_back(small_mods[i + coeff_base_count]);
-				}
-
-				BaseConverter BaseConverter(coeff_base, 4, plain_t);
-				Assert::IsTrue(BaseConverter.is_generated());
-			}
-
-			TEST_METHOD(FastBConverter)
-			{
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus plain_t = small_mods[9];
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count + 2]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 1, plain_t);
-					Pointer input(allocate_uint(2, pool));
-					Pointer output(allocate_uint(3, pool));
-
-					// the composed input is 0xffffffffffffff00ffffffffffffff
-
-					input[0] = 4395513236581707780;
-					input[1] = 4395513390924464132;
-
-
-					output[0] = 0xFFFFFFFFFFFFFFFF;
-					output[1] = 0xFFFFFFFFFFFFFFFF;
-					output[2] = 0;
-
-					Assert::IsTrue(BaseConverter.fastbconv(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[2]);
-				}
-
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[10];
-					SmallModulus msk = small_mods[11];
-					SmallModulus plain_t = small_mods[9];
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count + 2]);
-					}
-					BaseConverter BaseConverter(coeff_base, 4, plain_t);
-					Pointer input(allocate_uint(8, pool));
-					Pointer output(allocate_uint(12, pool));
-
-					// the composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
-					// mod q1
-					input[0] = 4395513236581707780; // cons 
-					input[1] = 4395513236581707780; // x
-					input[2] = 4395513236581707780; // x^2
-					input[3] = 4395513236581707780; // x^3
-
-					//mod q2
-					input[4] = 4395513390924464132;
-					input[5] = 4395513390924464132;
-					input[6] = 4395513390924464132;
-					input[7] = 4395513390924464132;
-
-					output[0] = 0xFFFFFFFFFFFFFFFF;
-					output[1] = 0xFFFFFFFFFFFFFFFF;
-					output[2] = 0;
-
-					Assert::IsTrue(BaseConverter.fastbconv(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[2]);
-					Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[3]);
-
-					Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[4]);
-					Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[5]);
-					Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[6]);
-					Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[7]);
-
-					Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[8]);
-					Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[9]);
-					Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[10]);
-					Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[11]);
-				}
-			}
-
-			TEST_METHOD(FastBConvSK)
-			{
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[10];
-					SmallModulus msk = small_mods[4];
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 1, plain_t);
-					Pointer input(allocate_uint(3, pool));
-					Pointer output(allocate_uint(2, pool));
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff
-
-					input[0] = 4395583330278772740;
-					input[1] = 4396634741790752772;
-					input[2] = 4396375252835237892;	// mod msk
-
-					output[0] = 0xFFFFFFFFFFFFFFF;
-					output[1] = 0xFFFFFFFFFFFFFFF;
-
-					Assert::IsTrue(BaseConverter.fastbconv_sk(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(2494482839790051254), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(218180408843610743), output[1]);
-				}
-				
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[10];
-					SmallModulus msk = small_mods[4];
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 4, plain_t);
-					Pointer input(allocate_uint(12, pool));
-					Pointer output(allocate_uint(8, pool));
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff
-
-					input[0] = 4395583330278772740;	// cons 
-					input[1] = 4395583330278772740; // x 
-					input[2] = 4395583330278772740; // x^2
-					input[3] = 4395583330278772740; // x^3
-					
-					input[4] = 4396634741790752772;
-					input[5] = 4396634741790752772;
-					input[6] = 4396634741790752772;
-					input[7] = 4396634741790752772;
-
-					input[8] = 4396375252835237892;	// mod msk
-					input[9] = 4396375252835237892;	
-					input[10] = 4396375252835237892;
-					input[11] = 4396375252835237892;
-
-					output[0] = 0xFFFFFFFFFFFFFFF;
-					output[1] = 0xFFFFFFFFFFFFFFF;
-
-					Assert::IsTrue(BaseConverter.fastbconv_sk(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(2494482839790051254), output[0]); //mod q1
-					Assert::AreEqual(static_cast<uint64_t>(2494482839790051254), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(2494482839790051254), output[2]);
-					Assert::AreEqual(static_cast<uint64_t>(2494482839790051254), output[3]);
-					
-					Assert::AreEqual(static_cast<uint64_t>(218180408843610743), output[4]); //mod q2
-					Assert::AreEqual(static_cast<uint64_t>(218180408843610743), output[5]);
-					Assert::AreEqual(static_cast<uint64_t>(218180408843610743), output[6]);
-					Assert::AreEqual(static_cast<uint64_t>(218180408843610743), output[7]);
-				}
-				
-			}
-			
-			TEST_METHOD(MontRq)
-			{
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[5];
-					SmallModulus msk = small_mods[4];
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 1, plain_t);
-					Pointer input(allocate_uint(4, pool));
-					Pointer output(allocate_uint(3, pool));
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff
-
-					input[0] = 4395583330278772740;  // mod m1
-					input[1] = 4396634741790752772;  // mod m2
-					input[2] = 4396375252835237892;	 // mod msk
-					input[3] = 4396146554501595140;  // mod m_tilde
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					Assert::IsTrue(BaseConverter.mont_rq(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(1412154008057360306), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(3215947095329058299), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(1636465626706639696), output[2]);
-				}
-
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[5];
-					SmallModulus msk = small_mods[4];
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 3, plain_t);
-					Pointer input(allocate_uint(12, pool));
-					Pointer output(allocate_uint(9, pool));
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
-
-					input[0] = 4395583330278772740;  // cons mod m1
-					input[1] = 4395583330278772740;  // x mod m1
-					input[2] = 4395583330278772740;  // x^2 mod m1
-
-					input[3] = 4396634741790752772;  // cons mod m2
-					input[4] = 4396634741790752772;  // x mod m2
-					input[5] = 4396634741790752772;  // x^2 mod m2
-
-					input[6] = 4396375252835237892;	 // cons mod msk
-					input[7] = 4396375252835237892;	 // x mod msk
-					input[8] = 4396375252835237892;	 // x^2 mod msk
-
-					input[9] = 4396146554501595140;  // cons mod m_tilde
-					input[10] = 4396146554501595140;  // x mod m_tilde
-					input[11] = 4396146554501595140;  // x^2 mod m_tilde
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					Assert::IsTrue(BaseConverter.mont_rq(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(1412154008057360306), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(1412154008057360306), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(1412154008057360306), output[2]);
-
-					Assert::AreEqual(static_cast<uint64_t>(3215947095329058299), output[3]);
-					Assert::AreEqual(static_cast<uint64_t>(3215947095329058299), output[4]);
-					Assert::AreEqual(static_cast<uint64_t>(3215947095329058299), output[5]);
-
-					Assert::AreEqual(static_cast<uint64_t>(1636465626706639696), output[6]);
-					Assert::AreEqual(static_cast<uint64_t>(1636465626706639696), output[7]);
-					Assert::AreEqual(static_cast<uint64_t>(1636465626706639696), output[8]);
-				}
-			}
-			
-			TEST_METHOD(FastFloor)
-			{
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus mtilda = small_mods[5];
-					SmallModulus msk = small_mods[4];
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-						aux_base.push_back(small_mods[i + coeff_base_count]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 1, plain_t);
-					Pointer input(allocate_uint(5, pool));
-					Pointer output(allocate_uint(3, pool));
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff
-
-					input[0] = 4395513236581707780;		// mod q1	 
-					input[1] = 4395513390924464132;		// mod q2
-					input[2] = 4395583330278772740;		// mod m1
-					input[3] = 4396634741790752772;		// mod m2
-					input[4] = 4396375252835237892;		// mod msk
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					Assert::IsTrue(BaseConverter.fast_floor(input.get(), output.get()));
-
-					// The result for all moduli is equal to -1 since the composed input is small 
-			//		Assert::AreEqual(static_cast<uint64_t>(4611686018393899008), output[0]);
-			//		Assert::AreEqual(static_cast<uint64_t>(4611686018293432320), output[1]);
-			//		Assert::AreEqual(static_cast<uint64_t>(4611686018309947392), output[2]);
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff00ff
-
-					input[0] = 17574536613119;		// mod q1	 
-					input[1] = 10132675570633983;		// mod q2
-					input[2] = 3113399115422302529;		// mod m1
-					input[3] = 1298513899176416785;		// mod m2
-					input[4] = 3518991311999157564;		// mod msk
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					// Since input > q1*q2, the result should be floor(x/(q1*q2)) - alpha (alpha = {0 or 1})
-					Assert::IsTrue(BaseConverter.fast_floor(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(0xfff), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfff), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfff), output[2]);
-
-					// The composed input is 0xffffffffffffff00ffffffffffffff00ffff
-
-					input[0] = 4499081372958719;		// mod q1	 
-					input[1] = 2593964946082299903;		// mod q2
-					input[2] = 4013821342825660755;		// mod m1
-					input[3] = 457963018288239031;		// mod m2
-					input[4] = 1691919900291185724;		// mod msk
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					// Since input > q1*q2, the result should be floor(x/(q1*q2)) - alpha (alpha = {0 or 1})
-					Assert::IsTrue(BaseConverter.fast_floor(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[1]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[2]);
-				}
-
-				{
-					MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-					vector<SmallModulus> coeff_base;
-					vector<SmallModulus> aux_base;
-					SmallModulus plain_t = small_mods[9];
-
-					int coeff_base_count = 2;
-					int aux_base_count = 2;
-					for (int i = 0; i < coeff_base_count; ++i)
-					{
-						coeff_base.push_back(small_mods[i]);
-					}
-
-					BaseConverter BaseConverter(coeff_base, 2, plain_t);
-					Pointer input(allocate_uint(10, pool));
-					Pointer output(allocate_uint(6, pool));
-
-					input[0] = 4499081372958719;		// mod q1	 
-					input[1] = 4499081372958719;		// mod q1	 
-
-					input[2] = 2593964946082299903;		// mod q2
-					input[3] = 2593964946082299903;		// mod q2
-					
-					input[4] = 4013821342825660755;		// mod m1
-					input[5] = 4013821342825660755;		// mod m1
-				
-					input[6] = 457963018288239031;		// mod m2
-					input[7] = 457963018288239031;		// mod m2
-					
-					input[8] = 1691919900291185724;		// mod msk
-					input[9] = 1691919900291185724;		// mod msk
-
-					output[0] = 0xfffffffff;
-					output[1] = 0x00fffffff;
-					output[2] = 0;
-
-					// Since input > q1*q2, the result should be floor(x/(q1*q2)) - alpha (alpha = {0 or 1})
-					Assert::IsTrue(BaseConverter.fast_floor(input.get(), output.get()));
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[0]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[1]);
-
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[2]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[3]);
-
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[4]);
-					Assert::AreEqual(static_cast<uint64_t>(0xfffff), output[5]);
-				}
-				
-			}
-
-			TEST_METHOD(FastBConver_mtilde)
-			{
-				MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-				vector<SmallModulus> coeff_base;
-				vector<SmallModulus> aux_base;
-				SmallModulus mtilda = small_mods[5];
-				SmallModulus msk = small_mods[4];
-				SmallModulus plain_t = small_mods[9];
-
-				int coeff_base_count = 2;
-				int aux_base_count = 2;
-				for (int i = 0; i < coeff_base_count; ++i)
-				{
-					coeff_base.push_back(small_mods[i]);
-					aux_base.push_back(small_mods[i + coeff_base_count]);
-				}
-
-				BaseConverter BaseConverter(coeff_base, 3, plain_t);
-				Pointer input(allocate_uint(6, pool));
-				Pointer output(allocate_uint(12, pool));
-
-				// The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
-
-				input[0] = 4395513236581707780;		// cons mod q1	 
-				input[1] = 4395513236581707780;		// x mod q1	 
-				input[2] = 4395513236581707780;		// x^2 mod q1	 
-
-				input[3] = 4395513390924464132;		// cons mod q2
-				input[4] = 4395513390924464132;		// x mod q2
-				input[5] = 4395513390924464132;		// x^2 mod q2
-
-				output[0] = 0xffffffff;
-				output[1] = 0;
-				output[2] = 0xffffff;
-				output[3] = 0xffffff;
-
-				Assert::IsTrue(BaseConverter.fastbconv_mtilde(input.get(), output.get()));
-				Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[0]);//mod m1
-				Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[1]);
-				Assert::AreEqual(static_cast<uint64_t>(3116074317392112723), output[2]);
-
-				Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[3]);//mod m2
-				Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[4]);
-				Assert::AreEqual(static_cast<uint64_t>(1254200639185090240), output[5]);
-
-				Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[6]);//mod msk
-				Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[7]);
-				Assert::AreEqual(static_cast<uint64_t>(3528328721557038672), output[8]);
-
-				Assert::AreEqual(static_cast<uint64_t>(849325434816160659), output[9]);//mod m_tilde
-				Assert::AreEqual(static_cast<uint64_t>(849325434816160659), output[10]);
-				Assert::AreEqual(static_cast<uint64_t>(849325434816160659), output[11]);
-			}
-
-			TEST_METHOD(FastBConvert_plain_gamma)
-			{
-				MemoryPoolMT &pool = *MemoryPoolMT::default_pool();
-				vector<SmallModulus> coeff_base;
-				vector<SmallModulus> aux_base;
-				SmallModulus plain_t = small_mods[9];
-
-				int coeff_base_count = 2;
-				int aux_base_count = 2;
-				for (int i = 0; i < coeff_base_count; ++i)
-				{
-					coeff_base.push_back(small_mods[i]);
-					aux_base.push_back(small_mods[i + coeff_base_count]);
-				}
-
-				BaseConverter BaseConverter(coeff_base, 3, plain_t);
-				Pointer input(allocate_uint(6, pool));
-				Pointer output(allocate_uint(6, pool));
-
-				// The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
-
-				input[0] = 4395513236581707780;		// cons mod q1	 
-				input[1] = 4395513236581707780;		// x mod q1	 
-				input[2] = 4395513236581707780;		// x^2 mod q1	 
-
-				input[3] = 4395513390924464132;		// cons mod q2
-				input[4] = 4395513390924464132;		// x mod q2
-				input[5] = 4395513390924464132;		// x^2 mod q2
-
-				output[0] = 0xffffffff;
-				output[1] = 0;
-				output[2] = 0xffffff;
-				output[3] = 0xffffff;
-
-				Assert::IsTrue(BaseConverter.fastbconv_plain_gamma(input.get(), output.get()));
-				Assert::AreEqual(static_cast<uint64_t>(1950841694949736435), output[0]);//mod plain modulus
-				Assert::AreEqual(static_cast<uint64_t>(1950841694949736435), output[1]);
-				Assert::AreEqual(static_cast<uint64_t>(1950841694949736435), output[2]);
-
-				Assert::AreEqual(static_cast<uint64_t>(3744510248429639755), output[3]);//mod gamma
-				Assert::AreEqual(static_cast<uint64_t>(3744510248429639755), output[4]);
-				Assert::AreEqual(static_cast<uint64_t>(3744510248429639755), output[5]);
-			}
-		};
-	}
-}
\ No newline at end of file
+    namespace util
+    {
+        TEST_CLASS(BaseConverterClass)
+        {
+        public:
+            // The coefficient base is q = {q1, q2} with 60-bit primes; with a small plain 
+            // modulus the auxiliary base is M = {m1, m2}, and Bsk = {m1, m2, msk}
+            TEST_METHOD(BaseConverterConstructor)
+            {
+                vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                SmallModulus plain_t(65537);
+
+                BaseConverter base_converter(coeff_base, 4, 2, plain_t);
+                Assert::IsTrue(base_converter.is_generated());
+            }
+
+            TEST_METHOD(FastBConverter)
+            {
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 1, 0, plain_t);
+                    Pointer input(allocate_uint(2, pool));
+                    Pointer output(allocate_uint(3, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff
+                    input[0] = 72057662752686096;  // mod q1
+                    input[1] = 72123633308794896;  // mod q2
+
+                    base_converter.fastbconv(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(1801446052834902024), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801473111068246024), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801440950440427528), output[2]);
+                }
+
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 4, 2, plain_t);
+                    Pointer input(allocate_uint(8, pool));
+                    Pointer output(allocate_uint(12, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
+                    input[0] = 72057662752686096;  // mod q1
+                    input[1] = 72057662752686096;
+                    input[2] = 72057662752686096;
+                    input[3] = 72057662752686096;
+
+                    input[4] = 72123633308794896;  // mod q2
+                    input[5] = 72123633308794896;
+                    input[6] = 72123633308794896;
+                    input[7] = 72123633308794896;
+
+                    base_converter.fastbconv(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(1801446052834902024), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801446052834902024), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801446052834902024), output[2]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801446052834902024), output[3]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(1801473111068246024), output[4]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801473111068246024), output[5]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801473111068246024), output[6]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801473111068246024), output[7]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(1801440950440427528), output[8]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801440950440427528), output[9]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801440950440427528), output[10]);
+                    Assert::AreEqual(static_cast<uint64_t>(1801440950440427528), output[11]);
+                }
+            }
+
+            TEST_METHOD(FastBConvSK)
+            {
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 1, 0, plain_t);
+                    Pointer input(allocate_uint(3, pool));
+                    Pointer output(allocate_uint(2, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff
+                    input[0] = 1801446052834902024;  // mod m1
+                    input[1] = 1801473111068246024;  // mod m2
+                    input[2] = 1801440950440427528;  // mod msk
+
+                    base_converter.fastbconv_sk(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(72057662752686096), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(72123633308794896), output[1]);
+                }
+
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 4, 2, plain_t);
+                    Pointer input(allocate_uint(12, pool));
+                    Pointer output(allocate_uint(8, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs
+                    input[0] = 1801446052834902024;  // mod m1
+                    input[1] = 1801446052834902024;
+                    input[2] = 1801446052834902024;
+                    input[3] = 1801446052834902024;
+
+                    input[4] = 1801473111068246024;  // mod m2
+                    input[5] = 1801473111068246024;
+                    input[6] = 1801473111068246024;
+                    input[7] = 1801473111068246024;
+
+                    input[8] = 1801440950440427528;  // mod msk
+                    input[9] = 1801440950440427528;
+                    input[10] = 1801440950440427528;
+                    input[11] = 1801440950440427528;
+
+                    base_converter.fastbconv_sk(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(72057662752686096), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(72057662752686096), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(72057662752686096), output[2]);
+                    Assert::AreEqual(static_cast<uint64_t>(72057662752686096), output[3]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(72123633308794896), output[4]);
+                    Assert::AreEqual(static_cast<uint64_t>(72123633308794896), output[5]);
+                    Assert::AreEqual(static_cast<uint64_t>(72123633308794896), output[6]);
+                    Assert::AreEqual(static_cast<uint64_t>(72123633308794896), output[7]);
+                }
+            }
+
+            TEST_METHOD(MontRq)
+            {
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 1, 0, plain_t);
+                    Pointer input(allocate_uint(4, pool));
+                    Pointer output(allocate_uint(3, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff; the result is
+                    // (x + q * r) / m_tilde with r = -x / q mod m_tilde
+                    input[0] = 1801446052834902024;  // mod m1
+                    input[1] = 1801473111068246024;  // mod m2
+                    input[2] = 1801440950440427528;  // mod msk
+                    input[3] = 4294967295;  // mod m_tilde
+
+                    base_converter.mont_rq(input.get(), output.get());
+                    Assert::AreEqual(static_cast<uint64_t>(2462877508163696), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(4222095273741296), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(1688834978864624), output[2]);
+                }
+
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 3, 2, plain_t);
+                    Pointer input(allocate_uint(12, pool));
+                    Pointer output(allocate_uint(9, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs; the result is
+                    // (x + q * r) / m_tilde with r = -x / q mod m_tilde
+                    input[0] = 1801446052834902024;  // mod m1
+                    input[1] = 1801446052834902024;
+                    input[2] = 1801446052834902024;
+
+                    input[3] = 1801473111068246024;  // mod m2
+                    input[4] = 1801473111068246024;
+                    input[5] = 1801473111068246024;
+
+                    input[6] = 1801440950440427528;  // mod msk
+                    input[7] = 1801440950440427528;
+                    input[8] = 1801440950440427528;
+
+                    input[9] = 4294967295;  // mod m_tilde
+                    input[10] = 4294967295;
+                    input[11] = 4294967295;
+
+                    base_converter.mont_rq(input.get(), output.get());
+                    Assert::AreEqual(static_cast<uint64_t>(2462877508163696), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(2462877508163696), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(2462877508163696), output[2]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(4222095273741296), output[3]);
+                    Assert::AreEqual(static_cast<uint64_t>(4222095273741296), output[4]);
+                    Assert::AreEqual(static_cast<uint64_t>(4222095273741296), output[5]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(1688834978864624), output[6]);
+                    Assert::AreEqual(static_cast<uint64_t>(1688834978864624), output[7]);
+                    Assert::AreEqual(static_cast<uint64_t>(1688834978864624), output[8]);
+                }
+            }
+
+            TEST_METHOD(FastFloor)
+            {
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 1, 0, plain_t);
+                    Pointer input(allocate_uint(5, pool));
+                    Pointer output(allocate_uint(3, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff00ff00; the result is floor(x / (q1 * q2)) - alpha,
+                    // where floor(x / (q1 * q2)) = 16777216 and alpha is 0 or 1
+                    input[0] = 1152842614915006208;  // mod q1
+                    input[1] = 1150475923937622848;  // mod q2
+                    input[2] = 287522703325593299;  // mod m1
+                    input[3] = 2304204190033444367;  // mod m2
+                    input[4] = 2305545041698422521;  // mod msk
+
+                    base_converter.fast_floor(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(16777215), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(16777215), output[1]);
+                    Assert::AreEqual(static_cast<uint64_t>(16777215), output[2]);
+                }
+
+                {
+                    MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                    vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                    SmallModulus plain_t(65537);
+                    BaseConverter base_converter(coeff_base, 2, 1, plain_t);
+                    Pointer input(allocate_uint(10, pool));
+                    Pointer output(allocate_uint(6, pool));
+
+                    // The composed input is 0xffffffffffffff00ffffffffffffff00ffff0000; the result is floor(x / (q1 * q2)) - alpha,
+                    // where floor(x / (q1 * q2)) = 1099511627783 and alpha is 0 or 1
+                    input[0] = 594492695752867845;  // mod q1
+                    input[1] = 594492695752867845;
+
+                    input[2] = 1135436438141010060;  // mod q2
+                    input[3] = 1135436438141010060;
+
+                    input[4] = 2044656901703458837;  // mod m1
+                    input[5] = 2044656901703458837;
+
+                    input[6] = 972968391595589679;  // mod m2
+                    input[7] = 972968391595589679;
+
+                    input[8] = 1224988139531468809;  // mod msk
+                    input[9] = 1224988139531468809;
+
+                    base_converter.fast_floor(input.get(), output.get(), pool);
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[0]);
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[1]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[2]);
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[3]);
+
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[4]);
+                    Assert::AreEqual(static_cast<uint64_t>(1099511627783), output[5]);
+                }
+            }
+
+            TEST_METHOD(FastBConver_mtilde)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                SmallModulus plain_t(65537);
+                BaseConverter base_converter(coeff_base, 3, 2, plain_t);
+                Pointer input(allocate_uint(6, pool));
+                Pointer output(allocate_uint(12, pool));
+
+                // The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs; the output is in Bsk U {m_tilde}
+                input[0] = 72057662752686096;  // mod q1
+                input[1] = 72057662752686096;
+                input[2] = 72057662752686096;
+
+                input[3] = 72123633308794896;  // mod q2
+                input[4] = 72123633308794896;
+                input[5] = 72123633308794896;
+
+                base_converter.fastbconv_mtilde(input.get(), output.get(), pool);
+                Assert::AreEqual(static_cast<uint64_t>(1555523919906895745), output[0]);
+                Assert::AreEqual(static_cast<uint64_t>(1555523919906895745), output[1]);
+                Assert::AreEqual(static_cast<uint64_t>(1555523919906895745), output[2]);
+
+                Assert::AreEqual(static_cast<uint64_t>(1303076440238108545), output[3]);
+                Assert::AreEqual(static_cast<uint64_t>(1303076440238108545), output[4]);
+                Assert::AreEqual(static_cast<uint64_t>(1303076440238108545), output[5]);
+
+                Assert::AreEqual(static_cast<uint64_t>(1666607826790240129), output[6]);
+                Assert::AreEqual(static_cast<uint64_t>(1666607826790240129), output[7]);
+                Assert::AreEqual(static_cast<uint64_t>(1666607826790240129), output[8]);
+
+                Assert::AreEqual(static_cast<uint64_t>(4286578689), output[9]);
+                Assert::AreEqual(static_cast<uint64_t>(4286578689), output[10]);
+                Assert::AreEqual(static_cast<uint64_t>(4286578689), output[11]);
+            }
+
+            TEST_METHOD(FastBConvert_plain_gamma)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1) };
+                SmallModulus plain_t(65537);
+                BaseConverter base_converter(coeff_base, 3, 2, plain_t);
+                Pointer input(allocate_uint(6, pool));
+                Pointer output(allocate_uint(6, pool));
+
+                // The composed input is 0xffffffffffffff00ffffffffffffff for all coeffs; the output is in {t, gamma}
+                input[0] = 72057662752686096;  // mod q1
+                input[1] = 72057662752686096;
+                input[2] = 72057662752686096;
+
+                input[3] = 72123633308794896;  // mod q2
+                input[4] = 72123633308794896;
+                input[5] = 72123633308794896;
+
+                base_converter.fastbconv_plain_gamma(input.get(), output.get(), pool);
+                Assert::AreEqual(static_cast<uint64_t>(65023), output[0]);
+                Assert::AreEqual(static_cast<uint64_t>(65023), output[1]);
+                Assert::AreEqual(static_cast<uint64_t>(65023), output[2]);
+
+                Assert::AreEqual(static_cast<uint64_t>(1801443218168610824), output[3]);
+                Assert::AreEqual(static_cast<uint64_t>(1801443218168610824), output[4]);
+                Assert::AreEqual(static_cast<uint64_t>(1801443218168610824), output[5]);
+            }
+
+            TEST_METHOD(BaseConverterSharesBskTables)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                random_device rd;
+                vector<SmallModulus> coeff_base{ small_mods_60bit(0), small_mods_60bit(1), small_mods_60bit(2) };
+                SmallModulus plain_t(65537);
+                int coeff_count_power = 10;
+                int coeff_count = (1 << coeff_count_power) + 1;
+                BaseConverter top_converter(coeff_base, coeff_count, coeff_count_power, plain_t);
+
+                // A smaller coefficient base uses a prefix of the auxiliary base and m_sk
+                coeff_base.pop_back();
+                BaseConverter generated(coeff_base, coeff_count, coeff_count_power, plain_t);
+                BaseConverter shared(coeff_base, coeff_count, coeff_count_power, plain_t, top_converter);
+                Assert::IsTrue(shared.is_generated());
+                Assert::AreEqual(generated.bsk_base_mod_count(), shared.bsk_base_mod_count());
+                for (int i = 0; i < generated.bsk_base_mod_count(); i++)
+                {
+                    const SmallNTTTables &generated_tables = generated.get_bsk_small_ntt_table()[i];
+                    const SmallNTTTables &shared_tables = shared.get_bsk_small_ntt_table()[i];
+                    Assert::AreEqual(generated_tables.modulus().value(), shared_tables.modulus().value());
+                    for (int j = 0; j < generated_tables.coeff_count(); j++)
+                    {
+                        Assert::AreEqual(generated_tables.get_from_root_powers(j), shared_tables.get_from_root_powers(j));
+                        Assert::AreEqual(generated_tables.get_from_inv_root_powers_div_two(j), 
+                            shared_tables.get_from_inv_root_powers_div_two(j));
+                    }
+                }
+
+                int coeff_mod_count = coeff_base.size();
+                int bsk_mod_count = generated.bsk_base_mod_count();
+                Pointer input(allocate_uint(coeff_count * coeff_mod_count, pool));
+                Pointer expected(allocate_uint(coeff_count * bsk_mod_count, pool));
+                Pointer output(allocate_uint(coeff_count * bsk_mod_count, pool));
+                for (int i = 0; i < coeff_mod_count; i++)
+                {
+                    for (int j = 0; j < coeff_count; j++)
+                    {
+                        input[i * coeff_count + j] = ((static_cast<uint64_t>(rd()) << 32) | rd()) % coeff_base[i].value();
+                    }
+                }
+                generated.fastbconv(input.get(), expected.get(), pool);
+                shared.fastbconv(input.get(), output.get(), pool);
+                for (int i = 0; i < coeff_count * bsk_mod_count; i++)
+                {
+                    Assert::AreEqual(expected[i], output[i]);
+                }
+
+                // The NTT tables must be for the same degree
+                Assert::ExpectException<invalid_argument>([&]() {
+                    BaseConverter(coeff_base, 2 * coeff_count - 1, coeff_count_power + 1, plain_t, top_converter);
+                });
+            }
+        };
+
+        TEST_CLASS(BaseConverterKernelsTest)
+        {
+        public:
+            TEST_METHOD(BaseConvertKernelsMatchGenericTest)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                random_device rd;
+                auto random_uint64 = [&rd]() { return (static_cast<uint64_t>(rd()) << 32) | rd(); };
+
+                vector<SmallModulus> moduli{ small_mods_30bit(0), small_mods_40bit(0), small_mods_50bit(0),
+                    small_mods_60bit(0), 0x3FFFFFFFFFFE8001ULL, static_cast<uint64_t>(1) << 32 };
+                for (int coeff_count : { 1, 7, 8, 9, 33, 1025 })
+                {
+                    int max_input_count = 8;
+                    Pointer input(allocate_uint(coeff_count * max_input_count, pool));
+                    Pointer r(allocate_uint(coeff_count, pool));
+                    Pointer result(allocate_uint(coeff_count, pool));
+                    Pointer expected(allocate_uint(coeff_count, pool));
+                    vector<uint64_t> factors(max_input_count);
+                    for (auto &modulus : moduli)
+                    {
+                        uint64_t operand1 = random_uint64() % modulus.value();
+                        uint64_t operand2 = random_uint64() % modulus.value();
+                        for (int i = 0; i < coeff_count * max_input_count; i++)
+                        {
+                            input[i] = random_uint64() & 0x1FFFFFFFFFFFFFFFULL;
+                        }
+                        for (int i = 0; i < max_input_count; i++)
+                        {
+                            factors[i] = random_uint64() % modulus.value();
+                        }
+
+                        for (int input_count = 1; input_count <= max_input_count; input_count++)
+                        {
+                            base_convert_dot_product(input.get(), input_count, coeff_count, factors.data(), modulus, result.get());
+                            base_convert_dot_product_generic(input.get(), input_count, coeff_count, factors.data(), modulus, expected.get());
+                            for (int i = 0; i < coeff_count; i++)
+                            {
+                                Assert::AreEqual(expected[i], result[i]);
+                            }
+                        }
+
+                        base_convert_multiply(input.get(), coeff_count, operand1, modulus, result.get());
+                        base_convert_multiply_generic(input.get(), coeff_count, operand1, modulus, expected.get());
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            Assert::AreEqual(expected[i], result[i]);
+                        }
+
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            input[i] %= modulus.value();
+                            r[i] = rd();
+                        }
+                        base_convert_mont_reduce(input.get(), r.get(), coeff_count, operand1, operand2, modulus, result.get());
+                        base_convert_mont_reduce_generic(input.get(), r.get(), coeff_count, operand1, operand2, modulus, expected.get());
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            Assert::AreEqual(expected[i], result[i]);
+                        }
+
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            result[i] = random_uint64() % modulus.value();
+                            expected[i] = result[i];
+                        }
+                        base_convert_floor(input.get(), coeff_count, operand1, modulus, result.get());
+                        base_convert_floor_generic(input.get(), coeff_count, operand1, modulus, expected.get());
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            Assert::AreEqual(expected[i], result[i]);
+                        }
+                    }
+                }
+            }
+        };
+    }
+}
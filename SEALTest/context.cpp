@@ -1,5 +1,13 @@
 #include "CppUnitTest.h"
 #include "seal/context.h"
+#include "seal/evaluator.h"
+#include "seal/defaultparams.h"
+#include "seal/keygenerator.h"
+#include "seal/encryptor.h"
+#include "seal/decryptor.h"
+#include "seal/encoder.h"
+#include <fstream>
+#include <cstdio>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace seal;
@@ -208,5 +216,125 @@ namespace SEALTest
                 Assert::IsTrue(qualifiers.enable_fast_plain_lift);
             }
         }
+
+        TEST_METHOD(ContextSharesPrecomputations)
+        {
+            EncryptionParameters parms;
+            parms.set_poly_modulus("1x^4096 + 1");
+            parms.set_coeff_modulus(coeff_modulus_128(4096));
+            parms.set_plain_modulus(1 << 6);
+            parms.set_noise_standard_deviation(3.19);
+            parms.set_random_generator(UniformRandomGeneratorFactory::default_factory());
+
+            MemoryPoolHandle context_pool = MemoryPoolHandle::New();
+            SEALContext context(parms, context_pool);
+            Assert::IsTrue(context.qualifiers().parameters_set);
+            SEALContext context_copy(context);
+
+            // Tools constructed from the context (or from each other) must not duplicate 
+            // the NTT tables, which alone take 6 * 4096 words per prime
+            MemoryPoolHandle tool_pool = MemoryPoolHandle::New();
+            Evaluator evaluator(context_copy, tool_pool);
+            Evaluator evaluator_copy(evaluator);
+            uint64_t ntt_table_byte_count = 6 * 4096 * sizeof(uint64_t) * parms.coeff_modulus().size();
+            Assert::IsTrue(tool_pool.alloc_byte_count() < ntt_table_byte_count);
+        }
+
+        TEST_METHOD(ContextCreatesModulusSwitchingChainLazily)
+        {
+            EncryptionParameters parms;
+            parms.set_poly_modulus("1x^8192 + 1");
+            parms.set_coeff_modulus(coeff_modulus_128(8192));
+            parms.set_plain_modulus(1 << 6);
+            parms.set_noise_standard_deviation(3.19);
+            parms.set_random_generator(UniformRandomGeneratorFactory::default_factory());
+            int coeff_mod_count = parms.coeff_modulus().size();
+            Assert::IsTrue(coeff_mod_count > 2);
+
+            ContextCache::set_capacity(ContextCache::default_capacity);
+            ContextCache::clear();
+            ContextCache::reset_stats();
+            MemoryPoolHandle context_pool = MemoryPoolHandle::New();
+            SEALContext context(parms, context_pool);
+            SEALContext context_copy(context);
+
+            // The levels are shared by the copies of a context, and bypass the ContextCache
+            auto next_context = context.next_context();
+            Assert::IsTrue(next_context == context_copy.next_context());
+            Assert::IsTrue(next_context == context.next_context());
+            int level_count = 1;
+            for (auto level = next_context; level; level = level->next_context())
+            {
+                Assert::IsTrue(level->qualifiers().parameters_set);
+                Assert::AreEqual(coeff_mod_count - level_count, static_cast<int>(level->coeff_modulus().size()));
+                level_count++;
+            }
+            Assert::AreEqual(coeff_mod_count, level_count);
+            auto stats = ContextCache::stats();
+            Assert::AreEqual(static_cast<uint64_t>(1), stats.misses);
+            Assert::AreEqual(static_cast<uint64_t>(0), stats.hits);
+            Assert::AreEqual(1, stats.entry_count);
+
+            // The levels use the NTT tables of the top level instead of generating their own,
+            // which would take 6 * 8192 words per prime
+            uint64_t ntt_table_byte_count = 6 * 8192 * sizeof(uint64_t);
+            Assert::IsTrue(context_pool.alloc_byte_count() < ntt_table_byte_count);
+            ContextCache::reset_stats();
+        }
+
+        TEST_METHOD(ContextSaveLoadPrecomputation)
+        {
+            EncryptionParameters parms;
+            parms.set_poly_modulus("1x^4096 + 1");
+            parms.set_coeff_modulus(coeff_modulus_128(4096));
+            parms.set_plain_modulus(65537);
+            parms.set_noise_standard_deviation(3.19);
+            parms.set_random_generator(UniformRandomGeneratorFactory::default_factory());
+
+            const char *path = "context_precomputation.bin";
+            {
+                SEALContext context(parms);
+                ofstream stream(path, ios::binary);
+                context.save_precomputation(stream);
+            }
+
+            // Disable the cache so that the tables are really read from the file
+            ContextCache::set_capacity(0);
+            {
+                SEALContext context = SEALContext::load_precomputation(parms, path);
+                auto qualifiers = context.qualifiers();
+                Assert::IsTrue(qualifiers.parameters_set);
+                Assert::IsTrue(qualifiers.enable_ntt);
+                Assert::IsTrue(qualifiers.enable_batching);
+                Assert::IsTrue(qualifiers.enable_fast_plain_lift);
+
+                KeyGenerator keygen(context);
+                EvaluationKeys evk;
+                keygen.generate_evaluation_keys(30, evk);
+                IntegerEncoder encoder(parms.plain_modulus());
+                Encryptor encryptor(context, keygen.public_key());
+                Evaluator evaluator(context);
+                Decryptor decryptor(context, keygen.secret_key());
+
+                Ciphertext encrypted1;
+                Ciphertext encrypted2;
+                Plaintext plain;
+                encryptor.encrypt(encoder.encode(0x12345), encrypted1);
+                encryptor.encrypt(encoder.encode(0x54321), encrypted2);
+                evaluator.multiply(encrypted1, encrypted2);
+                evaluator.relinearize(encrypted1, evk);
+                decryptor.decrypt(encrypted1, plain);
+                Assert::AreEqual(static_cast<uint64_t>(0x5FCB99AE5), encoder.decode_uint64(plain));
+
+                // The lower levels are derived from the mapped tables
+                evaluator.mod_switch_to_next(encrypted1);
+                Assert::IsTrue(encrypted1.hash_block() == context.next_context()->parms().hash_block());
+                evaluator.add(encrypted1, encrypted1);
+                decryptor.decrypt(encrypted1, plain);
+                Assert::AreEqual(static_cast<uint64_t>(0xBF97335CA), encoder.decode_uint64(plain));
+            }
+            ContextCache::set_capacity(ContextCache::default_capacity);
+            remove(path);
+        }
     };
 }
\ No newline at end of file
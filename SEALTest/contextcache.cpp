@@ -0,0 +1,68 @@
+#include "CppUnitTest.h"
+#include "seal/context.h"
+#include "seal/contextcache.h"
+#include "seal/defaultparams.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    TEST_CLASS(ContextCacheTest)
+    {
+    public:
+        TEST_METHOD(ContextCacheHitsAndEvictions)
+        {
+            ContextCache::set_capacity(ContextCache::default_capacity);
+            ContextCache::clear();
+            ContextCache::reset_stats();
+
+            EncryptionParameters parms;
+            parms.set_poly_modulus("1x^1024 + 1");
+            parms.set_coeff_modulus(coeff_modulus_128(1024));
+            parms.set_plain_modulus(1 << 6);
+            {
+                SEALContext context1(parms);
+                SEALContext context2(parms);
+                Assert::IsTrue(context1.qualifiers().enable_ntt);
+                Assert::IsTrue(context2.qualifiers().enable_ntt);
+
+                auto stats = ContextCache::stats();
+                Assert::AreEqual(static_cast<uint64_t>(1), stats.misses);
+                Assert::AreEqual(static_cast<uint64_t>(1), stats.hits);
+                Assert::AreEqual(1, stats.entry_count);
+                Assert::AreEqual(ContextCache::default_capacity, stats.capacity);
+            }
+
+            // Entries stay cached after all contexts are gone
+            {
+                SEALContext context(parms);
+                Assert::AreEqual(static_cast<uint64_t>(2), ContextCache::stats().hits);
+            }
+
+            ContextCache::set_capacity(1);
+            EncryptionParameters parms2 = parms;
+            parms2.set_plain_modulus(65537);
+            {
+                SEALContext context(parms2);
+                Assert::IsTrue(context.qualifiers().enable_batching);
+                auto stats = ContextCache::stats();
+                Assert::AreEqual(static_cast<uint64_t>(2), stats.misses);
+                Assert::IsTrue(stats.evictions >= 1);
+                Assert::AreEqual(1, stats.entry_count);
+            }
+
+            // Disabled cache still produces working contexts
+            ContextCache::set_capacity(0);
+            {
+                SEALContext context(parms);
+                Assert::IsTrue(context.qualifiers().enable_ntt);
+                Assert::AreEqual(0, ContextCache::stats().entry_count);
+            }
+
+            ContextCache::set_capacity(ContextCache::default_capacity);
+            ContextCache::reset_stats();
+        }
+    };
+}
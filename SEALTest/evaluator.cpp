@@ -8,6 +8,8 @@
 #include "seal/encoder.h"
 #include <cstdint>
 #include <string>
+#include <algorithm>
+#include <sstream>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace seal;
@@ -594,6 +596,64 @@ namespace SEALTest
             Assert::IsTrue(encrypted.hash_block() == parms.hash_block());
         }
 
+        TEST_METHOD(FVEncryptMultiplyRelinearizeDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 6);
+            parms.set_poly_modulus("1x^64 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(30, 2, evk);
+
+            BalancedEncoder encoder(plain_modulus);
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            Ciphertext encrypted1;
+            Ciphertext encrypted2;
+            Ciphertext product;
+            Ciphertext fused;
+            Plaintext plain;
+            encryptor.encrypt(encoder.encode(-123), encrypted1);
+            encryptor.encrypt(encoder.encode(4567), encrypted2);
+            evaluator.multiply(encrypted1, encrypted2, product);
+            evaluator.relinearize(product, evk);
+            evaluator.multiply_relinearize(encrypted1, encrypted2, evk, fused);
+            Assert::AreEqual(2, fused.size());
+            Assert::IsTrue(equal(product.pointer(), product.pointer() + product.uint64_count(), fused.pointer()));
+            decryptor.decrypt(fused, plain);
+            Assert::AreEqual(-561741LL, encoder.decode_int64(plain));
+            Assert::IsTrue(fused.hash_block() == parms.hash_block());
+
+            evaluator.multiply_relinearize(fused, fused, evk);
+            decryptor.decrypt(fused, plain);
+            Assert::AreEqual(315552951081LL, encoder.decode_int64(plain));
+
+            // NTT form is kept and gives the same result as the separate operations
+            Ciphertext encrypted1_ntt;
+            Ciphertext encrypted2_ntt;
+            evaluator.transform_to_ntt(encrypted1, encrypted1_ntt);
+            evaluator.transform_to_ntt(encrypted2, encrypted2_ntt);
+            evaluator.multiply(encrypted1_ntt, encrypted2_ntt, product);
+            evaluator.relinearize(product, evk);
+            evaluator.multiply_relinearize(encrypted1_ntt, encrypted2_ntt, evk, fused);
+            Assert::IsTrue(fused.is_ntt_form());
+            Assert::IsTrue(equal(product.pointer(), product.pointer() + product.uint64_count(), fused.pointer()));
+            decryptor.decrypt(fused, plain);
+            Assert::AreEqual(-561741LL, encoder.decode_int64(plain));
+
+            // Larger inputs fall back to multiply followed by relinearize
+            evaluator.multiply(encrypted1, encrypted2, product);
+            evaluator.multiply_relinearize(product, encrypted1, evk);
+            Assert::AreEqual(2, product.size());
+            decryptor.decrypt(product, plain);
+            Assert::AreEqual(69094143LL, encoder.decode_int64(plain));
+        }
+
         TEST_METHOD(FVEncryptMultiplyManyDecrypt)
         {
             EncryptionParameters parms;
@@ -676,6 +736,112 @@ namespace SEALTest
                 Assert::IsTrue(product.hash_block() == parms.hash_block());
         }
 
+        TEST_METHOD(FVEncryptMultiplyManyParallelDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 6);
+            parms.set_poly_modulus("1x^128 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            BalancedEncoder encoder(plain_modulus);
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(16, 4, evk);
+
+            vector<Ciphertext> encrypteds(5);
+            encryptor.encrypt(encoder.encode(2), encrypteds[0]);
+            encryptor.encrypt(encoder.encode(3), encrypteds[1]);
+            encryptor.encrypt(encoder.encode(-1), encrypteds[2]);
+            encryptor.encrypt(encoder.encode(4), encrypteds[3]);
+            encryptor.encrypt(encoder.encode(5), encrypteds[4]);
+
+            Ciphertext product;
+            Ciphertext product_threaded;
+            Plaintext plain;
+            evaluator.multiply_many_parallel(encrypteds, evk, product);
+            Assert::AreEqual(2, product.size());
+            decryptor.decrypt(product, plain);
+            Assert::AreEqual(-120LL, encoder.decode_int64(plain));
+            Assert::IsTrue(product.hash_block() == parms.hash_block());
+
+            // The result does not depend on the number of threads
+            Evaluator threaded_evaluator(context);
+            threaded_evaluator.set_thread_count(3);
+            threaded_evaluator.multiply_many_parallel(encrypteds, evk, product_threaded);
+            Assert::AreEqual(2, product_threaded.size());
+            Assert::IsTrue(equal(product.pointer(), product.pointer() + product.uint64_count(), 
+                product_threaded.pointer()));
+
+            threaded_evaluator.set_thread_count(4);
+            for (int lazy_relin_levels = 1; lazy_relin_levels <= 3; lazy_relin_levels++)
+            {
+                evaluator.multiply_many_parallel(encrypteds, evk, product, lazy_relin_levels);
+                threaded_evaluator.multiply_many_parallel(encrypteds, evk, product_threaded, lazy_relin_levels);
+                Assert::AreEqual(2, product.size());
+                Assert::IsTrue(equal(product.pointer(), product.pointer() + product.uint64_count(), 
+                    product_threaded.pointer()));
+                decryptor.decrypt(product, plain);
+                Assert::AreEqual(-120LL, encoder.decode_int64(plain));
+            }
+
+            threaded_evaluator.multiply_many_parallel({ encrypteds[3] }, evk, product);
+            decryptor.decrypt(product, plain);
+            Assert::AreEqual(4LL, encoder.decode_int64(plain));
+        }
+
+        TEST_METHOD(FVEncryptDotProductDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 6);
+            parms.set_poly_modulus("1x^64 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(30, 2, evk);
+
+            BalancedEncoder encoder(plain_modulus);
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            vector<Ciphertext> encrypteds1(3);
+            vector<Ciphertext> encrypteds2(3);
+            encryptor.encrypt(encoder.encode(12), encrypteds1[0]);
+            encryptor.encrypt(encoder.encode(-345), encrypteds1[1]);
+            encryptor.encrypt(encoder.encode(6789), encrypteds1[2]);
+            encryptor.encrypt(encoder.encode(-98), encrypteds2[0]);
+            encryptor.encrypt(encoder.encode(76), encrypteds2[1]);
+            encryptor.encrypt(encoder.encode(5), encrypteds2[2]);
+
+            Ciphertext encrypted;
+            Plaintext plain;
+            evaluator.dot_product(encrypteds1, encrypteds2, evk, encrypted);
+            Assert::AreEqual(2, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            Assert::AreEqual(6549LL, encoder.decode_int64(plain));
+            Assert::IsTrue(encrypted.hash_block() == parms.hash_block());
+
+            evaluator.dot_product({ encrypteds1[1] }, { encrypteds2[1] }, evk, encrypted);
+            Assert::AreEqual(2, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            Assert::AreEqual(-26220LL, encoder.decode_int64(plain));
+
+            // Unrelinearized inputs give products of different sizes
+            evaluator.multiply(encrypteds1[0], encrypteds2[0], encrypted);
+            encrypteds1[0] = encrypted;
+            evaluator.dot_product(encrypteds1, encrypteds2, evk, encrypted);
+            Assert::AreEqual(2, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            Assert::AreEqual(122973LL, encoder.decode_int64(plain));
+        }
+
         TEST_METHOD(FVEncryptExponentiateDecrypt)
         {
             EncryptionParameters parms;
@@ -724,6 +890,106 @@ namespace SEALTest
             Assert::IsTrue(encrypted.hash_block() == parms.hash_block());
         }
 
+        TEST_METHOD(FVEncryptExponentiateBatchedDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(17);
+            parms.set_poly_modulus("1x^8 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(20, evk);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{ 0, 1, 2, 3, 4, 5, 15, 16 };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            Ciphertext power;
+            encryptor.encrypt(plain, encrypted);
+
+            // By Fermat's little theorem x^16 is 1 for every non-zero slot
+            evaluator.exponentiate(encrypted, 16, evk, power);
+            decryptor.decrypt(power, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{ 0, 1, 1, 1, 1, 1, 1, 1 });
+            Assert::IsTrue(power.hash_block() == parms.hash_block());
+
+            // x^15 is the inverse of every non-zero slot
+            evaluator.exponentiate(encrypted, 15, evk, power);
+            decryptor.decrypt(power, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{ 0, 1, 9, 6, 13, 7, 8, 16 });
+            Assert::AreEqual(2, power.size());
+
+            evaluator.exponentiate(encrypted, 11, evk, power);
+            decryptor.decrypt(power, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{ 0, 1, 8, 7, 13, 11, 9, 16 });
+        }
+
+        TEST_METHOD(FVEncryptExponentiateDepth)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(17);
+            parms.set_poly_modulus("1x^128 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_60bit(0), small_mods_60bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BalancedEncoder encoder(plain_modulus);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(20, evk);
+
+            Ciphertext encrypted;
+            encryptor.encrypt(encoder.encode(1), encrypted);
+
+            // x^16 by repeated squaring has depth 4
+            Ciphertext squared(encrypted);
+            for (int i = 0; i < 4; i++)
+            {
+                evaluator.square(squared);
+                evaluator.relinearize(squared, evk);
+            }
+            int depth4_budget = decryptor.invariant_noise_budget(squared);
+            Assert::IsTrue(depth4_budget > 0);
+
+            // Combining x, x^2, x^4, x^8 as a product tree has depth 5
+            vector<Ciphertext> powers(1, encrypted);
+            for (int i = 1; i < 4; i++)
+            {
+                powers.push_back(powers.back());
+                evaluator.square(powers.back());
+                evaluator.relinearize(powers.back(), evk);
+            }
+            Ciphertext tree;
+            evaluator.multiply_many(powers, evk, tree);
+            int depth5_budget = decryptor.invariant_noise_budget(tree);
+
+            // x^15 must have depth ceil(log2(15)) = 4
+            Ciphertext power;
+            evaluator.exponentiate(encrypted, 15, evk, power);
+            int power_budget = decryptor.invariant_noise_budget(power);
+            Plaintext plain;
+            decryptor.decrypt(power, plain);
+            Assert::AreEqual(static_cast<uint64_t>(1), encoder.decode_uint64(plain));
+
+            // The extra multiplications at lower depths cost a few bits at most, but a whole
+            // level costs far more
+            Assert::IsTrue(power_budget + 4 >= depth4_budget);
+            Assert::IsTrue(power_budget > depth5_budget + 4);
+        }
+
         TEST_METHOD(FVEncryptAddManyDecrypt)
         {
             EncryptionParameters parms;
@@ -820,6 +1086,69 @@ namespace SEALTest
             Assert::IsTrue(sum.hash_block() == parms.hash_block());
         }
 
+        TEST_METHOD(FVEncryptAddManyMixedSizesDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 10);
+            parms.set_poly_modulus("1x^64 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_60bit(0), small_mods_60bit(1), small_mods_60bit(2) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            BalancedEncoder encoder(plain_modulus);
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            // Many summands of 60-bit residues, including products of size 3
+            Ciphertext encrypted1, encrypted2, product, sum, expected;
+            Plaintext plain;
+            encryptor.encrypt(encoder.encode(3), encrypted1);
+            encryptor.encrypt(encoder.encode(-7), encrypted2);
+            evaluator.multiply(encrypted1, encrypted2, product);
+            vector<Ciphertext> encrypteds;
+            for (int i = 0; i < 100; i++)
+            {
+                encrypteds.push_back(encrypted1);
+                encrypteds.push_back(encrypted2);
+                encrypteds.push_back(product);
+            }
+            evaluator.add_many(encrypteds, sum);
+            Assert::AreEqual(3, sum.size());
+            decryptor.decrypt(sum, plain);
+            Assert::AreEqual(-2500LL, encoder.decode_int64(plain));
+            Assert::IsTrue(sum.hash_block() == parms.hash_block());
+
+            // Same result as adding one by one, with any number of threads
+            expected = encrypteds[0];
+            for (size_t i = 1; i < encrypteds.size(); i++)
+            {
+                evaluator.add(expected, encrypteds[i]);
+            }
+            Assert::IsTrue(equal(expected.pointer(), expected.pointer() + expected.uint64_count(), sum.pointer()));
+            Evaluator threaded_evaluator(context);
+            threaded_evaluator.set_thread_count(2);
+            threaded_evaluator.add_many(encrypteds, sum);
+            Assert::IsTrue(equal(expected.pointer(), expected.pointer() + expected.uint64_count(), sum.pointer()));
+
+            // Destination can be one of the summands
+            encrypteds = { encrypted2, product, encrypted1 };
+            evaluator.add_many(encrypteds, encrypteds[1]);
+            Assert::AreEqual(3, encrypteds[1].size());
+            decryptor.decrypt(encrypteds[1], plain);
+            Assert::AreEqual(-25LL, encoder.decode_int64(plain));
+
+            // NTT form is kept
+            evaluator.transform_to_ntt(encrypted1);
+            evaluator.transform_to_ntt(encrypted2);
+            encrypteds = { encrypted1, encrypted2 };
+            threaded_evaluator.add_many(encrypteds, sum);
+            Assert::IsTrue(sum.is_ntt_form());
+            decryptor.decrypt(sum, plain);
+            Assert::AreEqual(-4LL, encoder.decode_int64(plain));
+        }
+
         TEST_METHOD(TransformPlainToNTT)
         {
             EncryptionParameters parms;
@@ -962,6 +1291,263 @@ namespace SEALTest
             decryptor.decrypt(encrypted, plain);
             Assert::IsTrue(plain.to_string() == "Fx^30 + Ex^29 + Dx^28 + Cx^27 + Bx^26 + Ax^25 + 1x^24 + 2x^23 + 3x^22 + 4x^21 + 5x^20");
             Assert::IsTrue(encrypted.hash_block() == parms.hash_block());
+
+            // A plaintext not transformed to NTT form is rejected even when its size would fit
+            // the NTT form of a single prime
+            EncryptionParameters parms_single;
+            parms_single.set_poly_modulus("1x^16 + 1");
+            parms_single.set_plain_modulus(257);
+            parms_single.set_coeff_modulus({ small_mods_40bit(0) });
+            SEALContext context_single(parms_single);
+            KeyGenerator keygen_single(context_single);
+            Encryptor encryptor_single(context_single, keygen_single.public_key());
+            Evaluator evaluator_single(context_single);
+            PolyCRTBuilder crtbuilder(context_single);
+            crtbuilder.compose(vector<uint64_t>(16, 1), plain_multiplier);
+            plain_multiplier.resize(17);
+            encryptor_single.encrypt(plain_multiplier, encrypted);
+            evaluator_single.transform_to_ntt(encrypted);
+            Assert::ExpectException<invalid_argument>([&]() {
+                evaluator_single.multiply_plain_ntt(encrypted, plain_multiplier);
+            });
+            vector<Ciphertext> encrypteds{ encrypted };
+            vector<Plaintext> plains{ plain_multiplier };
+            Assert::ExpectException<invalid_argument>([&]() {
+                evaluator_single.dot_product_plain(encrypteds, plains, encrypted);
+            });
+        }
+
+        TEST_METHOD(FVEncryptDotProductPlainDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 12);
+            parms.set_poly_modulus("1x^64 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_60bit(0), small_mods_60bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            BalancedEncoder encoder(plain_modulus);
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            // More terms than the 60-bit primes allow without intermediate reductions
+            vector<Ciphertext> encrypteds_ntt(300);
+            vector<Plaintext> plains_ntt(300);
+            int64_t expected_value = 0;
+            for (int k = 0; k < 300; k++)
+            {
+                int64_t value = (k % 7) - 3;
+                int64_t multiplier = (k % 5) + 1;
+                expected_value += value * multiplier;
+                encryptor.encrypt(encoder.encode(value), encrypteds_ntt[k]);
+                evaluator.transform_to_ntt(encrypteds_ntt[k]);
+                plains_ntt[k] = encoder.encode(multiplier);
+                evaluator.transform_to_ntt(plains_ntt[k]);
+            }
+
+            Ciphertext encrypted;
+            Plaintext plain;
+            evaluator.dot_product_plain(encrypteds_ntt, plains_ntt, encrypted);
+            Assert::IsFalse(encrypted.is_ntt_form());
+            Assert::AreEqual(2, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            Assert::AreEqual(expected_value, encoder.decode_int64(plain));
+            Assert::IsTrue(encrypted.hash_block() == parms.hash_block());
+
+            // Same result as multiplying and adding term by term
+            Ciphertext expected;
+            Ciphertext product;
+            evaluator.multiply_plain_ntt(encrypteds_ntt[0], plains_ntt[0], expected);
+            for (int k = 1; k < 300; k++)
+            {
+                evaluator.multiply_plain_ntt(encrypteds_ntt[k], plains_ntt[k], product);
+                evaluator.add(expected, product);
+            }
+            evaluator.transform_from_ntt(expected);
+            Assert::IsTrue(equal(expected.pointer(), expected.pointer() + expected.uint64_count(), encrypted.pointer()));
+
+            // Ciphertexts of different sizes
+            evaluator.transform_from_ntt(encrypteds_ntt[1]);
+            evaluator.square(encrypteds_ntt[1]);
+            evaluator.transform_to_ntt(encrypteds_ntt[1]);
+            encrypteds_ntt.resize(2);
+            plains_ntt.resize(2);
+            evaluator.dot_product_plain(encrypteds_ntt, plains_ntt, encrypted);
+            Assert::AreEqual(3, encrypted.size());
+            decryptor.decrypt(encrypted, plain);
+            Assert::AreEqual(-3LL + 4 * 2, encoder.decode_int64(plain));
+        }
+
+        TEST_METHOD(FVEncryptNTTFormChainDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^8 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(24, evk);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4,
+                5, 6, 7, 8
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            Assert::IsFalse(encrypted.is_ntt_form());
+            Ciphertext encrypted_ntt;
+            evaluator.transform_to_ntt(encrypted, encrypted_ntt);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+            Ciphertext factor_ntt(encrypted_ntt);
+
+            evaluator.add(encrypted, encrypted);
+            evaluator.add(encrypted_ntt, encrypted_ntt);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+
+            Plaintext plain_multiplier;
+            vector<uint64_t> multiplier_vec{
+                1, 1, 1, 1,
+                2, 2, 2, 2
+            };
+            crtbuilder.compose(multiplier_vec, plain_multiplier);
+            evaluator.multiply_plain(encrypted, plain_multiplier);
+            evaluator.multiply_plain(encrypted_ntt, plain_multiplier);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+
+            evaluator.multiply(encrypted_ntt, factor_ntt);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+            Assert::AreEqual(3, encrypted_ntt.size());
+            evaluator.relinearize(encrypted_ntt, evk);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+            Assert::AreEqual(2, encrypted_ntt.size());
+
+            // Mixed forms give a result in the form of the first operand
+            evaluator.multiply(encrypted, factor_ntt);
+            Assert::IsFalse(encrypted.is_ntt_form());
+            evaluator.relinearize(encrypted, evk);
+
+            decryptor.decrypt(encrypted_ntt, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                2, 8, 18, 32,
+                100, 144, 196, 256
+            });
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                2, 8, 18, 32,
+                100, 144, 196, 256
+            });
+
+            evaluator.rotate_rows(encrypted_ntt, 1, glk);
+            evaluator.rotate_columns(encrypted_ntt, glk);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+            decryptor.decrypt(encrypted_ntt, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                144, 196, 256, 100,
+                8, 18, 32, 2
+            });
+
+            evaluator.negate(encrypted_ntt);
+            evaluator.transform_from_ntt(encrypted_ntt);
+            Assert::IsFalse(encrypted_ntt.is_ntt_form());
+            decryptor.decrypt(encrypted_ntt, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                113, 61, 1, 157,
+                249, 239, 225, 255
+            });
+            Assert::IsTrue(encrypted_ntt.hash_block() == parms.hash_block());
+        }
+
+        TEST_METHOD(FVEncryptMultiplyPlainPreparedDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^8 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4,
+                5, 6, 7, 8
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            Plaintext plain_multiplier;
+            vector<uint64_t> multiplier_vec{
+                2, 2, 2, 2,
+                256, 3, 3, 3
+            };
+            crtbuilder.compose(multiplier_vec, plain_multiplier);
+            Assert::IsFalse(plain_multiplier.is_ntt_form());
+            Plaintext plain_multiplier_ntt;
+            evaluator.transform_to_ntt(plain_multiplier, plain_multiplier_ntt);
+            Assert::IsTrue(plain_multiplier_ntt.is_ntt_form());
+
+            // The prepared form survives serialization
+            stringstream stream;
+            plain_multiplier_ntt.save(stream);
+            Plaintext plain_multiplier_loaded;
+            plain_multiplier_loaded.load(stream);
+            Assert::IsTrue(plain_multiplier_loaded.is_ntt_form());
+            Assert::IsTrue(plain_multiplier_loaded == plain_multiplier_ntt);
+
+            // Prepared plaintexts give the same result as plain ones in both forms
+            Ciphertext expected;
+            evaluator.multiply_plain(encrypted, plain_multiplier, expected);
+            Ciphertext product;
+            evaluator.multiply_plain(encrypted, plain_multiplier_loaded, product);
+            Assert::IsFalse(product.is_ntt_form());
+            Assert::IsTrue(equal(product.pointer(), product.pointer() + product.uint64_count(), expected.pointer()));
+
+            Ciphertext expected_ntt;
+            evaluator.transform_to_ntt(encrypted, expected_ntt);
+            Ciphertext product_ntt(expected_ntt);
+            evaluator.multiply_plain(expected_ntt, plain_multiplier);
+            evaluator.multiply_plain(product_ntt, plain_multiplier_loaded);
+            Assert::IsTrue(product_ntt.is_ntt_form());
+            Assert::IsTrue(equal(product_ntt.pointer(), product_ntt.pointer() + product_ntt.uint64_count(), 
+                expected_ntt.pointer()));
+
+            // Reusing the prepared plaintext repeatedly
+            evaluator.multiply_plain(product, plain_multiplier_loaded);
+            decryptor.decrypt(product, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                4, 8, 12, 16,
+                5, 54, 63, 72
+            });
+
+            // Assigning a new value returns a plaintext to coefficient form
+            plain_multiplier_loaded = 3;
+            Assert::IsFalse(plain_multiplier_loaded.is_ntt_form());
         }
 
         TEST_METHOD(FVEncryptRotateMatrixDecrypt)
@@ -1031,5 +1617,491 @@ namespace SEALTest
                 6, 7, 8, 5
             });
         }
+
+        TEST_METHOD(FVEncryptRotateNTTDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^8 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4,
+                5, 6, 7, 8
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            // Rotations keep the ciphertext in NTT form
+            evaluator.transform_to_ntt(encrypted);
+            evaluator.rotate_columns(encrypted, glk);
+            evaluator.rotate_rows(encrypted, -1, glk);
+            Assert::IsTrue(encrypted.is_ntt_form());
+            evaluator.transform_from_ntt(encrypted);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                8, 5, 6, 7,
+                4, 1, 2, 3
+            });
+        }
+
+        TEST_METHOD(FVEncryptRotateRowsManyDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^16 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            // Step 3 has no Galois key of its own
+            vector<int> steps{ 1, 0, -1, 2, 3, -4 };
+            vector<vector<uint64_t> > expected{
+                { 2, 3, 4, 5, 6, 7, 8, 1, 10, 11, 12, 13, 14, 15, 16, 9 },
+                { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 },
+                { 8, 1, 2, 3, 4, 5, 6, 7, 16, 9, 10, 11, 12, 13, 14, 15 },
+                { 3, 4, 5, 6, 7, 8, 1, 2, 11, 12, 13, 14, 15, 16, 9, 10 },
+                { 4, 5, 6, 7, 8, 1, 2, 3, 12, 13, 14, 15, 16, 9, 10, 11 },
+                { 5, 6, 7, 8, 1, 2, 3, 4, 13, 14, 15, 16, 9, 10, 11, 12 }
+            };
+            vector<Ciphertext> rotated;
+            evaluator.rotate_rows_many(encrypted, steps, glk, rotated);
+            Assert::AreEqual(6, static_cast<int>(rotated.size()));
+            for (int i = 0; i < 6; i++)
+            {
+                Assert::IsTrue(rotated[i].hash_block() == parms.hash_block());
+                decryptor.decrypt(rotated[i], plain);
+                crtbuilder.decompose(plain, plain_vec);
+                Assert::IsTrue(plain_vec == expected[i]);
+            }
+
+            evaluator.transform_to_ntt(encrypted);
+            evaluator.rotate_rows_many(encrypted, steps, glk, rotated);
+            Assert::AreEqual(6, static_cast<int>(rotated.size()));
+            for (int i = 0; i < 6; i++)
+            {
+                Assert::IsTrue(rotated[i].is_ntt_form());
+                decryptor.decrypt(rotated[i], plain);
+                crtbuilder.decompose(plain, plain_vec);
+                Assert::IsTrue(plain_vec == expected[i]);
+            }
+
+            // The input can be one of the destinations, even one written before the others
+            // are rotated
+            evaluator.rotate_rows_many(rotated[0], { 3, 1, -1, 0 }, glk, rotated);
+            Assert::AreEqual(4, static_cast<int>(rotated.size()));
+            vector<int> expected_index{ 5, 3, 1, 0 };
+            for (int i = 0; i < 4; i++)
+            {
+                evaluator.transform_from_ntt(rotated[i]);
+                decryptor.decrypt(rotated[i], plain);
+                crtbuilder.decompose(plain, plain_vec);
+                Assert::IsTrue(plain_vec == expected[expected_index[i]]);
+            }
+        }
+
+        TEST_METHOD(FVEncryptRotateWithMissingKeysDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^16 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+
+            // Only keys for rotating rows by 3 steps and for swapping the rows
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, vector<uint64_t>{ 27, 31 }, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            evaluator.rotate_rows(encrypted, 6, glk);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                7, 8, 1, 2, 3, 4, 5, 6,
+                15, 16, 9, 10, 11, 12, 13, 14
+            });
+
+            evaluator.rotate_rows(encrypted, -1, glk);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                6, 7, 8, 1, 2, 3, 4, 5,
+                14, 15, 16, 9, 10, 11, 12, 13
+            });
+
+            evaluator.rotate_rows(encrypted, 1, glk);
+            evaluator.rotate_columns(encrypted, glk);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                15, 16, 9, 10, 11, 12, 13, 14,
+                7, 8, 1, 2, 3, 4, 5, 6
+            });
+        }
+
+        TEST_METHOD(FVEncryptMultithreadedEvaluatorDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^16 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1), small_mods_40bit(2) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(24, 2, evk);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Evaluator threaded_evaluator(context);
+            Assert::AreEqual(1, threaded_evaluator.thread_count());
+            threaded_evaluator.set_thread_count(4);
+            Assert::AreEqual(4, threaded_evaluator.thread_count());
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            Ciphertext encrypted_ntt;
+            evaluator.transform_to_ntt(encrypted, encrypted_ntt);
+
+            auto is_same = [](const Ciphertext &a, const Ciphertext &b)
+            {
+                return a.size() == b.size() && a.is_ntt_form() == b.is_ntt_form() && 
+                    equal(a.pointer(), a.pointer() + a.uint64_count(), b.pointer());
+            };
+
+            // Results are identical to those of a single thread in both forms
+            for (int form = 0; form < 2; form++)
+            {
+                const Ciphertext &factor = form ? encrypted_ntt : encrypted;
+                Ciphertext expected(factor);
+                Ciphertext result(factor);
+
+                evaluator.multiply(expected, factor);
+                threaded_evaluator.multiply(result, factor);
+                Assert::IsTrue(is_same(expected, result));
+
+                // Product of size 3 and size 2 ciphertexts
+                evaluator.multiply(expected, factor);
+                threaded_evaluator.multiply(result, factor);
+                Assert::IsTrue(is_same(expected, result));
+                Assert::AreEqual(4, result.size());
+
+                evaluator.relinearize(expected, evk);
+                threaded_evaluator.relinearize(result, evk);
+                Assert::IsTrue(is_same(expected, result));
+
+                evaluator.multiply_relinearize(expected, factor, evk);
+                threaded_evaluator.multiply_relinearize(result, factor, evk);
+                Assert::IsTrue(is_same(expected, result));
+
+                evaluator.rotate_rows(expected, 3, glk);
+                threaded_evaluator.rotate_rows(result, 3, glk);
+                Assert::IsTrue(is_same(expected, result));
+
+                evaluator.rotate_columns(expected, glk);
+                threaded_evaluator.rotate_columns(result, glk);
+                Assert::IsTrue(is_same(expected, result));
+
+                if (form)
+                {
+                    evaluator.transform_from_ntt(result);
+                }
+                decryptor.decrypt(result, plain);
+                crtbuilder.decompose(plain, plain_vec);
+                Assert::IsTrue(plain_vec == vector<uint64_t>{
+                    176, 34, 123, 253, 1, 136, 234, 249,
+                    256, 111, 11, 88, 241, 1, 16, 81
+                });
+            }
+
+            // A copy has a thread pool of its own
+            Evaluator evaluator_copy(threaded_evaluator);
+            Assert::AreEqual(4, evaluator_copy.thread_count());
+            threaded_evaluator.set_thread_count(1);
+            Assert::AreEqual(1, threaded_evaluator.thread_count());
+        }
+
+        TEST_METHOD(FVEncryptModSwitchDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^16 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1), small_mods_40bit(2) });
+            SEALContext context(parms);
+            Assert::AreEqual(2, static_cast<int>(context.next_context()->coeff_modulus().size()));
+            Assert::AreEqual(1, static_cast<int>(context.next_context()->next_context()->coeff_modulus().size()));
+            Assert::IsTrue(context.next_context()->next_context()->next_context() == nullptr);
+
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(24, 1, evk);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Plaintext plain_ntt;
+            evaluator.transform_to_ntt(plain, plain_ntt);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            stringstream top_stream;
+            encrypted.save(top_stream);
+
+            // Switching keeps the plaintext and drops one prime
+            evaluator.mod_switch_to_next(encrypted);
+            Assert::AreEqual(2, encrypted.coeff_mod_count());
+            stringstream next_stream;
+            encrypted.save(next_stream);
+            Assert::IsTrue(next_stream.str().size() < top_stream.str().size());
+            Assert::IsTrue(decryptor.invariant_noise_budget(encrypted) > 0);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            });
+
+            // Operations at the lower level with the keys and plaintexts of the top level
+            evaluator.multiply_relinearize(encrypted, encrypted, evk);
+            evaluator.rotate_rows(encrypted, 2, glk);
+            vector<Ciphertext> rotated;
+            evaluator.rotate_rows_many(encrypted, { -1 }, glk, rotated);
+            encrypted = rotated[0];
+            evaluator.transform_to_ntt(encrypted);
+            evaluator.multiply_plain(encrypted, plain_ntt);
+            decryptor.decrypt(encrypted, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                4, 18, 48, 100, 180, 37, 191, 8,
+                129, 182, 42, 229, 235, 66, 242, 11
+            });
+
+            // Switching in NTT form to the last level
+            Ciphertext encrypted_last;
+            evaluator.mod_switch_to_next(encrypted, encrypted_last);
+            Assert::AreEqual(1, encrypted_last.coeff_mod_count());
+            Assert::IsTrue(encrypted_last.is_ntt_form());
+            evaluator.transform_from_ntt(encrypted_last);
+            evaluator.add(encrypted_last, encrypted_last);
+            decryptor.decrypt(encrypted_last, plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                8, 36, 96, 200, 103, 74, 125, 16,
+                1, 107, 84, 201, 213, 132, 227, 22
+            });
+        }
+
+        TEST_METHOD(FVEncryptRNSKeySwitchDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^16 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1), small_mods_40bit(2) });
+            SEALContext context(parms);
+
+            // RNS keys hold a single digit per prime
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_rns_evaluation_keys(evk);
+            Assert::AreEqual(0, evk.decomposition_bit_count());
+            Assert::AreEqual(3, static_cast<int>(evk.data()[0].size()));
+            Assert::AreEqual(2, evk.data()[0][0].size());
+            GaloisKeys glk;
+            keygen.generate_rns_galois_keys(glk);
+            Assert::AreEqual(0, glk.decomposition_bit_count());
+            Assert::AreEqual(2, glk.key(3)[2].size());
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4, 5, 6, 7, 8,
+                9, 10, 11, 12, 13, 14, 15, 16
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            // At the top level there are no special primes
+            evaluator.multiply_relinearize(encrypted, encrypted, evk);
+            evaluator.rotate_rows(encrypted, 1, glk);
+            vector<Ciphertext> rotated;
+            evaluator.rotate_rows_many(encrypted, { -1, 2 }, glk, rotated);
+            decryptor.decrypt(rotated[0], plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                1, 4, 9, 16, 25, 36, 49, 64,
+                81, 100, 121, 144, 169, 196, 225, 256
+            });
+            decryptor.decrypt(rotated[1], plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                16, 25, 36, 49, 64, 1, 4, 9,
+                144, 169, 196, 225, 256, 81, 100, 121
+            });
+
+            // Below the top level the switched away prime is a special prime
+            encrypted = rotated[1];
+            evaluator.mod_switch_to_next(encrypted);
+            evaluator.multiply_relinearize(encrypted, encrypted, evk);
+            evaluator.transform_to_ntt(encrypted);
+            evaluator.rotate_rows(encrypted, -3, glk);
+            evaluator.rotate_rows_many(encrypted, { 1 }, glk, rotated);
+            evaluator.transform_from_ntt(rotated[0]);
+            Assert::IsTrue(decryptor.invariant_noise_budget(rotated[0]) > 0);
+            decryptor.decrypt(rotated[0], plain);
+            crtbuilder.decompose(plain, plain_vec);
+            Assert::IsTrue(plain_vec == vector<uint64_t>{
+                16, 81, 256, 111, 11, 88, 241, 1,
+                234, 249, 176, 34, 123, 253, 1, 136
+            });
+        }
+
+        TEST_METHOD(FVEncryptSumReplicateSlotsDecrypt)
+        {
+            for (int slot_count : { 16, 32 })
+            {
+                EncryptionParameters parms;
+                SmallModulus plain_modulus(257);
+                BigPoly poly_modulus("1x^" + to_string(slot_count) + " + 1");
+                parms.set_poly_modulus(poly_modulus);
+                parms.set_plain_modulus(plain_modulus);
+                parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+                SEALContext context(parms);
+                KeyGenerator keygen(context);
+                GaloisKeys sum_glk;
+                keygen.generate_sum_slots_galois_keys(24, sum_glk);
+                GaloisKeys rns_sum_glk;
+                keygen.generate_rns_sum_slots_galois_keys(rns_sum_glk);
+                GaloisKeys glk;
+                keygen.generate_galois_keys(24, glk);
+
+                // Steps 1, 2, and 3 share a round; rows of 8 slots need one more round of
+                // step 4, and rows of 16 slots a round of steps 4, 8, and 12
+                Assert::IsTrue(sum_glk.has_key(3) && sum_glk.has_key(9) && sum_glk.has_key(27));
+                Assert::AreEqual(slot_count == 16 ? 5 : 7, static_cast<int>(sum_glk.size()));
+
+                Encryptor encryptor(context, keygen.public_key());
+                Evaluator evaluator(context);
+                Decryptor decryptor(context, keygen.secret_key());
+                PolyCRTBuilder crtbuilder(context);
+
+                Plaintext plain;
+                vector<uint64_t> plain_vec(slot_count);
+                uint64_t sum = 0;
+                for (int i = 0; i < slot_count; i++)
+                {
+                    plain_vec[i] = i + 1;
+                    sum += i + 1;
+                }
+                crtbuilder.compose(plain_vec, plain);
+                Ciphertext encrypted;
+                encryptor.encrypt(plain, encrypted);
+
+                // The default keys rotate by one step at a time
+                for (auto keys : { &sum_glk, &rns_sum_glk, &glk })
+                {
+                    Ciphertext summed;
+                    evaluator.sum_slots(encrypted, *keys, summed);
+                    decryptor.decrypt(summed, plain);
+                    crtbuilder.decompose(plain, plain_vec);
+                    Assert::IsTrue(plain_vec == vector<uint64_t>(slot_count, sum % 257));
+                }
+
+                // Both rows, and in NTT form
+                Ciphertext encrypted_ntt;
+                evaluator.transform_to_ntt(encrypted, encrypted_ntt);
+                for (int slot : { 0, 5, slot_count / 2, slot_count - 1 })
+                {
+                    Ciphertext replicated;
+                    evaluator.replicate_slot(encrypted, slot, sum_glk, replicated);
+                    decryptor.decrypt(replicated, plain);
+                    crtbuilder.decompose(plain, plain_vec);
+                    Assert::IsTrue(plain_vec == vector<uint64_t>(slot_count, slot + 1));
+
+                    evaluator.replicate_slot(encrypted_ntt, slot, rns_sum_glk, replicated);
+                    Assert::IsTrue(replicated.is_ntt_form());
+                    evaluator.transform_from_ntt(replicated);
+                    decryptor.decrypt(replicated, plain);
+                    crtbuilder.decompose(plain, plain_vec);
+                    Assert::IsTrue(plain_vec == vector<uint64_t>(slot_count, slot + 1));
+                }
+            }
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "CppUnitTest.h"
+#include "seal/context.h"
+#include "seal/keygenerator.h"
+#include "seal/encryptor.h"
+#include "seal/decryptor.h"
+#include "seal/evaluator.h"
+#include "seal/evaluatorworkspace.h"
+#include "seal/polycrt.h"
+#include "seal/defaultparams.h"
+#include <algorithm>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    namespace
+    {
+        bool is_same_ciphertext(const Ciphertext &a, const Ciphertext &b)
+        {
+            return a.size() == b.size() && a.is_ntt_form() == b.is_ntt_form() && 
+                equal(a.pointer(), a.pointer() + a.uint64_count(), b.pointer());
+        }
+    }
+
+    TEST_CLASS(EvaluatorWorkspaceTest)
+    {
+    public:
+        TEST_METHOD(FVEncryptWorkspaceMatchesPool)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^8 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(24, evk);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+            EvaluatorWorkspace workspace(context);
+            size_t uint64_count = workspace.uint64_count();
+            Assert::IsTrue(uint64_count > 0);
+            Assert::IsTrue(workspace.hash_block() == parms.hash_block());
+
+            Plaintext plain;
+            vector<uint64_t> plain_vec{
+                1, 2, 3, 4,
+                5, 6, 7, 8
+            };
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            Ciphertext encrypted_ntt;
+            evaluator.transform_to_ntt(encrypted, encrypted_ntt);
+
+            for (int form = 0; form < 2; form++)
+            {
+                const Ciphertext &factor = form ? encrypted_ntt : encrypted;
+
+                Ciphertext expected(factor);
+                Ciphertext result(factor);
+                evaluator.multiply(expected, factor);
+                evaluator.multiply(result, factor, workspace);
+                Assert::IsTrue(is_same_ciphertext(expected, result));
+
+                evaluator.relinearize(expected, evk);
+                evaluator.relinearize(result, evk, workspace);
+                Assert::IsTrue(is_same_ciphertext(expected, result));
+
+                evaluator.multiply_relinearize(expected, factor, evk);
+                evaluator.multiply_relinearize(result, factor, evk, workspace);
+                Assert::IsTrue(is_same_ciphertext(expected, result));
+
+                evaluator.rotate_rows(expected, -1, glk);
+                evaluator.rotate_rows(result, -1, glk, workspace);
+                Assert::IsTrue(is_same_ciphertext(expected, result));
+
+                evaluator.rotate_columns(expected, glk);
+                evaluator.rotate_columns(result, glk, workspace);
+                Assert::IsTrue(is_same_ciphertext(expected, result));
+
+                if (form)
+                {
+                    evaluator.transform_from_ntt(result);
+                }
+                decryptor.decrypt(result, plain);
+                crtbuilder.decompose(plain, plain_vec);
+                Assert::IsTrue(plain_vec == vector<uint64_t>{
+                    255, 125, 216, 86,
+                    64, 1, 8, 27
+                });
+            }
+
+            // Operations on size 2 ciphertexts fit in the initial allocation
+            Assert::AreEqual(uint64_count, workspace.uint64_count());
+        }
+
+        TEST_METHOD(FVEncryptWorkspaceGrows)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(1 << 6);
+            parms.set_poly_modulus("1x^64 + 1");
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1), small_mods_40bit(2) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            EvaluationKeys evk;
+            keygen.generate_evaluation_keys(30, 3, evk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            EvaluatorWorkspace workspace(context);
+            size_t uint64_count = workspace.uint64_count();
+
+            Plaintext plain("1x^1 + 1");
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            evaluator.multiply(encrypted, encrypted, workspace);
+            Assert::AreEqual(uint64_count, workspace.uint64_count());
+
+            // A product of size 3 ciphertexts does not fit, and the workspace grows 
+            // when it is next used
+            Ciphertext expected(encrypted);
+            evaluator.multiply(expected, encrypted);
+            evaluator.multiply(encrypted, encrypted, workspace);
+            Assert::IsTrue(is_same_ciphertext(expected, encrypted));
+            Assert::AreEqual(5, encrypted.size());
+            Assert::AreEqual(uint64_count, workspace.uint64_count());
+
+            evaluator.relinearize(encrypted, evk, workspace);
+            size_t grown_uint64_count = workspace.uint64_count();
+            Assert::IsTrue(grown_uint64_count > uint64_count);
+
+            decryptor.decrypt(encrypted, plain);
+            Assert::IsTrue(plain.to_string() == "1x^4 + 4x^3 + 6x^2 + 4x^1 + 1");
+
+            // Repeating the same operations needs no further growth
+            encryptor.encrypt(Plaintext("1x^1 + 1"), encrypted);
+            evaluator.multiply(encrypted, encrypted, workspace);
+            evaluator.multiply(encrypted, encrypted, workspace);
+            evaluator.relinearize(encrypted, evk, workspace);
+            evaluator.multiply(encrypted, encrypted, workspace);
+            Assert::AreEqual(grown_uint64_count, workspace.uint64_count());
+        }
+    };
+}
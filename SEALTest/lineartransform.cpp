@@ -0,0 +1,118 @@
+#include "CppUnitTest.h"
+#include "seal/lineartransform.h"
+#include "seal/context.h"
+#include "seal/encryptor.h"
+#include "seal/decryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/polycrt.h"
+#include <cstdint>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    TEST_CLASS(LinearTransformTest)
+    {
+    public:
+        TEST_METHOD(FVEncryptLinearTransformDecrypt)
+        {
+            EncryptionParameters parms;
+            SmallModulus plain_modulus(257);
+            BigPoly poly_modulus("1x^32 + 1");
+            parms.set_poly_modulus(poly_modulus);
+            parms.set_plain_modulus(plain_modulus);
+            parms.set_coeff_modulus({ small_mods_40bit(0), small_mods_40bit(1) });
+            SEALContext context(parms);
+            KeyGenerator keygen(context);
+            GaloisKeys glk;
+            keygen.generate_galois_keys(24, glk);
+
+            Encryptor encryptor(context, keygen.public_key());
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            PolyCRTBuilder crtbuilder(context);
+
+            int row_size = 16;
+            Plaintext plain;
+            vector<uint64_t> plain_vec(2 * row_size);
+            for (int i = 0; i < 2 * row_size; i++)
+            {
+                plain_vec[i] = (7 * i + 3) % 257;
+            }
+            crtbuilder.compose(plain_vec, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            auto multiply = [&](const vector<vector<uint64_t> > &matrix) {
+                vector<uint64_t> product(2 * row_size, 0);
+                for (int r = 0; r < 2; r++)
+                {
+                    for (size_t i = 0; i < matrix.size(); i++)
+                    {
+                        for (size_t j = 0; j < matrix[i].size(); j++)
+                        {
+                            product[r * row_size + i] = (product[r * row_size + i] 
+                                + matrix[i][j] * plain_vec[r * row_size + j]) % 257;
+                        }
+                    }
+                }
+                return product;
+            };
+
+            // A dense matrix needs every baby step and giant step
+            vector<vector<uint64_t> > dense(row_size, vector<uint64_t>(row_size));
+            for (int i = 0; i < row_size; i++)
+            {
+                for (int j = 0; j < row_size; j++)
+                {
+                    dense[i][j] = (i * i + 3 * j + 1) % 257;
+                }
+            }
+            LinearTransform dense_transform(evaluator, dense);
+            Assert::AreEqual(4, dense_transform.baby_step_count());
+            Assert::AreEqual(4, dense_transform.giant_step_count());
+            Assert::AreEqual(6, static_cast<int>(dense_transform.galois_elts().size()));
+
+            Ciphertext product;
+            evaluator.linear_transform(encrypted, dense_transform, glk, product);
+            decryptor.decrypt(product, plain);
+            vector<uint64_t> result;
+            crtbuilder.decompose(plain, result);
+            Assert::IsTrue(result == multiply(dense));
+
+            // With keys for exactly the rotations used, and in NTT form
+            GaloisKeys transform_glk;
+            keygen.generate_galois_keys(24, dense_transform.galois_elts(), transform_glk);
+            Ciphertext encrypted_ntt;
+            evaluator.transform_to_ntt(encrypted, encrypted_ntt);
+            evaluator.linear_transform(encrypted_ntt, dense_transform, transform_glk);
+            Assert::IsTrue(encrypted_ntt.is_ntt_form());
+            evaluator.transform_from_ntt(encrypted_ntt);
+            decryptor.decrypt(encrypted_ntt, plain);
+            crtbuilder.decompose(plain, result);
+            Assert::IsTrue(result == multiply(dense));
+
+            // A smaller banded matrix is padded with zeros, and its zero diagonals skipped
+            vector<vector<uint64_t> > banded(row_size - 3, vector<uint64_t>(row_size - 3, 0));
+            for (int i = 0; i < row_size - 3; i++)
+            {
+                banded[i][i] = i + 1;
+                if (i + 1 < row_size - 3)
+                {
+                    banded[i][i + 1] = 256;
+                }
+            }
+            LinearTransform banded_transform(evaluator, banded);
+            Assert::AreEqual(1, static_cast<int>(banded_transform.galois_elts().size()));
+
+            evaluator.linear_transform(encrypted, banded_transform, glk, product);
+            decryptor.decrypt(product, plain);
+            crtbuilder.decompose(plain, result);
+            Assert::IsTrue(result == multiply(banded));
+        }
+    };
+}
@@ -0,0 +1,92 @@
+#include "CppUnitTest.h"
+#include "seal/util/galoistables.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/defaultparams.h"
+#include "seal/smallmodulus.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace SEALTest
+{
+    namespace util
+    {
+        TEST_CLASS(GaloisTablesTests)
+        {
+        public:
+            TEST_METHOD(GaloisTablesNTTIndex)
+            {
+                GaloisTables tables(3);
+                Assert::AreEqual(3, tables.coeff_count_power());
+
+                vector<uint64_t> input{ 0, 1, 2, 3, 4, 5, 6, 7 };
+                vector<uint64_t> result(8);
+                vector<uint64_t> expected(8);
+                for (uint64_t galois_elt : { 1, 3, 5, 7, 9, 11, 13, 15 })
+                {
+                    const uint32_t *ntt_index = tables.ntt_index(galois_elt);
+                    apply_galois_ntt(input.data(), 8, ntt_index, result.data());
+                    apply_galois_ntt(input.data(), 3, galois_elt, expected.data());
+                    Assert::IsTrue(result == expected);
+
+                    // The table is computed only once
+                    Assert::IsTrue(ntt_index == tables.ntt_index(galois_elt));
+                }
+                Assert::IsTrue(result == vector<uint64_t>{ 7, 6, 5, 4, 3, 2, 1, 0 });
+            }
+
+            TEST_METHOD(GaloisTablesCoeffIndex)
+            {
+                random_device rd;
+                SmallModulus modulus(small_mods_60bit(0));
+                for (int coeff_count_power : { 1, 2, 3, 6 })
+                {
+                    int coeff_count = 1 << coeff_count_power;
+                    GaloisTables tables(coeff_count_power);
+                    vector<uint64_t> input(coeff_count);
+                    for (int i = 0; i < coeff_count; i++)
+                    {
+                        // Include zeros, which stay zero when negated
+                        input[i] = (i % 3) ? ((static_cast<uint64_t>(rd()) << 32) | rd()) % modulus.value() : 0;
+                    }
+                    vector<uint64_t> result(coeff_count);
+                    vector<uint64_t> result_generic(coeff_count);
+                    vector<uint64_t> expected(coeff_count);
+                    for (uint64_t galois_elt = 1; galois_elt < 2 * static_cast<uint64_t>(coeff_count); galois_elt += 2)
+                    {
+                        const uint32_t *coeff_index = tables.coeff_index(galois_elt);
+                        apply_galois(input.data(), coeff_count_power, coeff_index, modulus, result.data());
+                        apply_galois_generic(input.data(), coeff_count_power, coeff_index, modulus, result_generic.data());
+                        apply_galois(input.data(), coeff_count_power, galois_elt, modulus, expected.data());
+                        Assert::IsTrue(result == expected);
+                        Assert::IsTrue(result_generic == expected);
+                    }
+                }
+            }
+
+            TEST_METHOD(RowRotationGaloisElt)
+            {
+                // With N = 16 the elements are powers of 3 modulo 32
+                Assert::AreEqual(static_cast<uint64_t>(1), row_rotation_galois_elt(0, 4));
+                Assert::AreEqual(static_cast<uint64_t>(3), row_rotation_galois_elt(1, 4));
+                Assert::AreEqual(static_cast<uint64_t>(9), row_rotation_galois_elt(2, 4));
+                Assert::AreEqual(static_cast<uint64_t>(17), row_rotation_galois_elt(4, 4));
+                Assert::AreEqual(static_cast<uint64_t>(11), row_rotation_galois_elt(7, 4));
+
+                // Rotating right by s is rotating left by N/2 - s, and undoes rotating left by s
+                for (int steps = 1; steps < 8; steps++)
+                {
+                    uint64_t left = row_rotation_galois_elt(steps, 4);
+                    uint64_t right = row_rotation_galois_elt(-steps, 4);
+                    Assert::AreEqual(row_rotation_galois_elt(8 - steps, 4), right);
+                    Assert::AreEqual(static_cast<uint64_t>(1), (left * right) & 31);
+                }
+            }
+        };
+    }
+}
@@ -5,6 +5,8 @@
 #include "seal/util/smallntt.h"
 #include "seal/defaultparams.h"
 #include "seal/util/numth.h"
+#include "seal/util/uintarithsmallmod.h"
+#include "seal/util/common.h"
 #include <random>
 #include <cstdint>
 
@@ -132,6 +134,171 @@ namespace SEALTest
                     Assert::AreEqual(temp[i], poly[i]);
                 }
             }
+
+            TEST_METHOD(SmallNTTMatchesGenericTest)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                SmallNTTTables tables(pool);
+                random_device rd;
+
+                vector<SmallModulus> moduli{ small_mods_30bit(0), small_mods_40bit(0), small_mods_50bit(0), small_mods_60bit(0), 0x3FFFFFFFFFFE8001ULL };
+                for (int coeff_count_power = 1; coeff_count_power <= 12; coeff_count_power++)
+                {
+                    int coeff_count = 1 << coeff_count_power;
+                    Pointer poly(allocate_poly(coeff_count, 1, pool));
+                    Pointer expected(allocate_poly(coeff_count, 1, pool));
+                    for (auto &modulus : moduli)
+                    {
+                        Assert::IsTrue(tables.generate(coeff_count_power, modulus));
+                        uint64_t two_times_modulus = 2 * modulus.value();
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            poly[i] = ((static_cast<uint64_t>(rd()) << 32) | rd()) % two_times_modulus;
+                            expected[i] = poly[i];
+                        }
+
+                        ntt_negacyclic_harvey_lazy(poly.get(), tables);
+                        ntt_negacyclic_harvey_lazy_generic(expected.get(), tables);
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            Assert::AreEqual(expected[i], poly[i]);
+                        }
+
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            poly[i] %= two_times_modulus;
+                            expected[i] = poly[i];
+                        }
+                        inverse_ntt_negacyclic_harvey_lazy(poly.get(), tables);
+                        inverse_ntt_negacyclic_harvey_lazy_generic(expected.get(), tables);
+                        for (int i = 0; i < coeff_count; i++)
+                        {
+                            Assert::AreEqual(expected[i], poly[i]);
+                        }
+                    }
+                }
+            }
+
+            TEST_METHOD(SmallNTTLargeDegreeTest)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                SmallNTTTables tables(pool);
+                random_device rd;
+
+                // Large enough that both the breadth-first and the blocked stages are used
+                int coeff_count_power = 14;
+                int coeff_count = 1 << coeff_count_power;
+                SmallModulus modulus(small_mods_60bit(0));
+                Assert::IsTrue(tables.generate(coeff_count_power, modulus));
+
+                Pointer poly(allocate_poly(coeff_count, 1, pool));
+                Pointer copy(allocate_poly(coeff_count, 1, pool));
+                for (int i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = ((static_cast<uint64_t>(rd()) << 32) | rd()) % modulus.value();
+                    copy[i] = poly[i];
+                }
+
+                // A[j] = a(psi^(2 * bit_reverse(j) + 1))
+                ntt_negacyclic_harvey(poly.get(), tables);
+                for (int j = 0; j < coeff_count; j += 127)
+                {
+                    uint64_t exponent = 2 * reverse_bits(static_cast<uint32_t>(j), coeff_count_power) + 1;
+                    uint64_t point = exponentiate_uint_mod(tables.get_root(), exponent, modulus);
+                    uint64_t value = 0;
+                    for (int i = coeff_count - 1; i >= 0; i--)
+                    {
+                        value = add_uint_uint_mod(multiply_uint_uint_mod(value, point, modulus), copy[i], modulus);
+                    }
+                    Assert::AreEqual(value, poly[j]);
+                }
+
+                inverse_ntt_negacyclic_harvey(poly.get(), tables);
+                for (int i = 0; i < coeff_count; i++)
+                {
+                    Assert::AreEqual(copy[i], poly[i]);
+                }
+            }
+
+            TEST_METHOD(SmallNTTAliasTest)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                random_device rd;
+
+                int coeff_count_power = 10;
+                int coeff_count = 1 << coeff_count_power;
+                SmallNTTTables tables(coeff_count_power, small_mods_60bit(0), pool);
+                SmallNTTTables alias(pool);
+                alias.alias(tables);
+                Assert::IsTrue(alias.is_generated());
+                Assert::AreEqual(coeff_count, alias.coeff_count());
+                Assert::AreEqual(tables.modulus().value(), alias.modulus().value());
+                Assert::AreEqual(tables.get_root(), alias.get_root());
+
+                Pointer poly(allocate_uint(coeff_count, pool));
+                Pointer expected(allocate_uint(coeff_count, pool));
+                for (int i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = static_cast<uint64_t>(rd()) % tables.modulus().value();
+                    expected[i] = poly[i];
+                }
+                ntt_negacyclic_harvey(poly.get(), alias);
+                ntt_negacyclic_harvey(expected.get(), tables);
+                for (int i = 0; i < coeff_count; i++)
+                {
+                    Assert::AreEqual(expected[i], poly[i]);
+                }
+
+                // Aliasing tables that are not generated gives tables that are not generated
+                SmallNTTTables empty(pool);
+                alias.alias(empty);
+                Assert::IsFalse(alias.is_generated());
+            }
+
+            TEST_METHOD(BatchedSmallNTTTest)
+            {
+                MemoryPoolHandle pool = MemoryPoolHandle::Global();
+                random_device rd;
+
+                int coeff_count_power = 8;
+                int coeff_count = (1 << coeff_count_power) + 1;
+                int coeff_mod_count = 3;
+                int poly_count = 2;
+                vector<SmallNTTTables> tables;
+                for (int j = 0; j < coeff_mod_count; j++)
+                {
+                    tables.emplace_back(coeff_count_power, small_mods_50bit(j), pool);
+                }
+
+                int uint64_count = poly_count * coeff_mod_count * coeff_count;
+                Pointer batched(allocate_uint(uint64_count, pool));
+                Pointer expected(allocate_uint(uint64_count, pool));
+                for (int i = 0; i < uint64_count; i++)
+                {
+                    batched[i] = static_cast<uint64_t>(rd()) % small_mods_50bit(0).value();
+                    expected[i] = batched[i];
+                }
+
+                ntt_negacyclic_harvey(batched.get(), coeff_count, coeff_mod_count, tables.data(), poly_count);
+                for (int i = 0; i < poly_count * coeff_mod_count; i++)
+                {
+                    ntt_negacyclic_harvey(expected.get() + i * coeff_count, tables[i % coeff_mod_count]);
+                }
+                for (int i = 0; i < uint64_count; i++)
+                {
+                    Assert::AreEqual(expected[i], batched[i]);
+                }
+
+                inverse_ntt_negacyclic_harvey_lazy(batched.get(), coeff_count, coeff_mod_count, tables.data(), poly_count);
+                for (int i = 0; i < poly_count * coeff_mod_count; i++)
+                {
+                    inverse_ntt_negacyclic_harvey_lazy(expected.get() + i * coeff_count, tables[i % coeff_mod_count]);
+                }
+                for (int i = 0; i < uint64_count; i++)
+                {
+                    Assert::AreEqual(expected[i], batched[i]);
+                }
+            }
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "CppUnitTest.h"
+#include "seal/util/threadpool.h"
+#include <atomic>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace seal::util;
+using namespace std;
+
+namespace SEALTest
+{
+    namespace util
+    {
+        TEST_CLASS(ThreadPoolTests)
+        {
+        public:
+            TEST_METHOD(ThreadPoolParallelFor)
+            {
+                ThreadPool pool(4);
+                Assert::AreEqual(4, pool.thread_count());
+
+                vector<int> values(100, 0);
+                pool.parallel_for(static_cast<int>(values.size()), [&](int i) { values[i] += i; });
+                for (int i = 0; i < static_cast<int>(values.size()); i++)
+                {
+                    Assert::AreEqual(i, values[i]);
+                }
+
+                // The pool can be reused
+                pool.parallel_for(static_cast<int>(values.size()), [&](int i) { values[i] += i; });
+                for (int i = 0; i < static_cast<int>(values.size()); i++)
+                {
+                    Assert::AreEqual(2 * i, values[i]);
+                }
+
+                pool.parallel_for(0, [&](int i) { values[i] = -1; });
+                Assert::AreEqual(0, values[0]);
+
+                ThreadPool single(1);
+                Assert::AreEqual(1, single.thread_count());
+                single.parallel_for(3, [&](int i) { values[i] = 7; });
+                Assert::AreEqual(7, values[2]);
+            }
+
+            TEST_METHOD(ThreadPoolNestedParallelFor)
+            {
+                ThreadPool pool(3);
+                atomic<int> count(0);
+                pool.parallel_for(5, [&](int)
+                {
+                    // Runs in the calling thread since the pool is busy
+                    pool.parallel_for(4, [&](int) { count++; });
+                });
+                Assert::AreEqual(20, count.load());
+            }
+        };
+    }
+}